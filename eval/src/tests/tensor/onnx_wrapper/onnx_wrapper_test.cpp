@@ -234,6 +234,18 @@ TEST(OnnxTest, dynamic_onnx_model_can_be_evaluated)
     //-------------------------------------------------------------------------
 }
 
+TEST(OnnxTest, models_without_shared_batch_dimension_cannot_be_batched)
+{
+    Onnx model(dynamic_model, Onnx::Optimize::DISABLE);
+    Onnx::WirePlanner planner;
+    EXPECT_TRUE(planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[4])"), model.inputs()[0]));
+    EXPECT_TRUE(planner.bind_input_type(ValueType::from_spec("tensor<float>(a[4],b[1])"), model.inputs()[1]));
+    EXPECT_TRUE(planner.bind_input_type(ValueType::from_spec("tensor<float>(a[1],b[2])"), model.inputs()[2]));
+    Onnx::WireInfo wire_info = planner.get_wire_info(model);
+    // 'attribute_tensor' has no 'batch' dimension
+    EXPECT_FALSE(Onnx::WirePlanner::make_batched_wire_info(model, wire_info, 4));
+}
+
 TEST(OnnxTest, int_types_onnx_model_can_be_evaluated)
 {
     Onnx model(int_types_model, Onnx::Optimize::ENABLE);
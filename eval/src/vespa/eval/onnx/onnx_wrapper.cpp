@@ -492,6 +492,45 @@ Onnx::WirePlanner::get_wire_info(const Onnx &model) const
     return info;
 }
 
+std::unique_ptr<Onnx::WireInfo>
+Onnx::WirePlanner::make_batched_wire_info(const Onnx &model, const WireInfo &wire_info, size_t batch_size)
+{
+    const auto &inputs = model.inputs();
+    if (inputs.empty() || inputs[0].dimensions.empty() || !inputs[0].dimensions[0].is_symbolic()) {
+        return {};
+    }
+    const std::string &batch_dim = inputs[0].dimensions[0].name;
+    auto has_batch_dim = [&batch_dim](const TensorInfo &info, const ValueType &type) {
+        return (!info.dimensions.empty() && (info.dimensions[0].name == batch_dim) &&
+                !type.dimensions().empty() && (type.dimensions()[0].size == 1));
+    };
+    WirePlanner planner;
+    for (size_t i = 0; i < inputs.size(); ++i) {
+        const auto &type = wire_info.vespa_inputs[i];
+        if (!has_batch_dim(inputs[i], type)) {
+            return {};
+        }
+        auto dimensions = type.dimensions();
+        dimensions[0].size = batch_size;
+        if (!planner.bind_input_type(ValueType::make_type(type.cell_type(), std::move(dimensions)), inputs[i])) {
+            return {};
+        }
+    }
+    for (size_t i = 0; i < model.outputs().size(); ++i) {
+        if (!has_batch_dim(model.outputs()[i], wire_info.vespa_outputs[i])) {
+            return {};
+        }
+    }
+    planner.prepare_output_types(model);
+    auto result = std::make_unique<WireInfo>(planner.get_wire_info(model));
+    for (const auto &type: result->vespa_outputs) {
+        if (type.is_error() || (type.dimensions()[0].size != batch_size)) {
+            return {};
+        }
+    }
+    return result;
+}
+
 //-----------------------------------------------------------------------------
 
 template <typename T>
@@ -6,6 +6,7 @@
 #include <vespa/eval/eval/value_type.h>
 #include <vespa/eval/eval/value.h>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -97,6 +98,11 @@ public:
         void prepare_output_types(const Onnx &model);
         ValueType make_output_type(const TensorInfo &onnx_out) const;
         WireInfo get_wire_info(const Onnx &model) const;
+        // plan for evaluating 'batch_size' inputs at once by stacking them along
+        // the outermost dimension; only possible when this dimension is the same
+        // symbolic dimension for all model inputs and outputs and it is bound to
+        // size 1 in 'wire_info'. Returns nullptr if the model cannot be batched.
+        static std::unique_ptr<WireInfo> make_batched_wire_info(const Onnx &model, const WireInfo &wire_info, size_t batch_size);
     };
 
     // evaluation context; use one per thread and keep model/wire_info alive
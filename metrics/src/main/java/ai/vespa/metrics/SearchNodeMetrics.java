@@ -245,6 +245,14 @@ public enum SearchNodeMetrics implements VespaMetrics {
     // matching
     CONTENT_PROTON_DOCUMENTDB_MATCHING_QUERIES("content.proton.documentdb.matching.queries", Unit.QUERY, "Number of queries executed"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_SOFT_DOOMED_QUERIES("content.proton.documentdb.matching.soft_doomed_queries", Unit.QUERY, "Number of queries hitting the soft timeout"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RESULT_CACHE_HITS("content.proton.documentdb.matching.result_cache_hits", Unit.QUERY, "Number of queries answered from the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RESULT_CACHE_MISSES("content.proton.documentdb.matching.result_cache_misses", Unit.QUERY, "Number of cacheable queries not found in the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RESULT_CACHE_ENTRIES("content.proton.documentdb.matching.result_cache_entries", Unit.ITEM, "Number of replies in the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RESULT_CACHE_MEMORY_USAGE("content.proton.documentdb.matching.result_cache_memory_usage", Unit.BYTE, "Memory usage (in bytes) of the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_GLOBAL_FILTER_CACHE_HITS("content.proton.documentdb.matching.global_filter_cache_hits", Unit.OPERATION, "Number of global filters taken from the global filter cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_GLOBAL_FILTER_CACHE_MISSES("content.proton.documentdb.matching.global_filter_cache_misses", Unit.OPERATION, "Number of global filters calculated because they were not in the global filter cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_GLOBAL_FILTER_CACHE_ENTRIES("content.proton.documentdb.matching.global_filter_cache_entries", Unit.ITEM, "Number of global filters in the global filter cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_GLOBAL_FILTER_CACHE_MEMORY_USAGE("content.proton.documentdb.matching.global_filter_cache_memory_usage", Unit.BYTE, "Memory usage (in bytes) of the global filter cache"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_QUERY_LATENCY("content.proton.documentdb.matching.query_latency", Unit.SECOND, "Total average latency (sec) when matching and ranking a query"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_QUERY_SETUP_TIME("content.proton.documentdb.matching.query_setup_time", Unit.SECOND, "Average time (sec) spent setting up and tearing down queries"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_DOCS_MATCHED("content.proton.documentdb.matching.docs_matched", Unit.DOCUMENT, "Number of documents matched"),
@@ -252,6 +260,14 @@ public enum SearchNodeMetrics implements VespaMetrics {
     CONTENT_PROTON_DOCUMENTDB_MATCHING_DOCS_RERANKED("content.proton.documentdb.matching.docs_reranked", Unit.DOCUMENT, "Number of documents re-ranked (second phase)"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_QUERIES("content.proton.documentdb.matching.rank_profile.queries", Unit.QUERY, "Number of queries executed"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_SOFT_DOOMED_QUERIES("content.proton.documentdb.matching.rank_profile.soft_doomed_queries", Unit.QUERY, "Number of queries hitting the soft timeout"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_RESULT_CACHE_HITS("content.proton.documentdb.matching.rank_profile.result_cache_hits", Unit.QUERY, "Number of queries answered from the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_RESULT_CACHE_MISSES("content.proton.documentdb.matching.rank_profile.result_cache_misses", Unit.QUERY, "Number of cacheable queries not found in the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_RESULT_CACHE_ENTRIES("content.proton.documentdb.matching.rank_profile.result_cache_entries", Unit.ITEM, "Number of replies in the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_RESULT_CACHE_MEMORY_USAGE("content.proton.documentdb.matching.rank_profile.result_cache_memory_usage", Unit.BYTE, "Memory usage (in bytes) of the result cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_GLOBAL_FILTER_CACHE_HITS("content.proton.documentdb.matching.rank_profile.global_filter_cache_hits", Unit.OPERATION, "Number of global filters taken from the global filter cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_GLOBAL_FILTER_CACHE_MISSES("content.proton.documentdb.matching.rank_profile.global_filter_cache_misses", Unit.OPERATION, "Number of global filters calculated because they were not in the global filter cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_GLOBAL_FILTER_CACHE_ENTRIES("content.proton.documentdb.matching.rank_profile.global_filter_cache_entries", Unit.ITEM, "Number of global filters in the global filter cache"),
+    CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_GLOBAL_FILTER_CACHE_MEMORY_USAGE("content.proton.documentdb.matching.rank_profile.global_filter_cache_memory_usage", Unit.BYTE, "Memory usage (in bytes) of the global filter cache"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_SOFT_DOOM_FACTOR("content.proton.documentdb.matching.rank_profile.soft_doom_factor", Unit.FRACTION, "Factor used to compute soft-timeout"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_QUERY_LATENCY("content.proton.documentdb.matching.rank_profile.query_latency", Unit.SECOND, "Total average latency (sec) when matching and ranking a query"),
     CONTENT_PROTON_DOCUMENTDB_MATCHING_RANK_PROFILE_QUERY_SETUP_TIME("content.proton.documentdb.matching.rank_profile.query_setup_time", Unit.SECOND, "Average time (sec) spent setting up and tearing down queries"),
@@ -271,6 +287,16 @@ public enum SearchNodeMetrics implements VespaMetrics {
     // feeding
     CONTENT_PROTON_DOCUMENTDB_FEEDING_COMMIT_OPERATIONS("content.proton.documentdb.feeding.commit.operations", Unit.OPERATION, "Number of operations included in a commit"),
     CONTENT_PROTON_DOCUMENTDB_FEEDING_COMMIT_LATENCY("content.proton.documentdb.feeding.commit.latency", Unit.SECOND, "Latency for commit in seconds"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_OPERATION_WAIT_LATENCY("content.proton.documentdb.feeding.operation.wait_latency", Unit.SECOND, "Latency for feed operations waiting to be handled in the master thread"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_OPERATION_MASTER_LATENCY("content.proton.documentdb.feeding.operation.master_latency", Unit.SECOND, "Latency for handling feed operations in the master thread"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_OPERATION_COMPLETION_LATENCY("content.proton.documentdb.feeding.operation.completion_latency", Unit.SECOND, "Latency from feed operations are handled in the master thread until transaction log commit and writes to attributes, memory index and document store are done"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_OPERATION_ATTRIBUTES_LATENCY("content.proton.documentdb.feeding.operation.attributes_latency", Unit.SECOND, "Latency from feed operations are handled in the master thread until writes to attributes are done"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_OPERATION_MEMORY_INDEX_LATENCY("content.proton.documentdb.feeding.operation.memory_index_latency", Unit.SECOND, "Latency from feed operations are handled in the master thread until writes to memory index are done"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_OPERATION_DOCUMENT_STORE_LATENCY("content.proton.documentdb.feeding.operation.document_store_latency", Unit.SECOND, "Latency from feed operations are handled in the master thread until writes to document store are done"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_OPERATION_LATENCY("content.proton.documentdb.feeding.operation.latency", Unit.SECOND, "Latency for feed operations from being received until being acked"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_MASTER_TASK_LIMIT_LIMIT("content.proton.documentdb.feeding.master_task_limit.limit", Unit.TASK, "Maximum number of pending master tasks before feed operations are blocked (0 means no limit)"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_MASTER_TASK_LIMIT_INCREASES("content.proton.documentdb.feeding.master_task_limit.increases", Unit.OPERATION, "Number of times the adaptive master task limit has been increased"),
+    CONTENT_PROTON_DOCUMENTDB_FEEDING_MASTER_TASK_LIMIT_DECREASES("content.proton.documentdb.feeding.master_task_limit.decreases", Unit.OPERATION, "Number of times the adaptive master task limit has been decreased"),
 
 
     // Metrics emitters not used in any metrics sets
@@ -202,7 +202,11 @@ struct MyFeedView : public test::DummyFeedView {
         }
     }
     void handlePut(FeedToken token, const PutOperation &putOp) override {
-        (void) token;
+        if (token && token->tracks_write_stages()) {
+            // Document type has no indexed fields
+            token->write_done(feedtoken::WriteStage::ATTRIBUTES);
+            token->write_done(feedtoken::WriteStage::DOCUMENT_STORE);
+        }
         LOG(info, "MyFeedView::handlePut(): docId(%s), putCount(%u), putLatchCount(%u)",
             putOp.getDocument()->getId().toString().c_str(), put_count,
             (putLatch ? putLatch->getCount() : 0u));
@@ -760,6 +764,37 @@ TEST_F(FeedHandlerTest, require_that_feed_stats_are_updated)
     EXPECT_LT(0.0, stats.get_total_latency());
 }
 
+TEST_F(FeedHandlerTest, require_that_feed_operation_latencies_are_tracked)
+{
+    FeedHandlerFixture f;
+    f.handler.changeToNormalFeedState();
+    DocumentContext doc_context("id:ns:searchdocument::foo", f.schema.builder);
+    auto op = std::make_unique<PutOperation>(doc_context.bucketId, Timestamp(10), std::move(doc_context.doc));
+    FeedTokenContext token_context;
+    f.handler.handleOperation(std::move(token_context.token), std::move(op));
+    EXPECT_TRUE(token_context.await());
+    EXPECT_EQ(1, f.feedView.put_count);
+    auto stats = f.handler.get_stats(false);
+    EXPECT_EQ(1u, stats.get_operation_wait_latency().get_count());
+    EXPECT_EQ(1u, stats.get_operation_master_latency().get_count());
+    EXPECT_EQ(1u, stats.get_operation_completion_latency().get_count());
+    EXPECT_EQ(1u, stats.get_operation_processing_latency().get_count());
+    EXPECT_EQ(1u, stats.get_operation_latency().get_count());
+    EXPECT_EQ(1u, stats.get_operation_attributes_latency().get_count());
+    EXPECT_EQ(0u, stats.get_operation_memory_index_latency().get_count());
+    EXPECT_EQ(1u, stats.get_operation_document_store_latency().get_count());
+    EXPECT_LE(stats.get_operation_master_latency().get_total(), stats.get_operation_processing_latency().get_total());
+    EXPECT_LE(stats.get_operation_processing_latency().get_total(), stats.get_operation_latency().get_total());
+    EXPECT_LE(stats.get_operation_attributes_latency().get_total(), stats.get_operation_completion_latency().get_total());
+    EXPECT_LE(stats.get_operation_document_store_latency().get_total(), stats.get_operation_completion_latency().get_total());
+    EXPECT_TRUE(stats.get_operation_latency().get_max().has_value());
+    stats = f.handler.get_stats(true);
+    EXPECT_TRUE(stats.get_operation_latency().get_max().has_value());
+    stats = f.handler.get_stats(false);
+    EXPECT_EQ(1u, stats.get_operation_latency().get_count());
+    EXPECT_FALSE(stats.get_operation_latency().get_max().has_value());
+}
+
 using namespace document;
 
 TEST_F(FeedHandlerTest, require_that_update_with_a_fieldpath_update_will_be_rejected)
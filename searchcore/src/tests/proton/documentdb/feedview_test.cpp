@@ -32,6 +32,7 @@
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/destructor_callbacks.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <atomic>
 #include <tuple>
 
 #include <vespa/log/log.h>
@@ -279,11 +280,13 @@ struct MySummaryAdapter : public test::MockSummaryAdapter
     ISummaryManager::SP _sumMgr;
     MyDocumentStore    &_store;
     MyLidVector         _removes;
+    std::atomic<uint32_t> _getCount;
 
     MySummaryAdapter(const document::DocumentTypeRepo & repo) noexcept
         : _sumMgr(std::make_shared<MySummaryManager>(repo)),
           _store(static_cast<MyDocumentStore &>(_sumMgr->getBackingStore())),
-          _removes()
+          _removes(),
+          _getCount(0)
     {}
     ~MySummaryAdapter() override;
     void put(SerialNum serialNum, DocumentIdT lid, const Document &doc) override {
@@ -301,6 +304,7 @@ struct MySummaryAdapter : public test::MockSummaryAdapter
         return _store;
     }
     std::unique_ptr<Document> get(const DocumentIdT lid, const DocumentTypeRepo &repo) override {
+        ++_getCount;
         return _store.read(lid, repo);
     }
     void compactLidSpace(uint32_t wantedDocIdLimit) override {
@@ -1096,6 +1100,7 @@ void requireThatUpdateOnlyUpdatesAttributeAndNotDocumentStore(Fixture &f,
     putDocumentAndUpdate(f, fieldName);
 
     EXPECT_EQ(1u, f.msa._store._lastSyncToken); // document store not updated
+    EXPECT_EQ(0u, f.msa._getCount); // document store not read
     assertAttributeUpdate(2u, DocumentId("id:ns:searchdocument::1"), 1, f.maw);
 }
 
@@ -1106,6 +1111,7 @@ void requireThatUpdateUpdatesAttributeAndDocumentStore(Fixture &f,
     putDocumentAndUpdate(f, fieldName);
 
     EXPECT_EQ(2u, f.msa._store._lastSyncToken); // document store updated
+    EXPECT_EQ(1u, f.msa._getCount); // document store read to apply update
     assertAttributeUpdate(2u, DocumentId("id:ns:searchdocument::1"), 1, f.maw);
 }
 
@@ -56,6 +56,21 @@ TEST_F(JobTest, job_returns_false_when_multiple_move_operations_or_compaction_ar
     assertJobContext(4, 7, 3, 7, 1);
 }
 
+TEST_F(JobTest, job_can_move_multiple_documents_per_run)
+{
+    init(ALLOWED_LID_BLOAT, ALLOWED_LID_BLOAT_FACTOR, RESOURCE_LIMIT_FACTOR, JOB_DELAY, false, MAX_OUTSTANDING_MOVE_OPS, 3);
+    setupThreeDocumentsToCompact();
+    EXPECT_FALSE(run());
+    sync();
+    EXPECT_EQ(3u, _handler->_handleMoveCnt);
+    EXPECT_EQ(3u, _storer._moveCnt);
+    EXPECT_EQ(4u, _handler->_moveToLid); // moves complete in any order, targeting lids 2, 3 and 4
+    endScan().compact();
+    sync();
+    EXPECT_EQ(7u, _handler->_wantedLidLimit);
+    EXPECT_EQ(1u, _storer._compactCnt);
+}
+
 TEST_F(JobTest, job_document_is_not_moved_if_meta_has_changed)
 {
     setupThreeDocumentsToCompact();
@@ -47,11 +47,12 @@ JobTestBase::init(uint32_t allowedLidBloat,
           double resourceLimitFactor,
           vespalib::duration interval,
           bool node_retired_or_maintenance,
-          uint32_t maxOutstandingMoveOps)
+          uint32_t maxOutstandingMoveOps,
+          uint32_t maxDocsToMovePerRun)
 {
     _handler = std::make_shared<MyHandler>(maxOutstandingMoveOps != MAX_OUTSTANDING_MOVE_OPS, true);
     DocumentDBLidSpaceCompactionConfig compactCfg(interval, allowedLidBloat, allowedLidBloatFactor,
-                                                  REMOVE_BATCH_BLOCK_RATE, REMOVE_BLOCK_RATE, false);
+                                                  REMOVE_BATCH_BLOCK_RATE, REMOVE_BLOCK_RATE, maxDocsToMovePerRun, false);
     BlockableMaintenanceJobConfig blockableCfg(resourceLimitFactor, maxOutstandingMoveOps);
 
     _job.reset();
@@ -183,9 +184,11 @@ JobTest::init(uint32_t allowedLidBloat,
               double resourceLimitFactor,
               vespalib::duration interval,
               bool node_retired_or_maintenance,
-              uint32_t maxOutstandingMoveOps)
+              uint32_t maxOutstandingMoveOps,
+              uint32_t maxDocsToMovePerRun)
 {
-    JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, resourceLimitFactor, interval, node_retired_or_maintenance, maxOutstandingMoveOps);
+    JobTestBase::init(allowedLidBloat, allowedLidBloatFactor, resourceLimitFactor, interval, node_retired_or_maintenance,
+                      maxOutstandingMoveOps, maxDocsToMovePerRun);
     _jobRunner = std::make_unique<MyDirectJobRunner>(*_job);
 }
 
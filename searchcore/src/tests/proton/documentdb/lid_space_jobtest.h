@@ -26,7 +26,8 @@ struct JobTestBase : public ::testing::Test {
               double resourceLimitFactor,
               vespalib::duration interval,
               bool nodeRetired,
-              uint32_t maxOutstandingMoveOps);
+              uint32_t maxOutstandingMoveOps,
+              uint32_t maxDocsToMovePerRun = 1);
     JobTestBase &addStats(uint32_t docIdLimit,
                           const LidVector &usedLids,
                           const LidPairVector &usedFreePairs);
@@ -63,7 +64,8 @@ struct JobTest : public JobTestBase {
               double resourceLimitFactor = RESOURCE_LIMIT_FACTOR,
               vespalib::duration interval = JOB_DELAY,
               bool nodeRetired = false,
-              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS);
+              uint32_t maxOutstandingMoveOps = MAX_OUTSTANDING_MOVE_OPS,
+              uint32_t maxDocsToMovePerRun = 1);
     void init_with_interval(vespalib::duration interval);
     void init_with_node_retired(bool retired);
 };
@@ -922,6 +922,22 @@ TEST(DocumentMetaStoreTest, removed_lids_are_cleared_as_active)
     EXPECT_EQ(2u, f.dms.getNumActiveLids());
 }
 
+TEST(DocumentMetaStoreTest, generation_is_bumped_when_bucket_state_changes)
+{
+    UserDocFixture f;
+    f.dms.constructFreeList();
+    f.addGlobalIds();
+    auto generation = f.dms.getCurrentGeneration();
+    f.dms.setBucketState(f.bid1, true);
+    EXPECT_LT(generation, f.dms.getCurrentGeneration());
+    generation = f.dms.getCurrentGeneration();
+    f.dms.setBucketState(f.bid1, false);
+    EXPECT_LT(generation, f.dms.getCurrentGeneration());
+    generation = f.dms.getCurrentGeneration();
+    f.dms.populateActiveBuckets({f.bid2});
+    EXPECT_LT(generation, f.dms.getCurrentGeneration());
+}
+
 TEST(DocumentMetaStoreTest, whitelist_blueprint_is_created)
 {
     UserDocFixture f;
@@ -12,6 +12,7 @@
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/searchlib/common/flush_token.h>
 #include <vespa/searchlib/common/serialnum.h>
+#include <vespa/searchlib/diskindex/fusion_progress.h>
 #include <vespa/searchlib/index/dummyfileheadercontext.h>
 #include <vespa/searchlib/test/doc_builder.h>
 #include <vespa/searchlib/test/schema_builder.h>
@@ -49,6 +50,7 @@ using search::SerialNum;
 using search::TuneFileAttributes;
 using search::TuneFileIndexManager;
 using search::TuneFileIndexing;
+using search::diskindex::FusionProgress;
 using vespalib::datastore::EntryRef;
 using search::index::DummyFileHeaderContext;
 using search::index::FieldLengthInfo;
@@ -558,7 +560,15 @@ TEST_F(IndexManagerTest, require_that_fusion_updates_indexes)
 
     FusionSpec fusion_spec;
     fusion_spec.flush_ids.assign(ids, ids + 4);
+    EXPECT_FALSE(_index_manager->get_fusion_progress());
     _index_manager->getMaintainer().runFusion(fusion_spec, std::make_shared<search::FlushToken>());
+    auto progress = _index_manager->get_fusion_progress();
+    ASSERT_TRUE(progress);
+    auto progress_fields = progress->get_fields();
+    ASSERT_EQ(1u, progress_fields.size());
+    EXPECT_EQ(field_name, progress_fields[0].name);
+    EXPECT_EQ(FusionProgress::State::DONE, progress_fields[0].state);
+    EXPECT_LT(0u, progress_fields[0].merged_words);
 
     set<uint32_t> fusion_ids = readDiskIds(index_dir, "fusion");
     EXPECT_EQ(1u, fusion_ids.size());
@@ -611,6 +621,51 @@ TEST_F(IndexManagerTest, require_that_fusion_target_is_setUp)
     EXPECT_TRUE(target->needUrgentFlush());
 }
 
+TEST_F(IndexManagerTest, require_that_fused_index_is_counted_against_maxflushed)
+{
+    for (uint32_t i = 0; i < 3; ++i) {
+        addDocument(docid + i);
+        flushIndexManager();
+    }
+    run_fusion();
+    EXPECT_EQ(1u, readDiskIds(index_dir, "fusion").size());
+    _index_manager->setMaxFlushed(2);
+    addDocument(docid + 10);
+    flushIndexManager();
+    EXPECT_FALSE(has_urgent_fusion());
+    addDocument(docid + 11);
+    flushIndexManager();
+    EXPECT_TRUE(has_urgent_fusion());
+}
+
+TEST_F(IndexManagerTest, require_that_fusion_of_small_flushed_indexes_can_be_deferred)
+{
+    for (uint32_t i = 0; i < 5; ++i) {
+        addDocument(docid + i);
+        flushIndexManager();
+    }
+    run_fusion();
+    EXPECT_EQ(1u, readDiskIds(index_dir, "fusion").size());
+    _index_manager->setMaxFlushed(1);
+    for (uint32_t i = 0; i < 2; ++i) {
+        addDocument(docid + 10 + i);
+        flushIndexManager();
+    }
+    EXPECT_TRUE(has_urgent_fusion());
+    _index_manager->setFusionSizeRatio(10.0, 3);
+    EXPECT_FALSE(has_urgent_fusion());
+    _index_manager->setFusionSizeRatio(0.01, 3);
+    EXPECT_TRUE(has_urgent_fusion());
+    _index_manager->setFusionSizeRatio(10.0, 3);
+    addDocument(docid + 20);
+    flushIndexManager();
+    // Exactly maxflusheddeferred flushed indexes
+    EXPECT_FALSE(has_urgent_fusion());
+    addDocument(docid + 21);
+    flushIndexManager();
+    EXPECT_TRUE(has_urgent_fusion());
+}
+
 TEST_F(IndexManagerTest, require_that_fusion_cleans_up_old_indexes)
 {
     addDocument(docid);
@@ -0,0 +1,138 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/global_filter_cache.h>
+#include <vespa/searchlib/queryeval/create_blueprint_params.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <atomic>
+#include <latch>
+#include <stdexcept>
+#include <thread>
+
+using proton::matching::GlobalFilterCache;
+using search::queryeval::CreateBlueprintParams;
+using search::queryeval::GlobalFilter;
+
+namespace {
+
+std::shared_ptr<const GlobalFilter> make_filter(uint32_t docid_limit) {
+    return GlobalFilter::create(std::vector<uint32_t>({1, 3}), docid_limit);
+}
+
+std::string make_key(const std::string &stack, uint64_t generation = 1) {
+    return GlobalFilterCache::make_key(stack, "", CreateBlueprintParams(), false, generation, 1, 100);
+}
+
+}
+
+struct GlobalFilterCacheTest : ::testing::Test {
+    std::atomic<vespalib::steady_time> now;
+    GlobalFilterCacheTest() : now(vespalib::steady_time()) {}
+    void tick(vespalib::duration d) { now.store(now.load() + d); }
+};
+
+TEST_F(GlobalFilterCacheTest, cached_filter_is_returned_for_same_key)
+{
+    GlobalFilterCache cache(1_Mi, 1s, now);
+    auto filter = make_filter(100);
+    EXPECT_FALSE(cache.lookup(make_key("foo")));
+    cache.insert(make_key("foo"), filter);
+    EXPECT_EQ(filter.get(), cache.lookup(make_key("foo")).get());
+    EXPECT_FALSE(cache.lookup(make_key("bar")));
+    EXPECT_FALSE(cache.lookup(make_key("foo", 2)));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(3u, stats.misses);
+    EXPECT_EQ(1u, stats.entries);
+    EXPECT_LT(0u, stats.memory_usage);
+}
+
+TEST_F(GlobalFilterCacheTest, entries_expire_after_max_age)
+{
+    GlobalFilterCache cache(1_Mi, 1s, now);
+    cache.insert(make_key("foo"), make_filter(100));
+    tick(500ms);
+    EXPECT_TRUE(cache.lookup(make_key("foo")));
+    tick(600ms);
+    EXPECT_FALSE(cache.lookup(make_key("foo")));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(0u, stats.entries);
+    EXPECT_EQ(0u, stats.memory_usage);
+}
+
+TEST_F(GlobalFilterCacheTest, least_recently_used_entries_are_evicted_when_memory_limit_is_reached)
+{
+    GlobalFilterCache cache(3_Ki, 1s, now);
+    cache.insert(make_key("a"), make_filter(10000));
+    cache.insert(make_key("b"), make_filter(10000));
+    EXPECT_TRUE(cache.lookup(make_key("a")));
+    cache.insert(make_key("c"), make_filter(10000));
+    EXPECT_TRUE(cache.lookup(make_key("a")));
+    EXPECT_FALSE(cache.lookup(make_key("b")));
+    EXPECT_TRUE(cache.lookup(make_key("c")));
+    EXPECT_GE(3_Ki, cache.get_stats().memory_usage);
+}
+
+TEST_F(GlobalFilterCacheTest, filters_larger_than_memory_limit_are_not_cached)
+{
+    GlobalFilterCache cache(1_Ki, 1s, now);
+    cache.insert(make_key("a"), make_filter(100000));
+    EXPECT_FALSE(cache.lookup(make_key("a")));
+    EXPECT_EQ(0u, cache.get_stats().entries);
+}
+
+TEST_F(GlobalFilterCacheTest, concurrent_misses_on_same_key_calculate_filter_once)
+{
+    GlobalFilterCache cache(1_Mi, 1s, now);
+    auto filter = make_filter(100);
+    std::atomic<int> created(0);
+    std::latch calculating(1);
+    std::latch release(1);
+    std::shared_ptr<const GlobalFilter> first_result;
+    bool first_cached = true;
+    std::thread first([&]() {
+        first_result = cache.lookup_or_create(make_key("foo"), [&]() {
+            ++created;
+            calculating.count_down();
+            release.wait();
+            return filter;
+        }, first_cached);
+    });
+    calculating.wait();
+    std::shared_ptr<const GlobalFilter> second_result;
+    bool second_cached = false;
+    std::thread second([&]() {
+        second_result = cache.lookup_or_create(make_key("foo"), [&]() {
+            ++created;
+            return make_filter(100);
+        }, second_cached);
+    });
+    std::this_thread::sleep_for(10ms);
+    release.count_down();
+    first.join();
+    second.join();
+    EXPECT_EQ(1, created.load());
+    EXPECT_FALSE(first_cached);
+    EXPECT_TRUE(second_cached);
+    EXPECT_EQ(filter.get(), first_result.get());
+    EXPECT_EQ(filter.get(), second_result.get());
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+}
+
+TEST_F(GlobalFilterCacheTest, failed_calculation_is_not_left_pending)
+{
+    GlobalFilterCache cache(1_Mi, 1s, now);
+    bool cached = true;
+    EXPECT_THROW(cache.lookup_or_create(make_key("foo"), []() -> std::shared_ptr<const GlobalFilter> {
+        throw std::runtime_error("failed");
+    }, cached), std::runtime_error);
+    auto filter = make_filter(100);
+    EXPECT_EQ(filter.get(), cache.lookup_or_create(make_key("foo"), [&]() { return filter; }, cached).get());
+    EXPECT_FALSE(cached);
+    EXPECT_EQ(filter.get(), cache.lookup(make_key("foo")).get());
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
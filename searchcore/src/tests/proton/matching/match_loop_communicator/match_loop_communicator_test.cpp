@@ -55,6 +55,9 @@ std::tuple<size_t,Hits,RangePair> second_phase(MatchLoopCommunicator &com, const
         refs.push_back(i);
     }
     auto my_work = com.get_second_phase_work(SortedHitSequence(hits.data(), refs.data(), refs.size()), thread_id);
+    for (auto more = com.get_more_second_phase_work(); !more.empty(); more = com.get_more_second_phase_work()) {
+        my_work.insert(my_work.end(), more.begin(), more.end());
+    }
     // the DocumentScorer used by the match thread will sort on docid here to ensure increasing seek order, this is not needed here
     size_t work_size = my_work.size();
     for (auto &[hit, tag]: my_work) {
@@ -255,11 +258,12 @@ TEST(MatchLoopCommunicatorTest, require_that_estimate_match_frequency_will_count
     Nexus::run(num_threads, task);
 }
 
-TEST(MatchLoopCommunicatorTest, require_that_second_phase_work_is_evenly_distributed_among_search_threads)
+TEST(MatchLoopCommunicatorTest, require_that_all_second_phase_work_is_done_once_by_search_threads)
 {
     constexpr size_t num_threads = 5;
     MatchLoopCommunicator f1(num_threads, 20);
-    auto task = [&f1](Nexus& ctx) {
+    std::atomic<size_t> total_work(0);
+    auto task = [&f1,&total_work](Nexus& ctx) {
                     auto thread_id = ctx.thread_id();
                     size_t num_hits = thread_id * 5;
                     size_t docid = thread_id * 100;
@@ -270,7 +274,7 @@ TEST(MatchLoopCommunicatorTest, require_that_second_phase_work_is_evenly_distrib
                         score -= 1.0;
                     }
                     auto [my_work, best_hits, ranges] = second_phase(f1, my_hits, thread_id, 1000.0);
-                    EXPECT_EQ(my_work, 4u);
+                    total_work.fetch_add(my_work);
                     EXPECT_EQ(RangePair({381,400},{1381,1400}), ranges);
                     if (thread_id == 4) {
                         for (auto &hit: my_hits) {
@@ -282,6 +286,39 @@ TEST(MatchLoopCommunicatorTest, require_that_second_phase_work_is_evenly_distrib
                     }
                 };
     Nexus::run(num_threads, task);
+    EXPECT_EQ(20u, total_work.load());
+}
+
+TEST(MatchLoopCommunicatorTest, require_that_second_phase_work_is_handed_out_in_docid_order)
+{
+    MatchLoopCommunicator f1(2, 32);
+    auto task = [&f1](Nexus& ctx) {
+                    auto thread_id = ctx.thread_id();
+                    Hits my_hits;
+                    std::vector<uint32_t> refs;
+                    for (uint32_t i = 20; i > 0; --i) {
+                        refs.push_back(my_hits.size());
+                        my_hits.emplace_back(i * 2 + thread_id, i);
+                    }
+                    auto first = f1.get_second_phase_work(SortedHitSequence(my_hits.data(), refs.data(), refs.size()), thread_id);
+                    EXPECT_EQ(2u, first.size());
+                    ctx.barrier();
+                    if (thread_id == 0) {
+                        std::vector<uint32_t> docids;
+                        for (auto chunk = f1.get_more_second_phase_work(); !chunk.empty(); chunk = f1.get_more_second_phase_work()) {
+                            EXPECT_EQ(2u, chunk.size());
+                            for (const auto &[hit, tag]: chunk) {
+                                EXPECT_EQ(hit.first % 2, tag);
+                                docids.push_back(hit.first);
+                            }
+                        }
+                        EXPECT_TRUE(std::is_sorted(docids.begin(), docids.end()));
+                        EXPECT_EQ(28u, docids.size());
+                    }
+                    ctx.barrier();
+                    (void) f1.complete_second_phase({}, thread_id);
+                };
+    Nexus::run(2, task);
 }
 
 namespace {
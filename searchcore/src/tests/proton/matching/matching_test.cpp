@@ -3,6 +3,7 @@
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
 #include <vespa/searchcore/proton/documentmetastore/documentmetastore.h>
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
+#include <vespa/searchcore/proton/matching/global_filter_cache.h>
 #include <vespa/searchcore/proton/matching/match_params.h>
 #include <vespa/searchcore/proton/matching/match_tools.h>
 #include <vespa/searchcore/proton/matching/matcher.h>
@@ -1351,4 +1352,71 @@ TEST_F(MatchingTest, weak_and_stop_word_strategy_is_resolved_correctly)
     EXPECT_TRUE(stop_words.allow_drop_all());
 }
 
+TEST_F(MatchingTest, cached_result_is_not_used_after_bucket_state_change)
+{
+    MyWorld world(shared_state());
+    world.basicSetup();
+    world.basicResults();
+    world.set_property(indexproperties::matching::ResultCacheMaxBytes::NAME, "1000000");
+    DocumentMetaStore meta_store(std::make_shared<bucketdb::BucketDBOwner>());
+    for (uint32_t i = 0; i < NUM_DOCS; ++i) {
+        document::DocumentId doc_id(vespalib::make_string("id:ns:searchdocument::%u", i));
+        document::BucketId bucket_id(BucketFactory::getBucketId(doc_id));
+        meta_store.put(doc_id.getGlobalId(), bucket_id, Timestamp(0u), 1, i, 0u);
+        meta_store.setBucketState(bucket_id, true);
+    }
+    Matcher::SP matcher = world.createMatcher();
+    SearchRequest::SP request = MyWorld::createSimpleRequest("f1", "foo");
+    auto search = [&]() {
+        SearchSession::OwnershipBundle owned_objects({std::make_unique<MockAttributeContext>(),
+                                                      std::make_unique<FakeSearchContext>()},
+                                                     std::make_shared<MyWorld::MySearchHandler>(matcher));
+        vespalib::LimitedThreadBundleWrapper thread_bundle(world.shared_state.thread_bundle(), 1);
+        auto reply = matcher->match(*request, thread_bundle, world.searchContext, world.attributeContext,
+                                    *world.sessionManager, meta_store, meta_store.getBucketDB(),
+                                    std::move(owned_objects));
+        return std::make_pair(std::move(reply), matcher->getStats());
+    };
+    auto [first, first_stats] = search();
+    EXPECT_EQ(3u, first->hits.size());
+    EXPECT_EQ(1u, first_stats.result_cache_misses());
+    auto [second, second_stats] = search();
+    EXPECT_EQ(3u, second->hits.size());
+    EXPECT_EQ(1u, second_stats.result_cache_hits());
+    EXPECT_EQ(1u, second_stats.queries());
+    EXPECT_EQ(1u, second_stats.result_cache_entries());
+
+    document::DocumentId deactivated("id:ns:searchdocument::20");
+    meta_store.setBucketState(BucketFactory::getBucketId(deactivated), false);
+    auto [third, third_stats] = search();
+    EXPECT_EQ(0u, third_stats.result_cache_hits());
+    EXPECT_EQ(1u, third_stats.result_cache_misses());
+    for (const auto &hit : third->hits) {
+        EXPECT_NE(deactivated.getGlobalId(), hit.gid);
+    }
+}
+
+TEST_F(MatchingTest, global_filter_cache_key_depends_on_create_blueprint_params_from_query)
+{
+    auto make_key = [](const std::string& drop_limit, const std::string& filter_threshold) {
+        CreateBlueprintParamsFixture f(0.2, 0.8, 5.0, FMA::DfaTable);
+        if (!drop_limit.empty()) {
+            f.rank_properties.add(WeakAndStopWordDropLimit::NAME, drop_limit);
+        }
+        if (!filter_threshold.empty()) {
+            indexproperties::matching::FilterThreshold::set(f.rank_properties, filter_threshold);
+        }
+        return GlobalFilterCache::make_key("stack", "", f.extract(1000, 1000), false, 1, 1, 1000);
+    };
+    EXPECT_EQ(make_key("", ""), make_key("", ""));
+    EXPECT_EQ(make_key("0.5", ""), make_key("0.5", ""));
+    EXPECT_NE(make_key("", ""), make_key("0.5", ""));
+    EXPECT_NE(make_key("0.5", ""), make_key("0.25", ""));
+    EXPECT_NE(make_key("", ""), make_key("", "0.05"));
+    EXPECT_NE(make_key("", "0.05"), make_key("", "0.1"));
+    CreateBlueprintParams params;
+    EXPECT_NE(GlobalFilterCache::make_key("stack", "", params, false, 1, 1, 1000),
+              GlobalFilterCache::make_key("stack", "", params, true, 1, 1, 1000));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
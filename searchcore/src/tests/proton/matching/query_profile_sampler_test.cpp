@@ -0,0 +1,81 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/query_profile_sampler.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using proton::matching::QueryProfileSampler;
+using vespalib::ExecutionProfiler;
+
+namespace {
+
+void run(ExecutionProfiler &profiler, const std::string &name, const std::vector<std::string> &children = {}) {
+    profiler.start(profiler.resolve(name));
+    for (const auto &child: children) {
+        run(profiler, child);
+    }
+    profiler.complete();
+}
+
+std::vector<std::string> stacks_of(const QueryProfileSampler &sampler) {
+    std::vector<std::string> stacks;
+    for (const auto &line: sampler.folded_stacks()) {
+        auto pos = line.rfind(' ');
+        EXPECT_NE(pos, std::string::npos);
+        stacks.push_back(line.substr(0, pos));
+    }
+    return stacks;
+}
+
+}
+
+TEST(QueryProfileSamplerTest, one_in_interval_queries_are_sampled)
+{
+    QueryProfileSampler sampler(3, 16, 100);
+    std::vector<bool> sampled;
+    for (int i = 0; i < 7; ++i) {
+        sampled.push_back(sampler.sample());
+    }
+    EXPECT_EQ(sampled, std::vector<bool>({true, false, false, true, false, false, true}));
+    EXPECT_EQ(7u, sampler.get_stats().queries);
+    EXPECT_EQ(3u, sampler.get_stats().samples);
+}
+
+TEST(QueryProfileSamplerTest, profiles_are_merged_into_folded_stacks)
+{
+    QueryProfileSampler sampler(1, 16, 100);
+    for (int i = 0; i < 2; ++i) {
+        EXPECT_TRUE(sampler.sample());
+        ExecutionProfiler profiler(16);
+        run(profiler, "and", {"term", "term;x"});
+        sampler.add("match", profiler);
+    }
+    // another phase of the last sampled query
+    ExecutionProfiler other(16);
+    run(other, "and", {"term"});
+    sampler.add("first_phase", other, [](const std::string &name) { return "f(" + name + ")"; });
+    EXPECT_EQ(stacks_of(sampler), std::vector<std::string>({"first_phase;f(and)",
+                                                            "first_phase;f(and);f(term)",
+                                                            "match;and",
+                                                            "match;and;term",
+                                                            "match;and;term,x"}));
+    auto stats = sampler.get_stats();
+    EXPECT_EQ(2u, stats.samples);
+    EXPECT_EQ(5u, stats.stacks);
+    EXPECT_EQ(0u, stats.dropped);
+}
+
+TEST(QueryProfileSamplerTest, number_of_stacks_is_bounded)
+{
+    QueryProfileSampler sampler(1, 16, 2);
+    EXPECT_TRUE(sampler.sample());
+    ExecutionProfiler profiler(16);
+    run(profiler, "a", {"b", "c"});
+    sampler.add("match", profiler);
+    EXPECT_EQ(stacks_of(sampler), std::vector<std::string>({"match;a", "match;a;b"}));
+    EXPECT_EQ(1u, sampler.get_stats().dropped);
+    sampler.clear();
+    EXPECT_TRUE(sampler.folded_stacks().empty());
+    EXPECT_EQ(0u, sampler.get_stats().samples);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,130 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/matching/query_result_cache.h>
+#include <vespa/searchlib/common/mapnames.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/gtest/gtest.h>
+
+using proton::matching::QueryResultCache;
+using search::MapNames;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+
+namespace {
+
+std::unique_ptr<SearchRequest> make_request(const std::string &stack) {
+    auto request = std::make_unique<SearchRequest>();
+    request->ranking = "default";
+    request->stackDump.assign(stack.begin(), stack.end());
+    request->maxhits = 10;
+    return request;
+}
+
+SearchReply make_reply(size_t num_hits) {
+    SearchReply reply;
+    reply.totalHitCount = num_hits;
+    reply.hits.resize(num_hits);
+    for (size_t i = 0; i < num_hits; ++i) {
+        reply.hits[i].metric = num_hits - i;
+    }
+    return reply;
+}
+
+std::string make_key(const SearchRequest &request, uint64_t generation = 1) {
+    return QueryResultCache::make_key(request, generation, 1, 100);
+}
+
+}
+
+TEST(QueryResultCacheTest, cached_reply_is_returned_for_same_request)
+{
+    QueryResultCache cache(1_Mi);
+    auto request = make_request("foo");
+    EXPECT_FALSE(cache.lookup(make_key(*request)));
+    cache.insert(make_key(*request), make_reply(3));
+    auto reply = cache.lookup(make_key(*make_request("foo")));
+    ASSERT_TRUE(reply);
+    EXPECT_EQ(3u, reply->totalHitCount);
+    ASSERT_EQ(3u, reply->hits.size());
+    EXPECT_EQ(3.0, reply->hits[0].metric);
+    auto stats = cache.get_stats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(1u, stats.inserts);
+    EXPECT_EQ(1u, stats.entries);
+    EXPECT_LT(0u, stats.memory_usage);
+}
+
+TEST(QueryResultCacheTest, key_depends_on_query_and_generation)
+{
+    auto request = make_request("foo");
+    EXPECT_EQ(make_key(*request), make_key(*make_request("foo")));
+    EXPECT_NE(make_key(*request), make_key(*make_request("bar")));
+    EXPECT_NE(make_key(*request, 1), make_key(*request, 2));
+    auto other = make_request("foo");
+    other->offset = 10;
+    EXPECT_NE(make_key(*request), make_key(*other));
+}
+
+TEST(QueryResultCacheTest, key_does_not_depend_on_rank_property_order)
+{
+    auto a = make_request("foo");
+    a->propertiesMap.lookupCreate(MapNames::RANK).add("x", "1").add("y", "2");
+    auto b = make_request("foo");
+    b->propertiesMap.lookupCreate(MapNames::RANK).add("y", "2").add("x", "1");
+    auto c = make_request("foo");
+    c->propertiesMap.lookupCreate(MapNames::RANK).add("x", "1").add("y", "3");
+    EXPECT_EQ(make_key(*a), make_key(*b));
+    EXPECT_NE(make_key(*a), make_key(*c));
+}
+
+TEST(QueryResultCacheTest, key_does_not_depend_on_trace_properties)
+{
+    auto a = make_request("foo");
+    auto b = make_request("foo");
+    b->propertiesMap.lookupCreate(MapNames::TRACE).add("x", "1");
+    EXPECT_EQ(make_key(*a), make_key(*b));
+}
+
+TEST(QueryResultCacheTest, traced_and_session_requests_are_not_cached)
+{
+    EXPECT_TRUE(QueryResultCache::can_cache(*make_request("foo")));
+    auto traced = make_request("foo");
+    traced->setTraceLevel(1, 1);
+    EXPECT_FALSE(QueryResultCache::can_cache(*traced));
+    auto session = make_request("foo");
+    session->propertiesMap.lookupCreate(MapNames::CACHES).add("query", "true");
+    EXPECT_FALSE(QueryResultCache::can_cache(*session));
+}
+
+TEST(QueryResultCacheTest, least_recently_used_entries_are_evicted_when_memory_limit_is_reached)
+{
+    QueryResultCache cache(4_Ki);
+    auto a = make_key(*make_request("a"));
+    auto b = make_key(*make_request("b"));
+    auto c = make_key(*make_request("c"));
+    cache.insert(a, make_reply(50));
+    cache.insert(b, make_reply(50));
+    EXPECT_TRUE(cache.lookup(a));
+    cache.insert(c, make_reply(50));
+    EXPECT_TRUE(cache.lookup(a));
+    EXPECT_FALSE(cache.lookup(b));
+    EXPECT_TRUE(cache.lookup(c));
+    auto stats = cache.get_stats();
+    EXPECT_EQ(2u, stats.entries);
+    EXPECT_EQ(1u, stats.evictions);
+    EXPECT_GE(4_Ki, stats.memory_usage);
+}
+
+TEST(QueryResultCacheTest, replies_larger_than_memory_limit_are_not_cached)
+{
+    QueryResultCache cache(1_Ki);
+    auto key = make_key(*make_request("a"));
+    cache.insert(key, make_reply(1000));
+    EXPECT_FALSE(cache.lookup(key));
+    EXPECT_EQ(0u, cache.get_stats().inserts);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -2,6 +2,7 @@
 // Unit tests for query.
 
 #include <vespa/searchcore/proton/matching/fakesearchcontext.h>
+#include <vespa/searchcore/proton/matching/global_filter_cache.h>
 #include <vespa/searchcore/proton/matching/matchdatareservevisitor.h>
 #include <vespa/searchcore/proton/matching/blueprintbuilder.h>
 #include <vespa/searchcore/proton/matching/query.h>
@@ -29,6 +30,7 @@
 #include <vespa/searchlib/parsequery/stackdumpiterator.h>
 #include <vespa/document/datatype/positiondatatype.h>
 #include <vespa/vespalib/stllike/asciistream.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/thread_bundle.h>
 #include <vespa/searchlib/query/tree/querytreecreator.h>
 #include <vespa/vespalib/gtest/gtest.h>
@@ -1152,6 +1154,27 @@ TEST(QueryTest, global_filter_is_calculated_and_handled)
     }
 }
 
+TEST(QueryTest, cached_global_filter_is_reused_for_same_key)
+{
+    auto result = SimpleResult().addHit(3).addHit(5).addHit(7);
+    uint32_t docid_limit = 10;
+    std::atomic<vespalib::steady_time> now(vespalib::steady_clock::now());
+    GlobalFilterCache cache(1_Mi, 10s, now);
+    GlobalFilterBlueprint first(result, true);
+    EXPECT_TRUE(Query::handle_global_filter(first, docid_limit, 0, 0.3, ttb(), nullptr, &cache, "a"));
+    GlobalFilterBlueprint second(SimpleResult().addHit(4), true);
+    EXPECT_TRUE(Query::handle_global_filter(second, docid_limit, 0, 1.0, ttb(), nullptr, &cache, "a"));
+    EXPECT_EQ(first.filter.get(), second.filter.get());
+    EXPECT_TRUE(second.filter->check(3));
+    GlobalFilterBlueprint other(SimpleResult().addHit(4), true);
+    EXPECT_TRUE(Query::handle_global_filter(other, docid_limit, 0, 1.0, ttb(), nullptr, &cache, "b"));
+    EXPECT_NE(first.filter.get(), other.filter.get());
+    EXPECT_TRUE(other.filter->check(4));
+    EXPECT_FALSE(other.filter->check(3));
+    EXPECT_EQ(1u, cache.get_stats().hits);
+    EXPECT_EQ(2u, cache.get_stats().misses);
+}
+
 bool query_needs_ranking(const std::string& stack_dump)
 {
     Query query;
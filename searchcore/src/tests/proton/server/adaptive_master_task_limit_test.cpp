@@ -0,0 +1,149 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
+#include <vespa/searchcore/proton/server/adaptive_master_task_limit.h>
+#include <vespa/searchcore/proton/server/feed_handler_stats.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
+
+using namespace proton;
+using vespalib::ExecutorStats;
+
+namespace adaptive_master_task_limit_test {
+
+namespace {
+
+ExecutorStats
+make_executor_stats(size_t max_queue_size, double saturation)
+{
+    ExecutorStats stats(ExecutorStats::QueueSizeT(1, max_queue_size, max_queue_size, max_queue_size), 0, 0, 0);
+    stats.setUtil(1, 1.0 - saturation);
+    return stats;
+}
+
+ExecutorThreadingServiceStats
+make_stats(size_t master_queue_size, double master_saturation = 0.1, double index_saturation = 0.1)
+{
+    return ExecutorThreadingServiceStats(make_executor_stats(master_queue_size, master_saturation),
+                                         make_executor_stats(0, index_saturation),
+                                         make_executor_stats(0, 0.1));
+}
+
+FeedLatencyStats
+make_latency(double latency)
+{
+    FeedLatencyStats stats;
+    stats.add(latency);
+    return stats;
+}
+
+AdaptiveMasterTaskLimitConfig
+enabled_config()
+{
+    return AdaptiveMasterTaskLimitConfig(true, 16, 256, 0.1, 0.9);
+}
+
+}
+
+TEST(AdaptiveMasterTaskLimitTest, static_limit_is_used_when_disabled)
+{
+    AdaptiveMasterTaskLimit limit;
+    EXPECT_EQ(500u, limit.configure(AdaptiveMasterTaskLimitConfig(), 500));
+    EXPECT_EQ(500u, limit.update(make_stats(500), make_latency(1.0)));
+    EXPECT_EQ(0u, limit.get_decreases());
+}
+
+TEST(AdaptiveMasterTaskLimitTest, static_limit_is_used_before_configure)
+{
+    AdaptiveMasterTaskLimit limit(500);
+    EXPECT_EQ(500u, limit.get_limit());
+    EXPECT_EQ(500u, limit.update(make_stats(500), make_latency(1.0)));
+}
+
+TEST(AdaptiveMasterTaskLimitTest, initial_limit_is_static_limit_clamped_to_bounds)
+{
+    AdaptiveMasterTaskLimit limit;
+    EXPECT_EQ(256u, limit.configure(enabled_config(), 0));
+    EXPECT_EQ(100u, limit.configure(AdaptiveMasterTaskLimitConfig(), 100));
+    EXPECT_EQ(100u, limit.configure(enabled_config(), 100));
+    EXPECT_EQ(64u, limit.configure(AdaptiveMasterTaskLimitConfig(true, 16, 64, 0.1, 0.9), 100));
+}
+
+TEST(AdaptiveMasterTaskLimitTest, limit_is_halved_when_latency_is_above_target)
+{
+    AdaptiveMasterTaskLimit limit;
+    limit.configure(enabled_config(), 0);
+    EXPECT_EQ(128u, limit.update(make_stats(10), make_latency(0.2)));
+    EXPECT_EQ(64u, limit.update(make_stats(10), make_latency(0.2)));
+    EXPECT_EQ(2u, limit.get_decreases());
+}
+
+TEST(AdaptiveMasterTaskLimitTest, limit_is_halved_when_an_executor_is_saturated)
+{
+    AdaptiveMasterTaskLimit limit;
+    limit.configure(enabled_config(), 0);
+    EXPECT_EQ(128u, limit.update(make_stats(10, 0.95), FeedLatencyStats()));
+    EXPECT_EQ(64u, limit.update(make_stats(10, 0.1, 0.95), make_latency(0.01)));
+}
+
+TEST(AdaptiveMasterTaskLimitTest, limit_is_not_decreased_below_min)
+{
+    AdaptiveMasterTaskLimit limit;
+    limit.configure(enabled_config(), 20);
+    EXPECT_EQ(16u, limit.update(make_stats(10), make_latency(0.2)));
+    EXPECT_EQ(16u, limit.update(make_stats(10), make_latency(0.2)));
+    EXPECT_EQ(1u, limit.get_decreases());
+}
+
+TEST(AdaptiveMasterTaskLimitTest, limit_is_increased_when_reached_and_latency_is_below_target)
+{
+    AdaptiveMasterTaskLimit limit;
+    limit.configure(enabled_config(), 32);
+    EXPECT_EQ(32u, limit.update(make_stats(10), make_latency(0.01)));
+    EXPECT_EQ(48u, limit.update(make_stats(33), make_latency(0.01)));
+    EXPECT_EQ(48u, limit.update(make_stats(48), FeedLatencyStats()));
+    EXPECT_EQ(1u, limit.get_increases());
+}
+
+TEST(AdaptiveMasterTaskLimitTest, limit_is_not_increased_above_max)
+{
+    AdaptiveMasterTaskLimit limit;
+    limit.configure(enabled_config(), 250);
+    EXPECT_EQ(256u, limit.update(make_stats(251), make_latency(0.01)));
+    EXPECT_EQ(256u, limit.update(make_stats(257), make_latency(0.01)));
+    EXPECT_EQ(1u, limit.get_increases());
+}
+
+TEST(AdaptiveMasterTaskLimitTest, lower_limit_brings_latency_under_target_without_collapsing_to_min)
+{
+    // Saturated feed where latency in the master thread and until acked is proportional to the limit
+    constexpr double task_latency = 0.001;
+    AdaptiveMasterTaskLimit limit;
+    uint32_t current = limit.configure(enabled_config(), 0);
+    EXPECT_EQ(128u, current = limit.update(make_stats(current), make_latency(current * task_latency)));
+    EXPECT_EQ(64u, current = limit.update(make_stats(current), make_latency(current * task_latency)));
+    EXPECT_GT(0.1, current * task_latency);
+    uint32_t min_limit = current;
+    uint32_t max_limit = current;
+    for (int i = 0; i < 100; ++i) {
+        current = limit.update(make_stats(current), make_latency(current * task_latency));
+        min_limit = std::min(min_limit, current);
+        max_limit = std::max(max_limit, current);
+    }
+    EXPECT_LE(48u, min_limit);
+    EXPECT_GE(128u, max_limit);
+    EXPECT_LT(0u, limit.get_increases());
+}
+
+TEST(AdaptiveMasterTaskLimitTest, adjusted_limit_is_kept_across_reconfig)
+{
+    AdaptiveMasterTaskLimit limit;
+    limit.configure(enabled_config(), 0);
+    EXPECT_EQ(128u, limit.update(make_stats(10), make_latency(0.2)));
+    EXPECT_EQ(128u, limit.configure(enabled_config(), 0));
+    EXPECT_EQ(64u, limit.configure(AdaptiveMasterTaskLimitConfig(true, 16, 64, 0.1, 0.9), 0));
+    EXPECT_EQ(0u, limit.configure(AdaptiveMasterTaskLimitConfig(), 0));
+    EXPECT_EQ(0u, limit.update(make_stats(10), make_latency(0.2)));
+}
+
+}
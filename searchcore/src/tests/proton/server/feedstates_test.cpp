@@ -16,6 +16,7 @@
 #include <vespa/searchlib/common/serialnum.h>
 #include <vespa/vespalib/objects/nbostream.h>
 #include <vespa/vespalib/util/foreground_thread_executor.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/buffer.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
 #include <vespa/vespalib/gtest/gtest.h>
@@ -30,6 +31,7 @@ using storage::spi::Timestamp;
 using vespalib::ConstBufferRef;
 using vespalib::nbostream;
 using vespalib::ForegroundThreadExecutor;
+using vespalib::ThreadStackExecutor;
 using namespace proton;
 
 namespace {
@@ -115,7 +117,7 @@ FeedStatesTest::FeedStatesTest()
       _bucketDBHandler(_bucketDB),
       _replay_throttler(vespalib::SharedOperationThrottler::make_unlimited_throttler()),
       _inc_serial_num(9u),
-      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttler, _inc_serial_num)
+      state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store, _replay_throttler, _inc_serial_num, nullptr)
 {
 }
 
@@ -155,3 +157,28 @@ TEST_F(FeedStatesTest, require_that_replay_progress_is_tracked)
     EXPECT_EQ(10u, progress.getCurrent());
     EXPECT_EQ(0.5, progress.getProgress());
 }
+
+TEST_F(FeedStatesTest, require_that_operations_deserialized_in_parallel_are_replayed_in_order)
+{
+    constexpr SerialNum num_ops = 1000;
+    DocumentId doc_id("id:ns:doctypename::bar");
+    Packet packet(0xf000);
+    std::vector<nbostream> streams(num_ops);
+    for (SerialNum i = 0; i < num_ops; ++i) {
+        RemoveOperationWithDocId op(BucketFactory::getBucketId(doc_id), Timestamp(10 + i), doc_id);
+        op.serialize(streams[i]);
+        packet.add(Packet::Entry(10 + i, FeedOperation::REMOVE, ConstBufferRef(streams[i].data(), streams[i].wp())));
+    }
+    ThreadStackExecutor deserializer(4);
+    MyIncSerialNum inc_serial_num(9u);
+    ReplayTransactionLogState parallel_state("doctypename", feed_view_ptr, _bucketDBHandler, replay_config, config_store,
+                                             _replay_throttler, inc_serial_num, &deserializer);
+    TlsReplayProgress progress("test", 9, 9 + num_ops);
+    auto wrap = std::make_shared<PacketWrapper>(packet, &progress);
+    ForegroundThreadExecutor executor;
+
+    parallel_state.receive(wrap, executor);
+    EXPECT_EQ(num_ops, SerialNum(feed_view1.remove_handled));
+    EXPECT_EQ(9 + num_ops, inc_serial_num._serial_num);
+    EXPECT_EQ(9 + num_ops, progress.getCurrent());
+}
@@ -46,6 +46,21 @@ TEST(ThreadingServiceConfigTest, require_that_negative_task_limit_makes_it_soft)
     EXPECT_FALSE(tcfg.is_task_limit_hard());
 }
 
+TEST(ThreadingServiceConfigTest, require_that_adaptive_master_task_limit_is_set)
+{
+    Fixture f;
+    EXPECT_FALSE(f.make().adaptive_master_task_limit().enabled());
+    auto& adaptive = f.cfg.feeding.adaptiveMasterTaskLimit;
+    adaptive.enabled = true;
+    adaptive.min = 32;
+    adaptive.max = 512;
+    adaptive.targetLatency = 0.5;
+    adaptive.maxSaturation = 0.8;
+    auto tcfg = f.make();
+    EXPECT_EQ(AdaptiveMasterTaskLimitConfig(true, 32, 512, 0.5, 0.8), tcfg.adaptive_master_task_limit());
+    EXPECT_FALSE(tcfg == Fixture().make());
+}
+
 namespace {
 
 void assertConfig(uint32_t exp_master_task_limit, uint32_t exp_default_task_limit, const ThreadingServiceConfig& config) {
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "groupingcontext.h"
+#include <vespa/searchlib/aggregation/columnaraggregator.h>
 #include <vespa/searchlib/aggregation/predicates.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
 #include <vespa/searchlib/common/bitvector.h>
@@ -10,9 +11,18 @@ LOG_SETUP(".searchcore/grouping.groupingcontext");
 
 namespace search::grouping {
 
+using aggregation::ColumnarAggregator;
 using aggregation::CountFS4Hits;
 using aggregation::FS4HitSetDistributionKey;
 
+namespace {
+
+// Hits are aggregated in blocks of this size. The number of first
+// level groups is estimated after the first block.
+constexpr unsigned int BLOCK_SIZE = 256;
+
+}
+
 void
 GroupingContext::deserialize(const char *groupSpec, uint32_t groupSpecLen)
 {
@@ -105,9 +115,28 @@ GroupingContext::aggregate(Grouping & grouping, uint32_t docId, HitRank rank) co
 
 unsigned int
 GroupingContext::aggregateRanked(Grouping &grouping, const RankedHit *rankedHit, unsigned int len) const {
+    auto columnar = ColumnarAggregator::create(grouping);
+    std::vector<RankedHit> block;
+    uint32_t groupsBefore = grouping.getRoot().getChildrenSize();
     unsigned int i(0);
-    for(; (i < len) && !hasExpired(); i++) {
-        aggregate(grouping, rankedHit[i].getDocId(), rankedHit[i].getRank());
+    while ((i < len) && !hasExpired()) {
+        unsigned int blockEnd = std::min(len, i + BLOCK_SIZE);
+        if (columnar) {
+            block.clear();
+            for (; i < blockEnd; i++) {
+                if (_validLids.testBit(rankedHit[i].getDocId())) {
+                    block.push_back(rankedHit[i]);
+                }
+            }
+            columnar->aggregate(block.data(), block.size());
+        } else {
+            for (; (i < blockEnd) && !hasExpired(); i++) {
+                aggregate(grouping, rankedHit[i].getDocId(), rankedHit[i].getRank());
+            }
+        }
+        if ((i == BLOCK_SIZE) && (i < len)) {
+            grouping.reserveFirstLevelGroups(groupsBefore, i, len);
+        }
     }
     return i;
 }
@@ -12,6 +12,7 @@
 #include <vespa/searchlib/tensor/i_tensor_attribute.h>
 #include <vespa/searchlib/util/state_explorer_utils.h>
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
 
 using search::AddressSpaceUsage;
 using search::AttributeVector;
@@ -28,6 +29,7 @@ using search::attribute::MultiValueMappingBase;
 using search::attribute::Status;
 using vespalib::AddressSpace;
 using vespalib::MemoryUsage;
+using vespalib::alloc::HugePageAllocator;
 using namespace vespalib::slime;
 
 namespace proton {
@@ -107,6 +109,7 @@ convert_config_to_slime(const Config& cfg, bool full, Cursor& object)
     object.setBool("fast_search", cfg.fastSearch());
     object.setBool("filter", cfg.getIsFilter());
     object.setBool("paged", cfg.paged());
+    object.setBool("huge_pages", cfg.huge_pages());
     if (full) {
         if (cfg.basicType().type() == BasicType::TENSOR) {
             object.setString("distance_metric", DistanceMetricUtils::to_string(cfg.distance_metric()));
@@ -164,6 +167,10 @@ AttributeVectorExplorer::get_state(const vespalib::slime::Inserter &inserter, bo
             convertPostingBaseToSlime(*postingBase, object.setObject("posting_store"));
         }
         convertChangeVectorToSlime(attr, object.setObject("changeVector"));
+        auto* huge_page_allocator = dynamic_cast<const HugePageAllocator*>(attr.get_memory_allocator().get());
+        if (huge_page_allocator != nullptr) {
+            StateExplorerUtils::huge_page_stats_to_slime(huge_page_allocator->get_stats(), object.setObject("huge_pages"));
+        }
         auto* single_bool_attr = dynamic_cast<const SingleBoolAttribute*>(_attr.get());
         if (single_bool_attr != nullptr) {
             auto& bvobj = object.setObject("bitvector");
@@ -2,21 +2,32 @@
 #pragma once
 
 #include <atomic>
+#include <cstdint>
 
 namespace proton {
 
 /**
  * Class representing the end of a local document id range.
+ *
+ * The generation is incremented each time the limit is set or bumped,
+ * which happens when feed operations have been made visible for
+ * search. It can be used to detect that searchable data has changed.
  */
 class DocIdLimit
 {
 private:
     std::atomic<uint32_t> _docIdLimit;
+    std::atomic<uint64_t> _generation;
 
 public:
-    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit) {}
-    void set(uint32_t docIdLimit) { _docIdLimit = docIdLimit; }
+    explicit DocIdLimit(uint32_t docIdLimit) : _docIdLimit(docIdLimit), _generation(0) {}
+    void set(uint32_t docIdLimit) {
+        _docIdLimit = docIdLimit;
+        _generation.fetch_add(1, std::memory_order_release);
+    }
     uint32_t get() const { return _docIdLimit; }
+    // Read before get() to not pair an old limit with a new generation
+    uint64_t getGeneration() const { return _generation.load(std::memory_order_acquire); }
 
     void bumpUpLimit(uint32_t newLimit) {
         for (;;) {
@@ -28,8 +39,8 @@ public:
                                                   std::memory_order_relaxed))
                 break;
         }
+        _generation.fetch_add(1, std::memory_order_release);
     }
 };
 
 } // namespace proton
-
@@ -3,6 +3,7 @@
 
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <atomic>
+#include <cstdint>
 
 namespace storage::spi { class Result; }
 namespace proton {
@@ -23,6 +24,12 @@ public:
 };
 
 
+/*
+ * Writers that a feed operation is handed to after being handled in
+ * the master thread.
+ */
+enum class WriteStage : uint8_t { ATTRIBUTES, MEMORY_INDEX, DOCUMENT_STORE };
+
 /*
  * Interface class for feed token state.
  */
@@ -32,6 +39,9 @@ public:
     virtual void fail() = 0;
     virtual void setResult(ResultUP result, bool documentWasFound) = 0;
     virtual const storage::spi::Result &getResult() = 0;
+    // Returns true if write_done() should be called when each writer is done with the operation.
+    virtual bool tracks_write_stages() const noexcept { return false; }
+    virtual void write_done(WriteStage) noexcept { }
 };
 
 
@@ -983,6 +983,9 @@ DocumentMetaStore::updateActiveLids(const BucketId &bucketId, bool active)
         }
         _lidAlloc.updateActiveLids(lid, active);
     }
+    // Active lids limit the documents visible to search. Bump the generation, since
+    // cached query results and global filters are keyed on it.
+    incGeneration();
 }
 
 void
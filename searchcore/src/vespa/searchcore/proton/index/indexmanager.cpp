@@ -9,6 +9,7 @@
 #include <vespa/searchlib/index/schemautil.h>
 
 using search::diskindex::Fusion;
+using search::diskindex::FusionProgress;
 using search::common::FileHeaderContext;
 using search::common::SerialNumFileHeaderContext;
 using search::index::Schema;
@@ -31,12 +32,14 @@ namespace proton::index {
 IndexManager::MaintainerOperations::MaintainerOperations(const FileHeaderContext &fileHeaderContext,
                                                          const TuneFileIndexManager &tuneFileIndexManager,
                                                          std::shared_ptr<IPostingListCache> posting_list_cache,
-                                                         IThreadingService &threadingService)
+                                                         IThreadingService &threadingService,
+                                                         uint32_t invertShards)
     : _posting_list_cache(std::move(posting_list_cache)),
       _fileHeaderContext(fileHeaderContext),
       _tuneFileIndexing(tuneFileIndexManager._indexing),
       _tuneFileSearch(tuneFileIndexManager._search),
-      _threadingService(threadingService)
+      _threadingService(threadingService),
+      _invertShards(invertShards)
 {
 }
 
@@ -46,7 +49,7 @@ IndexManager::MaintainerOperations::createMemoryIndex(const Schema& schema,
                                                       SerialNum serialNum)
 {
     return std::make_shared<MemoryIndexWrapper>(schema, inspector, _fileHeaderContext, _tuneFileIndexing,
-                                                _threadingService, serialNum);
+                                                _threadingService, _invertShards, serialNum);
 }
 
 IDiskIndex::SP
@@ -68,11 +71,13 @@ IndexManager::MaintainerOperations::runFusion(const Schema &schema,
                                               const std::vector<std::string> &sources,
                                               const SelectorArray &selectorArray,
                                               SerialNum serialNum,
-                                              std::shared_ptr<IFlushToken> flush_token)
+                                              std::shared_ptr<IFlushToken> flush_token,
+                                              std::shared_ptr<FusionProgress> progress)
 {
     SerialNumFileHeaderContext fileHeaderContext(_fileHeaderContext, serialNum);
     Fusion fusion(schema, outputDir, sources, selectorArray,
                   _tuneFileIndexing, fileHeaderContext);
+    fusion.set_progress(std::move(progress));
     return fusion.merge(_threadingService.shared(), std::move(flush_token));
 }
 
@@ -88,7 +93,8 @@ IndexManager::IndexManager(const std::string &baseDir,
                            const search::TuneFileIndexManager &tuneFileIndexManager,
                            const search::TuneFileAttributes &tuneFileAttributes,
                            const FileHeaderContext &fileHeaderContext) :
-    _operations(fileHeaderContext, tuneFileIndexManager, std::move(posting_list_cache),threadingService),
+    _operations(fileHeaderContext, tuneFileIndexManager, std::move(posting_list_cache), threadingService,
+                indexConfig.invertShards),
     _maintainer(IndexMaintainerConfig(baseDir, indexConfig.warmup, indexConfig.maxFlushed, schema, serialNum, tuneFileAttributes),
                 IndexMaintainerContext(threadingService, reconfigurer, fileHeaderContext, warmupExecutor),
                 _operations)
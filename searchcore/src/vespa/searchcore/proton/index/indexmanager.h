@@ -15,12 +15,17 @@ struct IndexConfig {
     using WarmupConfig = searchcorespi::index::WarmupConfig;
     IndexConfig() : IndexConfig(WarmupConfig(), 2) { }
     IndexConfig(WarmupConfig warmup_, size_t maxFlushed_)
+        : IndexConfig(warmup_, maxFlushed_, 1)
+    { }
+    IndexConfig(WarmupConfig warmup_, size_t maxFlushed_, uint32_t invertShards_)
         : warmup(warmup_),
-          maxFlushed(maxFlushed_)
+          maxFlushed(maxFlushed_),
+          invertShards(invertShards_)
     { }
 
     const WarmupConfig warmup;
     const size_t       maxFlushed;
+    const uint32_t     invertShards;
 };
 
 /**
@@ -41,12 +46,14 @@ public:
         const search::TuneFileIndexing _tuneFileIndexing;
         const search::TuneFileSearch _tuneFileSearch;
         searchcorespi::index::IThreadingService &_threadingService;
+        const uint32_t _invertShards;
 
     public:
         MaintainerOperations(const search::common::FileHeaderContext &fileHeaderContext,
                              const search::TuneFileIndexManager &tuneFileIndexManager,
                              std::shared_ptr<search::diskindex::IPostingListCache> posting_list_cache,
-                             searchcorespi::index::IThreadingService &threadingService);
+                             searchcorespi::index::IThreadingService &threadingService,
+                             uint32_t invertShards);
 
         IMemoryIndex::SP createMemoryIndex(const Schema& schema,
                                            const IFieldLengthInspector& inspector,
@@ -57,7 +64,8 @@ public:
                        const std::vector<std::string> &sources,
                        const SelectorArray &docIdSelector,
                        search::SerialNum lastSerialNum,
-                       std::shared_ptr<search::IFlushToken> flush_token) override;
+                       std::shared_ptr<search::IFlushToken> flush_token,
+                       std::shared_ptr<search::diskindex::FusionProgress> progress) override;
     };
 
 private:
@@ -130,9 +138,15 @@ public:
     void setMaxFlushed(uint32_t maxFlushed) override {
         _maintainer.setMaxFlushed(maxFlushed);
     }
+    void setFusionSizeRatio(double sizeRatio, uint32_t maxFlushedDeferred) override {
+        _maintainer.setFusionSizeRatio(sizeRatio, maxFlushedDeferred);
+    }
     bool has_pending_urgent_flush() const override {
         return _maintainer.has_pending_urgent_flush();
     }
+    std::shared_ptr<const search::diskindex::FusionProgress> get_fusion_progress() const override {
+        return _maintainer.get_fusion_progress();
+    }
 };
 
 } // namespace proton
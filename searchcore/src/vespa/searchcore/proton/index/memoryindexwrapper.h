@@ -30,6 +30,7 @@ public:
                        const search::common::FileHeaderContext& fileHeaderContext,
                        const search::TuneFileIndexing& tuneFileIndexing,
                        searchcorespi::index::IThreadingService& threadingService,
+                       uint32_t invertShards,
                        SerialNum serialNum);
 
     /**
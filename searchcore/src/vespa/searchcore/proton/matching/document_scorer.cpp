@@ -27,11 +27,22 @@ extractScoreFeature(const RankProgram &rankProgram)
 
 DocumentScorer::DocumentScorer(RankProgram &rankProgram,
                                SearchIterator &searchItr)
+    : DocumentScorer(rankProgram, searchItr, false)
+{
+}
+
+DocumentScorer::DocumentScorer(RankProgram &rankProgram,
+                               SearchIterator &searchItr,
+                               bool prepare_batches)
     : _searchItr(searchItr),
-      _scoreFeature(extractScoreFeature(rankProgram))
+      _scoreFeature(extractScoreFeature(rankProgram)),
+      _batch_program(prepare_batches ? &rankProgram : nullptr),
+      _docids()
 {
 }
 
+DocumentScorer::~DocumentScorer() = default;
+
 void
 DocumentScorer::score(TaggedHits &hits)
 {
@@ -41,6 +52,13 @@ DocumentScorer::score(TaggedHits &hits)
     auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
     std::sort(hits.begin(), hits.end(), sort_on_docid);
     _searchItr.initRange(hits.front().first.first, hits.back().first.first + 1);
+    if (_batch_program != nullptr) {
+        _docids.clear();
+        for (const auto &hit: hits) {
+            _docids.push_back(hit.first.first);
+        }
+        _batch_program->prepare_batch(_docids);
+    }
     for (auto &hit: hits) {
         hit.first.second = doScore(hit.first.first);
     }
@@ -23,6 +23,8 @@ class DocumentScorer
 private:
     search::queryeval::SearchIterator &_searchItr;
     search::fef::LazyValue _scoreFeature;
+    search::fef::RankProgram *_batch_program;
+    std::vector<uint32_t> _docids;
 
 public:
     using TaggedHit = IMatchLoopCommunicator::TaggedHit;
@@ -30,6 +32,11 @@ public:
 
     DocumentScorer(search::fef::RankProgram &rankProgram,
                    search::queryeval::SearchIterator &searchItr);
+    // let the rank program prepare for each set of hits before scoring (when ranking does not use match data)
+    DocumentScorer(search::fef::RankProgram &rankProgram,
+                   search::queryeval::SearchIterator &searchItr,
+                   bool prepare_batches);
+    ~DocumentScorer();
 
     search::feature_t doScore(uint32_t docId) {
         _searchItr.unpack(docId);
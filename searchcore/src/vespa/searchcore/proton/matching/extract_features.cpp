@@ -11,6 +11,8 @@
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/fef/utils.h>
 #include <vespa/searchlib/queryeval/searchiterator.h>
+#include <algorithm>
+#include <atomic>
 
 using vespalib::Doom;
 using vespalib::FeatureSet;
@@ -31,26 +33,45 @@ using FefUtils = search::fef::Utils;
 
 namespace {
 
+// Documents are split into small chunks claimed by the threads as they go, letting fast threads do more work
+class DocChunks {
+    static constexpr size_t chunks_per_thread = 8;
+    const OrderedDocs &_docs;
+    size_t _chunk_size;
+    std::atomic<size_t> _next_chunk;
+public:
+    using Chunk = std::pair<const std::pair<uint32_t,uint32_t> *, const std::pair<uint32_t,uint32_t> *>;
+    DocChunks(const OrderedDocs &docs, size_t num_threads)
+      : _docs(docs),
+        _chunk_size(std::max(size_t(1), (docs.size() + (num_threads * chunks_per_thread) - 1) / (num_threads * chunks_per_thread))),
+        _next_chunk(0)
+    {}
+    size_t num_chunks() const { return (_docs.size() + _chunk_size - 1) / _chunk_size; }
+    Chunk claim() {
+        size_t begin = std::min(_next_chunk.fetch_add(1, std::memory_order_relaxed) * _chunk_size, _docs.size());
+        size_t end = std::min(begin + _chunk_size, _docs.size());
+        return {_docs.data() + begin, _docs.data() + end};
+    }
+};
+
 struct MyChunk : Runnable {
-    const std::pair<uint32_t,uint32_t> *begin;
-    const std::pair<uint32_t,uint32_t> *end;
+    DocChunks &work;
     FeatureValues &result;
     const Doom &doom;
-    MyChunk(const std::pair<uint32_t,uint32_t> *begin_in,
-            const std::pair<uint32_t,uint32_t> *end_in,
-            FeatureValues &result_in, const Doom &doom_in)
-      : begin(begin_in), end(end_in), result(result_in), doom(doom_in) {}
+    MyChunk(DocChunks &work_in, FeatureValues &result_in, const Doom &doom_in)
+      : work(work_in), result(result_in), doom(doom_in) {}
     void calculate_features(SearchIterator &search, const FeatureResolver &resolver) {
-        assert(end > begin);
         assert(resolver.num_features() == result.names.size());
-        search.initRange(begin[0].first, end[-1].first + 1);
-        for (auto pos = begin; pos != end; ++pos) {
-            if (doom.hard_doom()) {
-                return;
+        for (auto [begin, end] = work.claim(); end > begin; std::tie(begin, end) = work.claim()) {
+            search.initRange(begin[0].first, end[-1].first + 1);
+            for (auto pos = begin; pos != end; ++pos) {
+                if (doom.hard_doom()) {
+                    return;
+                }
+                search.unpack(pos->first);
+                auto *dst = &result.values[pos->second * resolver.num_features()];
+                FefUtils::extract_feature_values(resolver, pos->first, dst);
             }
-            search.unpack(pos->first);
-            auto *dst = &result.values[pos->second * resolver.num_features()];
-            FefUtils::extract_feature_values(resolver, pos->first, dst);
         }
     }
 };
@@ -58,13 +79,12 @@ struct MyChunk : Runnable {
 struct FirstChunk : MyChunk {
     SearchIterator &search;
     const FeatureResolver &resolver;
-    FirstChunk(const std::pair<uint32_t,uint32_t> *begin_in,
-               const std::pair<uint32_t,uint32_t> *end_in,
+    FirstChunk(DocChunks &work_in,
                FeatureValues &result_in,
                const Doom &doom_in,
                SearchIterator &search_in,
                const FeatureResolver &resolver_in)
-      : MyChunk(begin_in, end_in, result_in, doom_in),
+      : MyChunk(work_in, result_in, doom_in),
         search(search_in),
         resolver(resolver_in) {}
     void run() override { calculate_features(search, resolver); }
@@ -72,12 +92,11 @@ struct FirstChunk : MyChunk {
 
 struct LaterChunk : MyChunk {
     const MatchToolsFactory &mtf;
-    LaterChunk(const std::pair<uint32_t,uint32_t> *begin_in,
-               const std::pair<uint32_t,uint32_t> *end_in,
+    LaterChunk(DocChunks &work_in,
                FeatureValues &result_in,
                const Doom &doom_in,
                const MatchToolsFactory &mtf_in)
-      : MyChunk(begin_in, end_in, result_in, doom_in),
+      : MyChunk(work_in, result_in, doom_in),
         mtf(mtf_in) {}
     void run() override {
         auto tools = mtf.createMatchTools();
@@ -120,24 +139,17 @@ ExtractFeatures::get_match_features(const MatchToolsFactory &mtf, const OrderedD
     result.names = FefUtils::extract_feature_names(resolver, mtf.get_feature_rename_map());
     result.values.resize(result.names.size() * docs.size());
     size_t num_threads = thread_bundle.size();
+    DocChunks work(docs, num_threads);
+    num_threads = std::min(num_threads, work.num_chunks());
     std::vector<Runnable::UP> chunks;
     chunks.reserve(num_threads);
-    size_t per_thread = docs.size() / num_threads;
-    size_t rest_docs = docs.size() % num_threads;
-    size_t idx = 0;
     for (size_t i = 0; i < num_threads; ++i) {
-        size_t chunk_size = per_thread + (i < rest_docs);
-        if (chunk_size == 0) {
-            break;
-        }
         if (i == 0) {
-            chunks.push_back(std::make_unique<FirstChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), tools->search(), resolver));
+            chunks.push_back(std::make_unique<FirstChunk>(work, result, tools->getDoom(), tools->search(), resolver));
         } else {
-            chunks.push_back(std::make_unique<LaterChunk>(&docs[idx], &docs[idx + chunk_size], result, tools->getDoom(), mtf));
+            chunks.push_back(std::make_unique<LaterChunk>(work, result, tools->getDoom(), mtf));
         }
-        idx += chunk_size;
     }
-    assert(idx == docs.size());
     thread_bundle.run(chunks);
     return result;
 }
@@ -65,6 +65,10 @@ public:
     uint32_t getDocIdLimit() override {
         return _docIdLimit;
     }
+
+    uint64_t getVisibilityGeneration() override {
+        return 0;
+    }
     virtual const vespalib::Doom & getDoom() const { return _doom; }
 };
 
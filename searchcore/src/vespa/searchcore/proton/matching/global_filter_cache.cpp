@@ -0,0 +1,219 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "global_filter_cache.h"
+#include <vespa/searchlib/queryeval/create_blueprint_params.h>
+#include <vespa/searchlib/queryeval/global_filter.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <bit>
+
+using search::queryeval::GlobalFilter;
+using vespalib::steady_time;
+
+namespace proton::matching {
+
+namespace {
+
+struct Entry {
+    std::shared_ptr<const GlobalFilter> filter;
+    steady_time                         created;
+    size_t                              bytes;
+    Entry() noexcept : filter(), created(), bytes(0) {}
+    Entry(std::shared_ptr<const GlobalFilter> filter_in, steady_time created_in, size_t bytes_in) noexcept
+        : filter(std::move(filter_in)), created(created_in), bytes(bytes_in) {}
+};
+
+using LruParam = vespalib::LruParam<std::string, Entry>;
+
+void add(std::string &key, uint64_t value) {
+    key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+void add(std::string &key, double value) {
+    add(key, std::bit_cast<uint64_t>(value));
+}
+
+void add(std::string &key, std::string_view value) {
+    add(key, value.size());
+    key.append(value);
+}
+
+size_t estimate_bytes(const std::string &key, const GlobalFilter &filter) {
+    size_t bytes = sizeof(Entry) + key.size();
+    if (filter.is_active()) {
+        bytes += filter.size() / 8;
+    }
+    return bytes;
+}
+
+}
+
+struct GlobalFilterLruCache : vespalib::lrucache_map<LruParam> {
+    size_t _max_bytes;
+    size_t _memory_usage;
+    explicit GlobalFilterLruCache(size_t max_bytes)
+        : lrucache_map(UNLIMITED), _max_bytes(max_bytes), _memory_usage(0) {}
+    bool removeOldest(const LruParam::value_type &v) override {
+        if (_memory_usage > _max_bytes) {
+            _memory_usage -= v.second._value.bytes;
+            return true;
+        }
+        return false;
+    }
+};
+
+GlobalFilterCache::GlobalFilterCache(size_t max_bytes, vespalib::duration max_age,
+                                     const std::atomic<steady_time> &now_ref)
+    : _lock(),
+      _cache(std::make_unique<GlobalFilterLruCache>(max_bytes)),
+      _now_ref(now_ref),
+      _max_age(max_age),
+      _stats()
+{
+}
+
+GlobalFilterCache::~GlobalFilterCache() = default;
+
+std::string
+GlobalFilterCache::make_key(std::string_view query_stack, std::string_view location,
+                            const CreateBlueprintParams &params, bool sort_by_cost,
+                            uint64_t visibility_generation, uint64_t meta_store_generation,
+                            uint32_t docid_limit)
+{
+    std::string key;
+    add(key, visibility_generation);
+    add(key, meta_store_generation);
+    add(key, uint64_t(docid_limit));
+    // query-time overrides of these change the blueprint the filter is calculated from
+    add(key, params.global_filter_lower_limit);
+    add(key, params.global_filter_upper_limit);
+    add(key, params.filter_first_upper_limit);
+    add(key, params.filter_first_exploration);
+    add(key, params.exploration_slack);
+    add(key, params.target_hits_max_adjustment_factor);
+    add(key, uint64_t(params.fuzzy_matching_algorithm));
+    add(key, uint64_t(params.weakand_stop_word_strategy.adjust_limit()));
+    add(key, uint64_t(params.weakand_stop_word_strategy.drop_limit()));
+    add(key, uint64_t(params.weakand_stop_word_strategy.allow_drop_all()));
+    add(key, uint64_t(params.filter_threshold.has_value()));
+    add(key, params.filter_threshold.value_or(0.0));
+    add(key, uint64_t(sort_by_cost));
+    add(key, location);
+    add(key, query_stack);
+    return key;
+}
+
+GlobalFilterCache::FilterSP
+GlobalFilterCache::find(const std::string &key, steady_time now)
+{
+    auto *entry = _cache->find_and_ref(key);
+    if (entry == nullptr) {
+        return {};
+    }
+    if (now - entry->created > _max_age) {
+        _cache->_memory_usage -= entry->bytes;
+        _cache->erase(key);
+        return {};
+    }
+    return entry->filter;
+}
+
+void
+GlobalFilterCache::insert(const std::string &key, FilterSP filter, steady_time now)
+{
+    size_t bytes = estimate_bytes(key, *filter);
+    if (bytes > _cache->_max_bytes) {
+        return;
+    }
+    if (auto *entry = _cache->find_and_ref(key)) {
+        _cache->_memory_usage -= entry->bytes;
+        *entry = Entry(std::move(filter), now, bytes);
+        _cache->_memory_usage += bytes;
+        return;
+    }
+    _cache->_memory_usage += bytes;
+    _cache->insert(key, Entry(std::move(filter), now, bytes));
+}
+
+GlobalFilterCache::FilterSP
+GlobalFilterCache::lookup(const std::string &key)
+{
+    steady_time now = _now_ref.load(std::memory_order_relaxed);
+    std::lock_guard guard(_lock);
+    auto filter = find(key, now);
+    if (filter) {
+        ++_stats.hits;
+    } else {
+        ++_stats.misses;
+    }
+    return filter;
+}
+
+void
+GlobalFilterCache::insert(const std::string &key, FilterSP filter)
+{
+    steady_time now = _now_ref.load(std::memory_order_relaxed);
+    std::lock_guard guard(_lock);
+    insert(key, std::move(filter), now);
+}
+
+GlobalFilterCache::FilterSP
+GlobalFilterCache::lookup_or_create(const std::string &key, const CreateFilter &create, bool &cached)
+{
+    std::promise<FilterSP> promise;
+    {
+        std::unique_lock guard(_lock);
+        if (auto filter = find(key, _now_ref.load(std::memory_order_relaxed))) {
+            ++_stats.hits;
+            cached = true;
+            return filter;
+        }
+        auto pos = _pending.find(key);
+        if (pos != _pending.end()) {
+            auto pending = pos->second;
+            guard.unlock();
+            // nullptr if the calculating query failed; calculate it ourselves then
+            if (auto filter = pending.get()) {
+                guard.lock();
+                ++_stats.hits;
+                cached = true;
+                return filter;
+            }
+            cached = false;
+            return create();
+        }
+        ++_stats.misses;
+        _pending.emplace(key, promise.get_future().share());
+    }
+    cached = false;
+    FilterSP filter;
+    try {
+        filter = create();
+    } catch (...) {
+        {
+            std::lock_guard guard(_lock);
+            _pending.erase(key);
+        }
+        promise.set_value({});
+        throw;
+    }
+    {
+        steady_time now = _now_ref.load(std::memory_order_relaxed);
+        std::lock_guard guard(_lock);
+        insert(key, filter, now);
+        _pending.erase(key);
+    }
+    promise.set_value(filter);
+    return filter;
+}
+
+GlobalFilterCache::Stats
+GlobalFilterCache::get_stats() const
+{
+    std::lock_guard guard(_lock);
+    Stats stats = _stats;
+    stats.entries = _cache->size();
+    stats.memory_usage = _cache->_memory_usage;
+    return stats;
+}
+
+}
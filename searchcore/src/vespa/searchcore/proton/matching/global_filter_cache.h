@@ -0,0 +1,83 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace search::queryeval {
+class GlobalFilter;
+struct CreateBlueprintParams;
+}
+
+namespace proton::matching {
+
+struct GlobalFilterLruCache;
+
+/**
+ * Short-lived cache of global filters shared between queries run by a
+ * matcher. Concurrent queries with the same query tree against the
+ * same data (typically differing only in the query vector used by a
+ * nearest neighbor search) get the same global filter, so it only
+ * needs to be calculated once. Entries are keyed on the query tree,
+ * the parameters used when building the blueprint from it and the
+ * generations of the searched data, expire after a maximum age and
+ * are evicted in LRU order when the memory limit is reached.
+ *
+ * Concurrent misses on the same key calculate the filter only once;
+ * the other queries wait for that calculation and count as hits.
+ *
+ * Thread safe.
+ **/
+class GlobalFilterCache
+{
+public:
+    using GlobalFilter = search::queryeval::GlobalFilter;
+    using CreateBlueprintParams = search::queryeval::CreateBlueprintParams;
+    using FilterSP = std::shared_ptr<const GlobalFilter>;
+    using CreateFilter = std::function<FilterSP()>;
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t entries;
+        size_t memory_usage;
+        Stats() noexcept : hits(0), misses(0), entries(0), memory_usage(0) {}
+    };
+
+private:
+    mutable std::mutex                          _lock;
+    std::unique_ptr<GlobalFilterLruCache>       _cache;
+    const std::atomic<vespalib::steady_time>   &_now_ref;
+    vespalib::duration                          _max_age;
+    Stats                                       _stats;
+    std::map<std::string, std::shared_future<FilterSP>> _pending; // filters being calculated
+
+    FilterSP find(const std::string &key, vespalib::steady_time now);
+    void insert(const std::string &key, FilterSP filter, vespalib::steady_time now);
+
+public:
+    GlobalFilterCache(size_t max_bytes, vespalib::duration max_age, const std::atomic<vespalib::steady_time> &now_ref);
+    ~GlobalFilterCache();
+
+    static std::string make_key(std::string_view query_stack, std::string_view location,
+                                const CreateBlueprintParams &params, bool sort_by_cost,
+                                uint64_t visibility_generation, uint64_t meta_store_generation,
+                                uint32_t docid_limit);
+
+    // returns nullptr if there is no entry younger than the maximum age
+    FilterSP lookup(const std::string &key);
+    void insert(const std::string &key, FilterSP filter);
+    // returns the cached filter, waits for a pending calculation or calls create;
+    // 'cached' is set to false if this caller had to call create
+    FilterSP lookup_or_create(const std::string &key, const CreateFilter &create, bool &cached);
+    Stats get_stats() const;
+};
+
+}
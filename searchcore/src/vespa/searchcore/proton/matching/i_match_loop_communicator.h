@@ -30,7 +30,10 @@ struct IMatchLoopCommunicator {
         }
     };
     virtual double estimate_match_frequency(const Matches &matches) = 0;
+    // returns the first chunk of second phase work for this thread, selected hits are tagged with their origin thread
     virtual TaggedHits get_second_phase_work(SortedHitSequence sortedHits, size_t thread_id) = 0;
+    // claims another chunk of unscored second phase work, empty when all work has been claimed
+    virtual TaggedHits get_more_second_phase_work() = 0;
     virtual std::pair<Hits,RangePair> complete_second_phase(TaggedHits my_results, size_t thread_id) = 0;
     virtual ~IMatchLoopCommunicator() = default;
 };
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <memory>
 
 namespace search::queryeval { class Searchable; }
@@ -54,6 +55,14 @@ public:
      **/
     virtual uint32_t getDocIdLimit() = 0;
 
+    /**
+     * Obtain the generation of the searchable data. A new generation
+     * is used each time changes have been made visible for search.
+     *
+     * @return visibility generation
+     **/
+    virtual uint64_t getVisibilityGeneration() = 0;
+
     /**
      * Deleting the context will trigger cleanup in the
      * implementation.
@@ -4,6 +4,7 @@
 #include <vespa/searchlib/features/first_phase_rank_lookup.h>
 #include <vespa/vespalib/util/priority_queue.h>
 #include <vespa/vespalib/util/rendezvous.hpp>
+#include <algorithm>
 
 using search::features::FirstPhaseRankLookup;
 
@@ -68,11 +69,22 @@ MatchLoopCommunicator::GetSecondPhaseWork::GetSecondPhaseWork(size_t n, size_t t
       best_dropped(best_dropped_in),
       _diversifier(std::move(diversifier)),
       _first_phase_rank_lookup(first_phase_rank_lookup),
-      _before_second_phase(std::move(before_second_phase))
+      _before_second_phase(std::move(before_second_phase)),
+      _work(),
+      _chunk_size(1),
+      _next_chunk(0)
 {}
 
 MatchLoopCommunicator::GetSecondPhaseWork::~GetSecondPhaseWork() = default;
 
+MatchLoopCommunicator::TaggedHits
+MatchLoopCommunicator::GetSecondPhaseWork::get_chunk(size_t chunk) const
+{
+    size_t begin = std::min(chunk * _chunk_size, _work.size());
+    size_t end = std::min(begin + _chunk_size, _work.size());
+    return {_work.begin() + begin, _work.begin() + end};
+}
+
 template<typename Q, typename F, typename R>
 void
 MatchLoopCommunicator::GetSecondPhaseWork::mingle(Q &queue, F &&accept, R register_first_phase_rank)
@@ -84,7 +96,7 @@ MatchLoopCommunicator::GetSecondPhaseWork::mingle(Q &queue, F &&accept, R regist
         const Hit & hit = in(i).get();
         if (accept(hit.first)) {
             register_first_phase_rank.pick(hit.first);
-            out(picked % size()).emplace_back(hit, i);
+            _work.emplace_back(hit, i);
             last_score = hit.second;
             if (++picked == 1) {
                 best_scores.high = hit.second;
@@ -125,10 +137,10 @@ MatchLoopCommunicator::GetSecondPhaseWork::mingle()
     _before_second_phase();
     best_scores = Range();
     best_dropped.valid = false;
-    size_t est_out = (topN / size()) + 1;
+    _work.clear();
+    _work.reserve(topN);
     vespalib::PriorityQueue<uint32_t, SelectCmp> queue(SelectCmp(*this));
     for (size_t i = 0; i < size(); ++i) {
-        out(i).reserve(est_out);
         if (in(i).valid()) {
             queue.push(i);
         }
@@ -138,6 +150,14 @@ MatchLoopCommunicator::GetSecondPhaseWork::mingle()
     } else {
         mingle(queue, NoRegisterFirstPhaseRank());
     }
+    auto sort_on_docid = [](const TaggedHit &a, const TaggedHit &b){ return (a.first.first < b.first.first); };
+    std::sort(_work.begin(), _work.end(), sort_on_docid);
+    size_t num_chunks = size() * chunks_per_thread;
+    _chunk_size = std::max(size_t(1), (_work.size() + num_chunks - 1) / num_chunks);
+    for (size_t i = 0; i < size(); ++i) {
+        out(i) = get_chunk(i);
+    }
+    _next_chunk.store(size(), std::memory_order_relaxed);
 }
 
 void
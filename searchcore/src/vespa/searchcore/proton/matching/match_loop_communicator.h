@@ -5,6 +5,7 @@
 #include "i_match_loop_communicator.h"
 #include <vespa/searchlib/queryeval/idiversifier.h>
 #include <vespa/vespalib/util/rendezvous.h>
+#include <atomic>
 #include <functional>
 
 namespace search::features { class FirstPhaseRankLookup; }
@@ -24,16 +25,28 @@ private:
         EstimateMatchFrequency(size_t n) : vespalib::Rendezvous<Matches, double>(n) {}
         void mingle() override;
     };
+    /*
+     * All selected hits are sorted on docid and split into chunks
+     * that are claimed by the threads as they complete their previous
+     * chunk. This lets fast threads take over work that would
+     * otherwise wait for slow threads.
+     */
     struct GetSecondPhaseWork : vespalib::Rendezvous<SortedHitSequence, TaggedHits, true> {
+        static constexpr size_t chunks_per_thread = 8;
         size_t topN;
         Range &best_scores;
         BestDropped &best_dropped;
         std::unique_ptr<IDiversifier> _diversifier;
         FirstPhaseRankLookup* _first_phase_rank_lookup;
         std::function<void()> _before_second_phase;
+        TaggedHits _work;
+        size_t _chunk_size;
+        std::atomic<size_t> _next_chunk;
         GetSecondPhaseWork(size_t n, size_t topN_in, Range &best_scores_in, BestDropped &best_dropped_in, std::unique_ptr<IDiversifier> diversifier, FirstPhaseRankLookup* first_phase_rank_lookup, std::function<void()> before_second_phase);
         ~GetSecondPhaseWork() override;
         void mingle() override;
+        TaggedHits get_chunk(size_t chunk) const;
+        TaggedHits get_more_work() { return get_chunk(_next_chunk.fetch_add(1, std::memory_order_relaxed)); }
         template<typename Q, typename R>
         void mingle(Q &queue, R register_first_phase_rank);
         template<typename Q, typename F, typename R>
@@ -78,6 +91,10 @@ public:
         return _get_second_phase_work.rendezvous(sortedHits, thread_id);
     }
 
+    TaggedHits get_more_second_phase_work() override {
+        return _get_second_phase_work.get_more_work();
+    }
+
     std::pair<Hits,RangePair> complete_second_phase(TaggedHits my_results, size_t thread_id) override {
         return _complete_second_phase.rendezvous(std::move(my_results), thread_id);
     }
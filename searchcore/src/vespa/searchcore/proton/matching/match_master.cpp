@@ -40,6 +40,9 @@ struct TimedMatchLoopCommunicator final : IMatchLoopCommunicator {
         timer = vespalib::Timer();
         return result;
     }
+    TaggedHits get_more_second_phase_work() override {
+        return communicator.get_more_second_phase_work();
+    }
     std::pair<Hits,RangePair> complete_second_phase(TaggedHits my_results, size_t thread_id) override {
         auto result = communicator.complete_second_phase(std::move(my_results), thread_id);
         elapsed = timer.elapsed();
@@ -4,6 +4,7 @@
 #include "document_scorer.h"
 #include "match_tools.h"
 #include "partial_result.h"
+#include "query_profile_sampler.h"
 #include <vespa/searchcore/grouping/groupingmanager.h>
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchlib/engine/trace.h>
@@ -107,14 +108,39 @@ MatchThread::Context::Context(std::optional<double> first_phase_rank_score_drop_
       _first_phase_rank_score_drop_limit(first_phase_rank_score_drop_limit.value_or(0.0 /* ignored */)),
       _hits(hits),
       _doom(tools.getDoom()),
+      _rank_in_batches(!tools.rank_uses_match_data()),
+      _batch_docids(),
+      _batch_scores(),
       dropped()
 {
+    if (_rank_in_batches) {
+        _batch_docids.reserve(rank_batch_size);
+        _batch_scores.resize(rank_batch_size);
+    }
 }
 
 template <MatchThread::RankDropLimitE use_rank_drop_limit>
 void
 MatchThread::Context::rankHit(uint32_t docId) {
-    double score = _score_feature.as_number(docId);
+    add_ranked_hit<use_rank_drop_limit>(docId, _score_feature.as_number(docId));
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::rank_batch() {
+    if (_batch_docids.empty()) {
+        return;
+    }
+    _score_feature.as_numbers(_batch_docids, _batch_scores);
+    for (size_t i = 0; i < _batch_docids.size(); ++i) {
+        add_ranked_hit<use_rank_drop_limit>(_batch_docids[i], _batch_scores[i]);
+    }
+    _batch_docids.clear();
+}
+
+template <MatchThread::RankDropLimitE use_rank_drop_limit>
+void
+MatchThread::Context::add_ranked_hit(uint32_t docId, double score) {
     // convert NaN and Inf scores to -Inf
     if (__builtin_expect(std::isnan(score) || std::isinf(score), false)) {
         score = -HUGE_VAL;
@@ -191,8 +217,12 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
     uint32_t docId = search->seekFirst(docid_range.begin);
     while ((docId < docid_range.end) && !context.atSoftDoom()) {
         if (do_rank) {
-            search->unpack(docId);
-            context.rankHit<use_rank_drop_limit>(docId);
+            if (context.rank_in_batches()) {
+                context.add_to_batch<use_rank_drop_limit>(docId);
+            } else {
+                search->unpack(docId);
+                context.rankHit<use_rank_drop_limit>(docId);
+            }
         } else {
             context.addHit(docId);
         }
@@ -207,6 +237,9 @@ MatchThread::inner_match_loop(Context &context, MatchTools &tools, DocidRange &d
             docId = Strategy::seek_next(*search, docId + 1);
         }
     }
+    if (do_rank) {
+        context.rank_batch<use_rank_drop_limit>();
+    }
     return docId;
 }
 
@@ -329,18 +362,21 @@ MatchThread::secondPhase(MatchTools & tools, HitCollector & hits) {
      */
     auto my_work = communicator.get_second_phase_work(sorted_hit_seq, thread_id);
     get_second_phase_work_timer.done();
-    if (tools.getDoom().hard_doom()) {
-        my_work.clear();
-    }
-    if (!my_work.empty()) {
+    IMatchLoopCommunicator::TaggedHits my_results;
+    if (!my_work.empty() && !tools.getDoom().hard_doom()) {
         tools.setup_second_phase(second_phase_profiler.get());
-        DocumentScorer scorer(tools.rank_program(), tools.search());
-        scorer.score(my_work);
+        DocumentScorer scorer(tools.rank_program(), tools.search(), !tools.rank_uses_match_data());
+        // keep claiming chunks of work until all selected hits have been re-ranked by some thread
+        while (!my_work.empty() && !tools.getDoom().hard_doom()) {
+            scorer.score(my_work);
+            my_results.insert(my_results.end(), my_work.begin(), my_work.end());
+            my_work = communicator.get_more_second_phase_work();
+        }
     }
-    thread_stats.docsReRanked(my_work.size());
+    thread_stats.docsReRanked(my_results.size());
     trace->addEvent(5, "Synchronize before rank scaling");
     WaitTimer complete_second_phase_timer(wait_time_s);
-    auto [kept_hits, ranges] = communicator.complete_second_phase(my_work, thread_id);
+    auto [kept_hits, ranges] = communicator.complete_second_phase(std::move(my_results), thread_id);
     complete_second_phase_timer.done();
     hits.setReRankedHits(std::move(kept_hits));
     hits.setRanges(ranges);
@@ -494,6 +530,10 @@ MatchThread::MatchThread(size_t thread_id_in,
         if (int32_t depth = trace->second_phase_profile_depth(); depth != 0) {
             second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(depth);
         }
+    } else if (const auto *sampler = mtf.get_profile_sampler()) {
+        match_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampler->depth());
+        first_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampler->depth());
+        second_phase_profiler = std::make_unique<vespalib::ExecutionProfiler>(sampler->depth());
     }
 }
 
@@ -531,6 +571,31 @@ MatchThread::run()
     trace->addEvent(4, "Start thread merge");
     mergeDirector.dualMerge(thread_id, *resultContext->result, resultContext->groupingSource);
     trace->addEvent(4, "MatchThread::run Done");
+    if (auto *sampler = matchToolsFactory.get_profile_sampler()) {
+        add_profiles_to(*sampler);
+    } else {
+        report_profiles();
+    }
+}
+
+void
+MatchThread::add_profiles_to(QueryProfileSampler &sampler) const
+{
+    auto describe = [](const std::string &name){ return BlueprintResolver::describe_feature(name); };
+    if (match_profiler) {
+        sampler.add("match", *match_profiler);
+    }
+    if (first_phase_profiler) {
+        sampler.add("first_phase", *first_phase_profiler, describe);
+    }
+    if (second_phase_profiler) {
+        sampler.add("second_phase", *second_phase_profiler, describe);
+    }
+}
+
+void
+MatchThread::report_profiles()
+{
     if (match_profiler) {
         match_profiler->report(trace->createCursor("match_profiling"));
     }
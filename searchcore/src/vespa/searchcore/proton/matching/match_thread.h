@@ -29,6 +29,7 @@ namespace proton::matching {
 
 class MatchTools;
 class MatchToolsFactory;
+class QueryProfileSampler;
 
 /**
  * Runs a single match thread and keeps track of local state.
@@ -77,6 +78,21 @@ private:
                 uint32_t num_threads) __attribute__((noinline));
         template <RankDropLimitE use_rank_drop_limit>
         void rankHit(uint32_t docId);
+        /*
+         * When ranking does not depend on unpacked match data, matched
+         * documents are ranked in blocks, allowing feature executors to
+         * calculate values for many documents at a time.
+         */
+        bool rank_in_batches() const noexcept { return _rank_in_batches; }
+        template <RankDropLimitE use_rank_drop_limit>
+        void add_to_batch(uint32_t docId) {
+            _batch_docids.push_back(docId);
+            if (_batch_docids.size() == rank_batch_size) {
+                rank_batch<use_rank_drop_limit>();
+            }
+        }
+        template <RankDropLimitE use_rank_drop_limit>
+        void rank_batch();
         void addHit(uint32_t docId) { _hits.addHit(docId, search::zero_rank_value); }
         bool isBelowLimit() const { return matches < _matches_limit; }
         bool    isAtLimit() const { return matches == _matches_limit; }
@@ -84,11 +100,17 @@ private:
         vespalib::duration timeLeft() const { return _doom.soft_left(); }
         uint32_t        matches;
     private:
+        static constexpr size_t rank_batch_size = 128;
+        template <RankDropLimitE use_rank_drop_limit>
+        void add_ranked_hit(uint32_t docId, double score);
         uint32_t        _matches_limit;
         LazyValue       _score_feature;
         double          _first_phase_rank_score_drop_limit;
         HitCollector   &_hits;
         const Doom      _doom;
+        bool                  _rank_in_batches;
+        std::vector<uint32_t> _batch_docids;
+        std::vector<double>   _batch_scores;
     public:
         std::vector<uint32_t> dropped;
     };
@@ -97,6 +119,8 @@ private:
     SearchIterator *maybe_limit(MatchTools &tools, uint32_t matches, uint32_t docId, uint32_t endId) __attribute__((noinline));
 
     bool any_idle() const { return (idle_observer.get() > 0); }
+    void add_profiles_to(QueryProfileSampler &sampler) const;
+    void report_profiles();
     bool try_share(DocidRange &docid_range, uint32_t next_docid) __attribute__((noinline));
 
     template <typename Strategy, bool do_rank, bool do_limit, bool do_share_work, RankDropLimitE use_rank_drop_limit>
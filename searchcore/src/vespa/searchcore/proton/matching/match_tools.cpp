@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "match_tools.h"
+#include "global_filter_cache.h"
 #include "querynodes.h"
 #include "rangequerylocator.h"
 #include <vespa/searchcorespi/index/indexsearchable.h>
@@ -89,6 +90,7 @@ MatchTools::setup(std::unique_ptr<RankProgram> rank_program, ExecutionProfiler *
         HandleRecorder::Binder bind(recorder);
         _rank_program->setup(*_match_data, _queryEnv, _featureOverrides, profiler);
     }
+    _rank_uses_match_data = !recorder.get_handles().empty();
     bool can_reuse_search = (allow_reuse_search() &&
                              _search && !_search_has_changed &&
                              contains_all(_used_handles, recorder.get_handles()));
@@ -120,7 +122,8 @@ MatchTools::MatchTools(QueryLimiter & queryLimiter,
       _rank_program(),
       _search(),
       _used_handles(),
-      _search_has_changed(false)
+      _search_has_changed(false),
+      _rank_uses_match_data(true)
 {
 }
 
@@ -181,7 +184,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
                   vespalib::ThreadBundle     & thread_bundle,
                   const search::IDocumentMetaStoreContext::IReadGuard::SP * metaStoreReadGuard,
                   uint32_t                     maxNumHits,
-                  bool                         is_search)
+                  bool                         is_search,
+                  GlobalFilterCache          * global_filter_cache)
     : _queryLimiter(queryLimiter),
       _create_blueprint_params(extract_create_blueprint_params(rankSetup, rankProperties, metaStore.getNumActiveLids(), searchContext.getDocIdLimit())),
       _query(),
@@ -195,7 +199,8 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
       _diversityParams(),
       _valid(false),
       _first_phase_rank_lookup(nullptr),
-      _metaStore(metaStore)
+      _metaStore(metaStore),
+      _profile_sampler(nullptr)
 {
     if (doom.soft_doom()) return;
     auto trace = root_trace.make_trace();
@@ -219,9 +224,18 @@ MatchToolsFactory(QueryLimiter               & queryLimiter,
         trace.addEvent(4, "Perform dictionary lookups and posting lists initialization");
         _query.fetchPostings(ExecuteInfo::create(in_flow.rate(), _requestContext.getDoom(), thread_bundle));
         if (is_search) {
+            std::string global_filter_cache_key;
+            if (global_filter_cache != nullptr) {
+                global_filter_cache_key = GlobalFilterCache::make_key(queryStack, location,
+                                                                      _create_blueprint_params, sort_by_cost,
+                                                                      searchContext.getVisibilityGeneration(),
+                                                                      metaStore.getCurrentGeneration(),
+                                                                      searchContext.getDocIdLimit());
+            }
             _query.handle_global_filter(_requestContext, searchContext.getDocIdLimit(),
                                         _create_blueprint_params.global_filter_lower_limit,
-                                        _create_blueprint_params.global_filter_upper_limit, trace, sort_by_cost);
+                                        _create_blueprint_params.global_filter_upper_limit, trace, sort_by_cost,
+                                        global_filter_cache, global_filter_cache_key);
         }
         _query.freeze();
         trace.addEvent(5, "Prepare shared state for multi-threaded rank executors");
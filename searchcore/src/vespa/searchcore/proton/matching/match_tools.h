@@ -31,6 +31,9 @@ namespace search::fef {
 
 namespace proton::matching {
 
+class GlobalFilterCache;
+class QueryProfileSampler;
+
 class MatchTools
 {
 private:
@@ -54,6 +57,7 @@ private:
     std::unique_ptr<SearchIterator>  _search;
     HandleRecorder::HandleMap        _used_handles;
     bool                             _search_has_changed;
+    bool                             _rank_uses_match_data;
     void setup(std::unique_ptr<RankProgram>, ExecutionProfiler *profiler, double termwise_limit = 1.0);
 public:
     using UP = std::unique_ptr<MatchTools>;
@@ -72,6 +76,8 @@ public:
     QueryLimiter & getQueryLimiter() { return _queryLimiter; }
     MaybeMatchPhaseLimiter &match_limiter() { return _match_limiter; }
     bool has_second_phase_rank() const;
+    // Does the current rank program read match data unpacked by the search iterator tree?
+    bool rank_uses_match_data() const noexcept { return _rank_uses_match_data; }
     const MatchData &match_data() const { return *_match_data; }
     RankProgram &rank_program() { return *_rank_program; }
     SearchIterator &search() { return *_search; }
@@ -136,6 +142,7 @@ private:
     bool                               _valid;
     FirstPhaseRankLookup*              _first_phase_rank_lookup;
     const search::IDocumentMetaStore & _metaStore;
+    QueryProfileSampler              * _profile_sampler;
 
     std::unique_ptr<AttributeOperationTask>
     createTask(std::string_view attribute, std::string_view operation) const;
@@ -160,7 +167,8 @@ public:
                       vespalib::ThreadBundle &thread_bundle,
                       const search::IDocumentMetaStoreContext::IReadGuard::SP * metaStoreReadGuard,
                       uint32_t maxNumHits,
-                      bool is_search);
+                      bool is_search,
+                      GlobalFilterCache *global_filter_cache = nullptr);
     ~MatchToolsFactory();
     bool valid() const { return _valid; }
     const MaybeMatchPhaseLimiter &match_limiter() const { return *_match_limiter; }
@@ -193,6 +201,9 @@ public:
                                     uint32_t active_docids, uint32_t docid_limit);
     FirstPhaseRankLookup* get_first_phase_rank_lookup() const noexcept { return _first_phase_rank_lookup; }
     const search::IDocumentMetaStore & metaStore() const noexcept { return _metaStore; }
+    // set while matching a query that should be profiled for the sampler
+    void set_profile_sampler(QueryProfileSampler *sampler) noexcept { _profile_sampler = sampler; }
+    QueryProfileSampler *get_profile_sampler() const noexcept { return _profile_sampler; }
     FieldIdToNameMapper getFieldIdToNameMapper() const {
         return FieldIdToNameMapper(_queryEnv.getIndexEnvironment());
     }
@@ -1,11 +1,14 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "matcher.h"
+#include "global_filter_cache.h"
 #include "isearchcontext.h"
 #include "match_master.h"
 #include "match_context.h"
 #include "match_tools.h"
 #include "match_params.h"
+#include "query_profile_sampler.h"
+#include "query_result_cache.h"
 #include "sessionmanager.h"
 #include <vespa/searchcore/grouping/groupingcontext.h>
 #include <vespa/searchcore/proton/bucketdb/bucket_db_owner.h>
@@ -53,6 +56,7 @@ namespace proton::matching {
 namespace {
 
 constexpr vespalib::duration TIME_BEFORE_ALLOWING_SOFT_TIMEOUT_FACTOR_ADJUSTMENT = 60s;
+constexpr size_t MAX_SAMPLED_PROFILE_STACKS = 10000;
 
 // used to give out empty whitelist blueprints
 struct StupidMetaStore : search::IDocumentMetaStore {
@@ -117,7 +121,12 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
     _startTime(my_clock::now()),
     _now_ref(now_ref),
     _queryLimiter(queryLimiter),
-    _distributionKey(distributionKey)
+    _distributionKey(distributionKey),
+    _resultCache(),
+    _profileSampler(),
+    _globalFilterCache(),
+    _globalFilterCacheHits(0),
+    _globalFilterCacheMisses(0)
 {
     search::features::setup_search_features(_blueprintFactory);
     search::fef::test::setup_fef_test_plugin(_blueprintFactory);
@@ -127,6 +136,21 @@ Matcher::Matcher(const search::index::Schema &schema, Properties props, const st
         throw vespalib::IllegalArgumentException(fmt("failed to compile rank setup :\n%s",
                                                      _rankSetup->getJoinedWarnings().c_str()), VESPA_STRLOC);
     }
+    uint32_t resultCacheMaxBytes = ResultCacheMaxBytes::lookup(_indexEnv.getProperties());
+    if (resultCacheMaxBytes > 0) {
+        _resultCache = std::make_unique<QueryResultCache>(resultCacheMaxBytes);
+    }
+    uint32_t profileSampleInterval = ProfileSampleInterval::lookup(_indexEnv.getProperties());
+    if (profileSampleInterval > 0) {
+        _profileSampler = std::make_unique<QueryProfileSampler>(profileSampleInterval,
+                                                                ProfileSampleDepth::lookup(_indexEnv.getProperties()),
+                                                                MAX_SAMPLED_PROFILE_STACKS);
+    }
+    uint32_t globalFilterCacheMaxBytes = GlobalFilterCacheMaxBytes::lookup(_indexEnv.getProperties());
+    if (globalFilterCacheMaxBytes > 0) {
+        auto maxAge = vespalib::from_s(GlobalFilterCacheMaxAge::lookup(_indexEnv.getProperties()));
+        _globalFilterCache = std::make_unique<GlobalFilterCache>(globalFilterCacheMaxBytes, maxAge, _now_ref);
+    }
 }
 
 Matcher::~Matcher() = default;
@@ -137,6 +161,20 @@ Matcher::getStats()
     std::lock_guard<std::mutex> guard(_statsLock);
     MatchingStats stats = std::move(_stats);
     _stats = MatchingStats(stats.softDoomFactor());
+    if (_resultCache) {
+        auto cache_stats = _resultCache->get_stats();
+        stats.result_cache_entries(cache_stats.entries);
+        stats.result_cache_memory_usage(cache_stats.memory_usage);
+    }
+    if (_globalFilterCache) {
+        auto cache_stats = _globalFilterCache->get_stats();
+        stats.global_filter_cache_hits(cache_stats.hits - _globalFilterCacheHits);
+        stats.global_filter_cache_misses(cache_stats.misses - _globalFilterCacheMisses);
+        stats.global_filter_cache_entries(cache_stats.entries);
+        stats.global_filter_cache_memory_usage(cache_stats.memory_usage);
+        _globalFilterCacheHits = cache_stats.hits;
+        _globalFilterCacheMisses = cache_stats.misses;
+    }
     return stats;
 }
 
@@ -166,7 +204,8 @@ Matcher::create_match_tools_factory(const search::engine::Request &request, ISea
                                                request.trace(), request.getStackRef(), request.location,
                                                _viewResolver, metaStore, _indexEnv, *_rankSetup,
                                                rankProperties, feature_overrides, thread_bundle,
-                                               metaStoreReadGuard, maxHits, is_search);
+                                               metaStoreReadGuard, maxHits, is_search,
+                                               is_search ? _globalFilterCache.get() : nullptr);
 }
 
 size_t
@@ -246,6 +285,20 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
     SearchReply::UP reply = std::make_unique<SearchReply>();
     initCoverage(reply->coverage, metaStore, bucketdb);
 
+    std::string resultCacheKey;
+    if (_resultCache && QueryResultCache::can_cache(request)) {
+        resultCacheKey = QueryResultCache::make_key(request, searchContext.getVisibilityGeneration(),
+                                                    metaStore.getCurrentGeneration(), searchContext.getDocIdLimit());
+        auto cached = _resultCache->lookup(resultCacheKey);
+        if (cached) {
+            // Answered queries are counted the same way with or without the cache
+            my_stats.queries(1);
+            my_stats.queryLatency(vespalib::to_s(total_matching_time.elapsed()));
+            my_stats.result_cache_hits(1);
+            updateStats(my_stats, request, cached->coverage, false);
+            return cached;
+        }
+    }
     bool isDoomExplicit = false;
     { // we want to measure full set-up and tear-down time as part of
       // collateral time
@@ -315,11 +368,21 @@ Matcher::match(const SearchRequest &request, vespalib::ThreadBundle &threadBundl
         if (limitedThreadBundle.size() > 1) {
             attrContext.enableMultiThreadSafe();
         }
+        if (_profileSampler && (request.trace().getLevel() == 0) && _profileSampler->sample()) {
+            mtf->set_profile_sampler(_profileSampler.get());
+        }
         ResultProcessor::Result::UP result = master.match(request.trace(), params, limitedThreadBundle, *mtf, rp,
                                                           _distributionKey, numParts);
+        mtf->set_profile_sampler(nullptr);
         my_stats = MatchMaster::getStats(std::move(master));
         reply = std::move(result->_reply);
         updateCoverage(reply->coverage, mtf->match_limiter(), my_stats, metaStore, bucketdb);
+        if (!resultCacheKey.empty()) {
+            my_stats.result_cache_misses(1);
+            if (!my_stats.softDoomed() && !reply->coverage.wasDegradedByTimeout()) {
+                _resultCache->insert(resultCacheKey, *reply);
+            }
+        }
 
         LOG(debug, "numThreadsPerSearch = %zu. Configured = %d, estimated hits=%d, totalHits=%" PRIu64 ", rankprofile=%s",
             numThreadsPerSearch, _rankSetup->getNumThreadsPerSearch(), mtf->estimate().estHits, reply->totalHitCount,
@@ -41,6 +41,9 @@ namespace proton::matching {
 class ISearchContext;
 class SessionManager;
 class MatchToolsFactory;
+class GlobalFilterCache;
+class QueryProfileSampler;
+class QueryResultCache;
 
 /**
  * The Matcher is responsible for performing searches.
@@ -59,16 +62,21 @@ private:
     using MatchingElements = search::MatchingElements;
     using MatchingElementsFields = search::MatchingElementsFields;
     using steady_time = vespalib::steady_time;
-    IndexEnvironment                _indexEnv;
-    search::fef::BlueprintFactory   _blueprintFactory;
-    std::shared_ptr<RankSetup>      _rankSetup;
-    ViewResolver                    _viewResolver;
-    std::mutex                      _statsLock;
-    MatchingStats                   _stats;
-    my_clock::time_point            _startTime;
-    const std::atomic<steady_time> &_now_ref;
-    QueryLimiter                   &_queryLimiter;
-    uint32_t                        _distributionKey;
+    IndexEnvironment                   _indexEnv;
+    search::fef::BlueprintFactory      _blueprintFactory;
+    std::shared_ptr<RankSetup>         _rankSetup;
+    ViewResolver                       _viewResolver;
+    std::mutex                         _statsLock;
+    MatchingStats                      _stats;
+    my_clock::time_point               _startTime;
+    const std::atomic<steady_time>    &_now_ref;
+    QueryLimiter                      &_queryLimiter;
+    uint32_t                           _distributionKey;
+    std::unique_ptr<QueryResultCache>  _resultCache;
+    std::unique_ptr<QueryProfileSampler> _profileSampler;
+    std::unique_ptr<GlobalFilterCache> _globalFilterCache;
+    size_t                             _globalFilterCacheHits;   // as of last getStats
+    size_t                             _globalFilterCacheMisses; // as of last getStats
 
     size_t computeNumThreadsPerSearch(search::queryeval::Blueprint::HitEstimate hits,
                                       const Properties & rankProperties) const;
@@ -103,6 +111,18 @@ public:
      **/
     MatchingStats getStats();
 
+    /**
+     * @return the sampled query profiles of this rank profile, or
+     *         nullptr if query profile sampling is not enabled
+     **/
+    const QueryProfileSampler *getProfileSampler() const { return _profileSampler.get(); }
+
+    /**
+     * @return the global filters shared between queries of this rank
+     *         profile, or nullptr if global filter caching is not enabled
+     **/
+    const GlobalFilterCache *getGlobalFilterCache() const { return _globalFilterCache.get(); }
+
     /**
      * Create the low-level tools needed to perform matching. This
      * function is exposed for testing purposes.
@@ -22,6 +22,14 @@ constexpr double MAX_CHANGE_FACTOR = 5;
 MatchingStats::MatchingStats(double prev_soft_doom_factor) noexcept
     : _queries(0),
       _limited_queries(0),
+      _result_cache_hits(0),
+      _result_cache_misses(0),
+      _result_cache_entries(0),
+      _result_cache_memory_usage(0),
+      _global_filter_cache_hits(0),
+      _global_filter_cache_misses(0),
+      _global_filter_cache_entries(0),
+      _global_filter_cache_memory_usage(0),
       _docidSpaceCovered(0),
       _docsMatched(0),
       _docsRanked(0),
@@ -61,6 +69,14 @@ MatchingStats::add(const MatchingStats &rhs) noexcept
 {
     _queries += rhs._queries;
     _limited_queries += rhs._limited_queries;
+    _result_cache_hits += rhs._result_cache_hits;
+    _result_cache_misses += rhs._result_cache_misses;
+    _result_cache_entries += rhs._result_cache_entries;
+    _result_cache_memory_usage += rhs._result_cache_memory_usage;
+    _global_filter_cache_hits += rhs._global_filter_cache_hits;
+    _global_filter_cache_misses += rhs._global_filter_cache_misses;
+    _global_filter_cache_entries += rhs._global_filter_cache_entries;
+    _global_filter_cache_memory_usage += rhs._global_filter_cache_memory_usage;
 
     _docidSpaceCovered += rhs._docidSpaceCovered;
     _docsMatched += rhs._docsMatched;
@@ -119,6 +119,14 @@ public:
 private:
     size_t                 _queries;
     size_t                 _limited_queries;
+    size_t                 _result_cache_hits;
+    size_t                 _result_cache_misses;
+    size_t                 _result_cache_entries;
+    size_t                 _result_cache_memory_usage;
+    size_t                 _global_filter_cache_hits;
+    size_t                 _global_filter_cache_misses;
+    size_t                 _global_filter_cache_entries;
+    size_t                 _global_filter_cache_memory_usage;
     size_t                 _docidSpaceCovered;
     size_t                 _docsMatched;
     size_t                 _docsRanked;
@@ -150,6 +158,32 @@ public:
     MatchingStats &limited_queries(size_t value) { _limited_queries = value; return *this; }
     size_t limited_queries() const { return _limited_queries; }
 
+    MatchingStats &result_cache_hits(size_t value) { _result_cache_hits = value; return *this; }
+    size_t result_cache_hits() const { return _result_cache_hits; }
+
+    MatchingStats &result_cache_misses(size_t value) { _result_cache_misses = value; return *this; }
+    size_t result_cache_misses() const { return _result_cache_misses; }
+
+    // current size of the result cache, set when sampled
+    MatchingStats &result_cache_entries(size_t value) { _result_cache_entries = value; return *this; }
+    size_t result_cache_entries() const { return _result_cache_entries; }
+
+    MatchingStats &result_cache_memory_usage(size_t value) { _result_cache_memory_usage = value; return *this; }
+    size_t result_cache_memory_usage() const { return _result_cache_memory_usage; }
+
+    MatchingStats &global_filter_cache_hits(size_t value) { _global_filter_cache_hits = value; return *this; }
+    size_t global_filter_cache_hits() const { return _global_filter_cache_hits; }
+
+    MatchingStats &global_filter_cache_misses(size_t value) { _global_filter_cache_misses = value; return *this; }
+    size_t global_filter_cache_misses() const { return _global_filter_cache_misses; }
+
+    // current size of the global filter cache, set when sampled
+    MatchingStats &global_filter_cache_entries(size_t value) { _global_filter_cache_entries = value; return *this; }
+    size_t global_filter_cache_entries() const { return _global_filter_cache_entries; }
+
+    MatchingStats &global_filter_cache_memory_usage(size_t value) { _global_filter_cache_memory_usage = value; return *this; }
+    size_t global_filter_cache_memory_usage() const { return _global_filter_cache_memory_usage; }
+
     MatchingStats &docidSpaceCovered(size_t value) { _docidSpaceCovered = value; return *this; }
     size_t docidSpaceCovered() const { return _docidSpaceCovered; }
 
@@ -2,6 +2,7 @@
 
 #include "query.h"
 #include "blueprintbuilder.h"
+#include "global_filter_cache.h"
 #include "matchdatareservevisitor.h"
 #include "resolveviewvisitor.h"
 #include "sameelementmodifier.h"
@@ -246,10 +247,11 @@ Query::fetchPostings(const ExecuteInfo & executeInfo)
 void
 Query::handle_global_filter(const IRequestContext & requestContext, uint32_t docid_limit,
                             double global_filter_lower_limit, double global_filter_upper_limit,
-                            search::engine::Trace& trace, bool sort_by_cost)
+                            search::engine::Trace& trace, bool sort_by_cost,
+                            GlobalFilterCache *cache, const std::string &cache_key)
 {
     if (!handle_global_filter(*_blueprint, docid_limit, global_filter_lower_limit, global_filter_upper_limit,
-                              requestContext.thread_bundle(), &trace))
+                              requestContext.thread_bundle(), &trace, cache, cache_key))
     {
         return;
     }
@@ -265,7 +267,8 @@ Query::handle_global_filter(const IRequestContext & requestContext, uint32_t doc
 bool
 Query::handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
                             double global_filter_lower_limit, double global_filter_upper_limit,
-                            vespalib::ThreadBundle &thread_bundle, search::engine::Trace* trace)
+                            vespalib::ThreadBundle &thread_bundle, search::engine::Trace* trace,
+                            GlobalFilterCache *cache, const std::string &cache_key)
 {
     using search::queryeval::GlobalFilter;
     double estimated_hit_ratio = blueprint.getState().hit_ratio(docid_limit);
@@ -281,13 +284,25 @@ Query::handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
         return false;
     }
 
-    std::shared_ptr<GlobalFilter> global_filter;
+    std::shared_ptr<const GlobalFilter> global_filter;
     if (estimated_hit_ratio <= global_filter_upper_limit) {
-        if (trace && trace->shouldTrace(5)) {
-            trace->addEvent(5, vespalib::make_string("Calculate global filter (estimated_hit_ratio (%f) <= upper_limit (%f))",
+        auto create = [&]() {
+            if (trace && trace->shouldTrace(5)) {
+                trace->addEvent(5, vespalib::make_string("Calculate global filter (estimated_hit_ratio (%f) <= upper_limit (%f))",
+                                                         estimated_hit_ratio, global_filter_upper_limit));
+            }
+            return GlobalFilter::create(blueprint, docid_limit, thread_bundle, trace);
+        };
+        bool cached = false;
+        if (cache != nullptr) {
+            global_filter = cache->lookup_or_create(cache_key, create, cached);
+        } else {
+            global_filter = create();
+        }
+        if (cached && trace && trace->shouldTrace(5)) {
+            trace->addEvent(5, vespalib::make_string("Reuse cached global filter (estimated_hit_ratio (%f) <= upper_limit (%f))",
                                                      estimated_hit_ratio, global_filter_upper_limit));
         }
-        global_filter = GlobalFilter::create(blueprint, docid_limit, thread_bundle, trace);
         if (!global_filter->is_active()) {
             estimated_hit_ratio = 1.0;
             if (trace && trace->shouldTrace(5)) {
@@ -15,6 +15,7 @@ namespace search::engine { class Trace; }
 
 namespace proton::matching {
 
+class GlobalFilterCache;
 class ViewResolver;
 class ISearchContext;
 
@@ -105,7 +106,8 @@ public:
 
     void handle_global_filter(const IRequestContext & requestContext, uint32_t docid_limit,
                               double global_filter_lower_limit, double global_filter_upper_limit,
-                              search::engine::Trace& trace, bool sort_by_cost);
+                              search::engine::Trace& trace, bool sort_by_cost,
+                              GlobalFilterCache *cache = nullptr, const std::string &cache_key = {});
 
     /**
      * Calculates and handles the global filter if needed by the blueprint tree.
@@ -118,11 +120,15 @@ public:
      * 3) estimated_hit_ratio > global_filter_upper_limit:
      *     Set a "match all filter" on the blueprint.
      *
+     * If a cache is given, a global filter calculated for an earlier
+     * query with the same cache key is used instead of calculating it.
+     *
      * @return whether the global filter was set on the blueprint.
      */
     static bool handle_global_filter(Blueprint& blueprint, uint32_t docid_limit,
                                      double global_filter_lower_limit, double global_filter_upper_limit,
-                                     vespalib::ThreadBundle &thread_bundle, search::engine::Trace* trace);
+                                     vespalib::ThreadBundle &thread_bundle, search::engine::Trace* trace,
+                                     GlobalFilterCache *cache = nullptr, const std::string &cache_key = {});
 
     void freeze();
     void set_matching_phase(search::queryeval::MatchingPhase matching_phase) const noexcept;
@@ -0,0 +1,110 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_profile_sampler.h"
+#include <vespa/vespalib/util/stringfmt.h>
+#include <algorithm>
+
+namespace proton::matching {
+
+namespace {
+
+// ';' separates frames and the last space separates the sample value in folded stacks
+void append_frame(std::string &stack, const std::string &name) {
+    if (!stack.empty()) {
+        stack.push_back(';');
+    }
+    size_t pos = stack.size();
+    stack.append(name);
+    std::replace(stack.begin() + pos, stack.end(), ';', ',');
+    std::replace(stack.begin() + pos, stack.end(), '\n', ' ');
+}
+
+}
+
+QueryProfileSampler::QueryProfileSampler(uint32_t interval, int32_t depth, size_t max_stacks)
+    : _interval(interval),
+      _depth(depth),
+      _max_stacks(max_stacks),
+      _queries(0),
+      _samples(0),
+      _lock(),
+      _stacks(),
+      _dropped(0)
+{
+}
+
+QueryProfileSampler::~QueryProfileSampler() = default;
+
+bool
+QueryProfileSampler::sample() noexcept
+{
+    size_t query = _queries.fetch_add(1, std::memory_order_relaxed);
+    if ((_interval == 0) || ((query % _interval) != 0)) {
+        return false;
+    }
+    _samples.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void
+QueryProfileSampler::add(const std::string &phase, const ExecutionProfiler &profiler,
+                         const ExecutionProfiler::NameMapper &name_mapper)
+{
+    std::vector<std::pair<std::string, vespalib::duration>> stacks;
+    profiler.visit_stacks([&](const std::vector<std::string> &frames, size_t, vespalib::duration self_time)
+                          {
+                              std::string stack;
+                              append_frame(stack, phase);
+                              for (const auto &frame: frames) {
+                                  append_frame(stack, frame);
+                              }
+                              stacks.emplace_back(std::move(stack), self_time);
+                          }, name_mapper);
+    std::lock_guard guard(_lock);
+    for (auto &[stack, self_time]: stacks) {
+        auto pos = _stacks.find(stack);
+        if (pos == _stacks.end()) {
+            if (_stacks.size() >= _max_stacks) {
+                ++_dropped;
+                continue;
+            }
+            pos = _stacks.emplace(std::move(stack), vespalib::duration::zero()).first;
+        }
+        pos->second += self_time;
+    }
+}
+
+std::vector<std::string>
+QueryProfileSampler::folded_stacks() const
+{
+    std::vector<std::string> result;
+    std::lock_guard guard(_lock);
+    result.reserve(_stacks.size());
+    for (const auto &[stack, self_time]: _stacks) {
+        result.push_back(vespalib::make_string("%s %" PRId64, stack.c_str(), vespalib::count_us(self_time)));
+    }
+    return result;
+}
+
+QueryProfileSampler::Stats
+QueryProfileSampler::get_stats() const
+{
+    Stats stats;
+    stats.queries = _queries.load(std::memory_order_relaxed);
+    stats.samples = _samples.load(std::memory_order_relaxed);
+    std::lock_guard guard(_lock);
+    stats.stacks = _stacks.size();
+    stats.dropped = _dropped;
+    return stats;
+}
+
+void
+QueryProfileSampler::clear()
+{
+    std::lock_guard guard(_lock);
+    _stacks.clear();
+    _samples.store(0, std::memory_order_relaxed);
+    _dropped = 0;
+}
+
+}
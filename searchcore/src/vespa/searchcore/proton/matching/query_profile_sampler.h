@@ -0,0 +1,69 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/execution_profiler.h>
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace proton::matching {
+
+/**
+ * Profiles one in every N queries run by a matcher and merges the
+ * profiles of all sampled queries into a single call tree. The tree
+ * is kept as folded stacks ('root;child;grandchild'), keyed on the
+ * match phase that produced them, and can be rendered in the folded
+ * stack format used by flame graph tools, with self time in
+ * microseconds as the sample value.
+ *
+ * The number of distinct stacks is bounded; time spent in stacks
+ * seen after the limit is reached is dropped and counted.
+ *
+ * Thread safe.
+ **/
+class QueryProfileSampler
+{
+public:
+    using ExecutionProfiler = vespalib::ExecutionProfiler;
+
+    struct Stats {
+        size_t queries;
+        size_t samples;
+        size_t stacks;
+        size_t dropped;
+        Stats() noexcept : queries(0), samples(0), stacks(0), dropped(0) {}
+    };
+
+private:
+    const uint32_t                            _interval;
+    const int32_t                             _depth;
+    const size_t                              _max_stacks;
+    std::atomic<size_t>                       _queries;
+    std::atomic<size_t>                       _samples; // sampled queries, not profiles added
+    mutable std::mutex                        _lock;
+    std::map<std::string, vespalib::duration> _stacks; // self time per stack
+    size_t                                    _dropped;
+
+public:
+    QueryProfileSampler(uint32_t interval, int32_t depth, size_t max_stacks);
+    ~QueryProfileSampler();
+
+    uint32_t interval() const noexcept { return _interval; }
+    // profile depth used for sampled queries, as given to the execution profiler
+    int32_t depth() const noexcept { return _depth; }
+
+    // returns true if the next query should be profiled
+    bool sample() noexcept;
+    void add(const std::string &phase, const ExecutionProfiler &profiler,
+             const ExecutionProfiler::NameMapper &name_mapper =
+             [](const std::string &name) noexcept { return name; });
+    // one 'phase;task;...;task self_time_us' line per stack, in stack order
+    std::vector<std::string> folded_stacks() const;
+    Stats get_stats() const;
+    void clear();
+};
+
+}
@@ -0,0 +1,205 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "query_result_cache.h"
+#include <vespa/searchlib/common/mapnames.h>
+#include <vespa/searchlib/engine/searchreply.h>
+#include <vespa/searchlib/engine/searchrequest.h>
+#include <vespa/vespalib/stllike/lrucache_map.hpp>
+#include <algorithm>
+#include <vector>
+
+using search::MapNames;
+using search::engine::SearchReply;
+using search::engine::SearchRequest;
+using search::fef::IPropertiesVisitor;
+using search::fef::Properties;
+using search::fef::Property;
+
+namespace proton::matching {
+
+namespace {
+
+struct Entry {
+    std::shared_ptr<const SearchReply> reply;
+    size_t                             bytes;
+    Entry() noexcept : reply(), bytes(0) {}
+    Entry(std::shared_ptr<const SearchReply> reply_in, size_t bytes_in) noexcept
+        : reply(std::move(reply_in)), bytes(bytes_in) {}
+};
+
+using LruParam = vespalib::LruParam<std::string, Entry>;
+
+class KeyBuilder {
+    std::string _key;
+public:
+    void add(uint64_t value) {
+        _key.append(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+    void add(std::string_view value) {
+        add(value.size());
+        _key.append(value);
+    }
+    std::string steal() { return std::move(_key); }
+};
+
+// Collects all key/value pairs in sorted order, since the iteration
+// order of a property map depends on how it was built.
+struct SortedProperties : IPropertiesVisitor {
+    std::vector<std::pair<std::string, std::vector<std::string>>> entries;
+    void visitProperty(const Property::Value &key, const Property &values) override {
+        std::vector<std::string> list;
+        for (uint32_t i = 0; i < values.size(); ++i) {
+            list.push_back(values.getAt(i));
+        }
+        entries.emplace_back(key, std::move(list));
+    }
+    void add_to(KeyBuilder &key) {
+        std::sort(entries.begin(), entries.end());
+        key.add(entries.size());
+        for (const auto &entry: entries) {
+            key.add(entry.first);
+            key.add(entry.second.size());
+            for (const auto &value: entry.second) {
+                key.add(value);
+            }
+        }
+    }
+};
+
+bool affects_result(const std::string &name) {
+    return ((name != MapNames::CACHES) && (name != MapNames::TRACE) && (name != MapNames::HIGHLIGHTTERMS));
+}
+
+size_t estimate_bytes(const std::string &key, const SearchReply &reply) {
+    size_t bytes = sizeof(Entry) + sizeof(SearchReply) + key.size();
+    bytes += reply.hits.size() * sizeof(SearchReply::Hit);
+    bytes += reply.sortIndex.size() * sizeof(uint32_t);
+    bytes += reply.sortData.size();
+    bytes += reply.groupResult.size();
+    for (const auto &name: reply.match_features.names) {
+        bytes += sizeof(name) + name.size();
+    }
+    for (const auto &value: reply.match_features.values) {
+        bytes += sizeof(value) + (value.is_data() ? value.as_data().size : 0);
+    }
+    return bytes;
+}
+
+}
+
+struct QueryResultLruCache : vespalib::lrucache_map<LruParam> {
+    size_t _max_bytes;
+    size_t _memory_usage;
+    size_t _evictions;
+    explicit QueryResultLruCache(size_t max_bytes)
+        : lrucache_map(UNLIMITED), _max_bytes(max_bytes), _memory_usage(0), _evictions(0) {}
+    bool removeOldest(const LruParam::value_type &v) override {
+        if (_memory_usage > _max_bytes) {
+            _memory_usage -= v.second._value.bytes;
+            ++_evictions;
+            return true;
+        }
+        return false;
+    }
+};
+
+QueryResultCache::QueryResultCache(size_t max_bytes)
+    : _lock(),
+      _cache(std::make_unique<QueryResultLruCache>(max_bytes)),
+      _stats()
+{
+}
+
+QueryResultCache::~QueryResultCache() = default;
+
+bool
+QueryResultCache::can_cache(const SearchRequest &request)
+{
+    if (request.trace().getLevel() > 0 || request.dumpFeatures) {
+        return false;
+    }
+    const Properties &cache_props = request.propertiesMap.cacheProperties();
+    if (cache_props.lookup("query").found() || cache_props.lookup("grouping").found()) {
+        return false;
+    }
+    // multi-pass grouping keeps a session between passes
+    return (request.sessionId.empty() || request.groupSpec.empty());
+}
+
+std::string
+QueryResultCache::make_key(const SearchRequest &request, uint64_t visibility_generation,
+                           uint64_t meta_store_generation, uint32_t docid_limit)
+{
+    KeyBuilder key;
+    key.add(visibility_generation);
+    key.add(meta_store_generation);
+    key.add(docid_limit);
+    key.add(request.ranking);
+    key.add(request.location);
+    key.add(request.getStackRef());
+    key.add(request.sortSpec);
+    key.add(std::string_view(request.groupSpec.data(), request.groupSpec.size()));
+    key.add(request.offset);
+    key.add(request.maxhits);
+    std::vector<std::pair<std::string_view, const Properties *>> maps;
+    for (const auto &entry: request.propertiesMap) {
+        if (affects_result(entry.first) && (entry.second.numKeys() > 0)) {
+            maps.emplace_back(entry.first, &entry.second);
+        }
+    }
+    std::sort(maps.begin(), maps.end());
+    for (const auto &[name, map]: maps) {
+        key.add(name);
+        SortedProperties props;
+        map->visitProperties(props);
+        props.add_to(key);
+    }
+    return key.steal();
+}
+
+std::unique_ptr<SearchReply>
+QueryResultCache::lookup(const std::string &key)
+{
+    std::shared_ptr<const SearchReply> reply;
+    {
+        std::lock_guard guard(_lock);
+        auto *entry = _cache->find_and_ref(key);
+        if (entry == nullptr) {
+            ++_stats.misses;
+            return {};
+        }
+        ++_stats.hits;
+        reply = entry->reply;
+    }
+    return std::make_unique<SearchReply>(*reply);
+}
+
+void
+QueryResultCache::insert(const std::string &key, const SearchReply &reply)
+{
+    size_t bytes = estimate_bytes(key, reply);
+    if (bytes > _cache->_max_bytes) {
+        return;
+    }
+    auto copy = std::make_shared<const SearchReply>(reply);
+    std::lock_guard guard(_lock);
+    if (_cache->hasKey(key)) {
+        return;
+    }
+    _cache->_memory_usage += bytes;
+    _cache->insert(key, Entry(std::move(copy), bytes));
+    ++_stats.inserts;
+}
+
+QueryResultCache::Stats
+QueryResultCache::get_stats() const
+{
+    std::lock_guard guard(_lock);
+    Stats stats = _stats;
+    stats.evictions = _cache->_evictions;
+    stats.entries = _cache->size();
+    stats.memory_usage = _cache->_memory_usage;
+    return stats;
+}
+
+}
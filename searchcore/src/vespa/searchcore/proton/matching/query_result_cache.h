@@ -0,0 +1,67 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace search::engine {
+    class SearchRequest;
+    class SearchReply;
+}
+
+namespace proton::matching {
+
+struct QueryResultLruCache;
+
+/**
+ * Cache of search replies produced by a matcher. Entries are keyed on
+ * a canonical serialization of everything in a request that may
+ * affect its result, combined with the generations of the searched
+ * data. Entries for data that has since changed will not be hit again
+ * and are evicted in LRU order when the memory limit is reached.
+ *
+ * Thread safe.
+ **/
+class QueryResultCache
+{
+public:
+    using SearchRequest = search::engine::SearchRequest;
+    using SearchReply = search::engine::SearchReply;
+
+    struct Stats {
+        size_t hits;
+        size_t misses;
+        size_t inserts;
+        size_t evictions;
+        size_t entries;
+        size_t memory_usage;
+        Stats() noexcept : hits(0), misses(0), inserts(0), evictions(0), entries(0), memory_usage(0) {}
+    };
+
+private:
+    mutable std::mutex                   _lock;
+    std::unique_ptr<QueryResultLruCache> _cache;
+    Stats                                _stats;
+
+public:
+    explicit QueryResultCache(size_t max_bytes);
+    ~QueryResultCache();
+
+    /**
+     * Requests that are traced, dump features or need state to be
+     * kept between passes (sessions) are never cached.
+     **/
+    static bool can_cache(const SearchRequest &request);
+
+    static std::string make_key(const SearchRequest &request, uint64_t visibility_generation,
+                                uint64_t meta_store_generation, uint32_t docid_limit);
+
+    // returns a copy of the cached reply, or nullptr on a miss
+    std::unique_ptr<SearchReply> lookup(const std::string &key);
+    void insert(const std::string &key, const SearchReply &reply);
+    Stats get_stats() const;
+};
+
+}
@@ -6,7 +6,9 @@ namespace proton {
 
 DocumentDBFeedingMetrics::DocumentDBFeedingMetrics(metrics::MetricSet* parent)
     : MetricSet("feeding", {}, "feeding metrics in a document database", parent),
-      commit(this)
+      commit(this),
+      operation(this),
+      master_task_limit(this)
 {
 }
 
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "document_db_commit_metrics.h"
+#include "document_db_master_task_limit_metrics.h"
+#include "document_db_operation_metrics.h"
 
 namespace proton {
 
@@ -11,6 +13,8 @@ namespace proton {
 struct DocumentDBFeedingMetrics : metrics::MetricSet
 {
     DocumentDBCommitMetrics commit;
+    DocumentDBOperationMetrics operation;
+    DocumentDBMasterTaskLimitMetrics master_task_limit;
 
     DocumentDBFeedingMetrics(metrics::MetricSet* parent);
     ~DocumentDBFeedingMetrics() override;
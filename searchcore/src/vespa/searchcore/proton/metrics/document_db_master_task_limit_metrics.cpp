@@ -0,0 +1,17 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "document_db_master_task_limit_metrics.h"
+
+namespace proton {
+
+DocumentDBMasterTaskLimitMetrics::DocumentDBMasterTaskLimitMetrics(metrics::MetricSet* parent)
+    : MetricSet("master_task_limit", {}, "metrics for the master task limit in a document database", parent),
+      limit("limit", {}, "Maximum number of pending master tasks before feed operations are blocked (0 means no limit)", this),
+      increases("increases", {}, "Number of times the adaptive master task limit has been increased", this),
+      decreases("decreases", {}, "Number of times the adaptive master task limit has been decreased", this)
+{
+}
+
+DocumentDBMasterTaskLimitMetrics::~DocumentDBMasterTaskLimitMetrics() = default;
+
+}
@@ -0,0 +1,23 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/metrics/metricset.h>
+#include <vespa/metrics/countmetric.h>
+#include <vespa/metrics/valuemetric.h>
+
+namespace proton {
+
+/*
+ * Metrics for the (possibly adaptive) master task limit within a document db.
+ */
+struct DocumentDBMasterTaskLimitMetrics : metrics::MetricSet
+{
+    metrics::LongValueMetric limit;
+    metrics::LongCountMetric increases;
+    metrics::LongCountMetric decreases;
+
+    DocumentDBMasterTaskLimitMetrics(metrics::MetricSet* parent);
+    ~DocumentDBMasterTaskLimitMetrics() override;
+};
+
+}
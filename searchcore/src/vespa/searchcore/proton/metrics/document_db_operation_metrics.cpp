@@ -0,0 +1,25 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "document_db_operation_metrics.h"
+
+namespace proton {
+
+DocumentDBOperationMetrics::DocumentDBOperationMetrics(metrics::MetricSet* parent)
+    : MetricSet("operation", {}, "latency metrics for the stages of feed operations in a document database", parent),
+      wait_latency("wait_latency", {}, "Latency for feed operations waiting to be handled in the master thread", this),
+      master_latency("master_latency", {}, "Latency for handling feed operations in the master thread", this),
+      completion_latency("completion_latency", {}, "Latency from feed operations are handled in the master thread until "
+                         "transaction log commit and writes to attributes, memory index and document store are done", this),
+      attributes_latency("attributes_latency", {}, "Latency from feed operations are handled in the master thread until "
+                         "writes to attributes are done", this),
+      memory_index_latency("memory_index_latency", {}, "Latency from feed operations are handled in the master thread until "
+                           "writes to memory index are done", this),
+      document_store_latency("document_store_latency", {}, "Latency from feed operations are handled in the master thread until "
+                             "writes to document store are done", this),
+      latency("latency", {}, "Latency for feed operations from being received until being acked", this)
+{
+}
+
+DocumentDBOperationMetrics::~DocumentDBOperationMetrics() = default;
+
+}
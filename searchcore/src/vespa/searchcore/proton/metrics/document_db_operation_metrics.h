@@ -0,0 +1,26 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/metrics/metricset.h>
+#include <vespa/metrics/valuemetric.h>
+
+namespace proton {
+
+/*
+ * Metrics for latencies of the stages of external feed operations within a document db.
+ */
+struct DocumentDBOperationMetrics : metrics::MetricSet
+{
+    metrics::DoubleAverageMetric wait_latency;
+    metrics::DoubleAverageMetric master_latency;
+    metrics::DoubleAverageMetric completion_latency;
+    metrics::DoubleAverageMetric attributes_latency;
+    metrics::DoubleAverageMetric memory_index_latency;
+    metrics::DoubleAverageMetric document_store_latency;
+    metrics::DoubleAverageMetric latency;
+
+    DocumentDBOperationMetrics(metrics::MetricSet* parent);
+    ~DocumentDBOperationMetrics() override;
+};
+
+}
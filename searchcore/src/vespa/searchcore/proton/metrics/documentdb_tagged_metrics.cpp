@@ -108,6 +108,14 @@ DocumentDBTaggedMetrics::MatchingMetrics::update(const MatchingStats &stats)
     docsRanked.inc(stats.docsRanked());
     docsReRanked.inc(stats.docsReRanked());
     softDoomedQueries.inc(stats.softDoomed());
+    resultCacheHits.inc(stats.result_cache_hits());
+    resultCacheMisses.inc(stats.result_cache_misses());
+    resultCacheEntries.set(stats.result_cache_entries());
+    resultCacheMemoryUsage.set(stats.result_cache_memory_usage());
+    globalFilterCacheHits.inc(stats.global_filter_cache_hits());
+    globalFilterCacheMisses.inc(stats.global_filter_cache_misses());
+    globalFilterCacheEntries.set(stats.global_filter_cache_entries());
+    globalFilterCacheMemoryUsage.set(stats.global_filter_cache_memory_usage());
     queries.inc(stats.queries());
     querySetupTime.addValueBatch(stats.querySetupTimeAvg(), stats.querySetupTimeCount(),
                                       stats.querySetupTimeMin(), stats.querySetupTimeMax());
@@ -122,6 +130,14 @@ DocumentDBTaggedMetrics::MatchingMetrics::MatchingMetrics(MetricSet *parent)
       docsReRanked("docs_reranked", {}, "Number of documents re-ranked (second phase)", this),
       queries("queries", {}, "Number of queries executed", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
+      resultCacheHits("result_cache_hits", {}, "Number of queries answered from the result cache", this),
+      resultCacheMisses("result_cache_misses", {}, "Number of cacheable queries not found in the result cache", this),
+      resultCacheEntries("result_cache_entries", {}, "Number of replies in the result cache", this),
+      resultCacheMemoryUsage("result_cache_memory_usage", {}, "Memory usage (in bytes) of the result cache", this),
+      globalFilterCacheHits("global_filter_cache_hits", {}, "Number of global filters taken from the global filter cache", this),
+      globalFilterCacheMisses("global_filter_cache_misses", {}, "Number of global filters calculated because they were not in the global filter cache", this),
+      globalFilterCacheEntries("global_filter_cache_entries", {}, "Number of global filters in the global filter cache", this),
+      globalFilterCacheMemoryUsage("global_filter_cache_memory_usage", {}, "Memory usage (in bytes) of the global filter cache", this),
       querySetupTime("query_setup_time", {}, "Average time (sec) spent setting up and tearing down queries", this),
       queryLatency("query_latency", {}, "Total average latency (sec) when matching and ranking a query", this)
 {
@@ -139,6 +155,14 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::RankProfileMetrics
       queries("queries", {}, "Number of queries executed", this),
       limitedQueries("limited_queries", {}, "Number of queries limited in match phase", this),
       softDoomedQueries("soft_doomed_queries", {}, "Number of queries hitting the soft timeout", this),
+      resultCacheHits("result_cache_hits", {}, "Number of queries answered from the result cache", this),
+      resultCacheMisses("result_cache_misses", {}, "Number of cacheable queries not found in the result cache", this),
+      resultCacheEntries("result_cache_entries", {}, "Number of replies in the result cache", this),
+      resultCacheMemoryUsage("result_cache_memory_usage", {}, "Memory usage (in bytes) of the result cache", this),
+      globalFilterCacheHits("global_filter_cache_hits", {}, "Number of global filters taken from the global filter cache", this),
+      globalFilterCacheMisses("global_filter_cache_misses", {}, "Number of global filters calculated because they were not in the global filter cache", this),
+      globalFilterCacheEntries("global_filter_cache_entries", {}, "Number of global filters in the global filter cache", this),
+      globalFilterCacheMemoryUsage("global_filter_cache_memory_usage", {}, "Memory usage (in bytes) of the global filter cache", this),
       softDoomFactor("soft_doom_factor", {}, "Factor used to compute soft-timeout", this),
       matchTime("match_time", {}, "Average time (sec) for matching a query (1st phase)", this),
       groupingTime("grouping_time", {}, "Average time (sec) spent on grouping", this),
@@ -188,6 +212,14 @@ DocumentDBTaggedMetrics::MatchingMetrics::RankProfileMetrics::update(const metri
     queries.inc(stats.queries());
     limitedQueries.inc(stats.limited_queries());
     softDoomedQueries.inc(stats.softDoomed());
+    resultCacheHits.inc(stats.result_cache_hits());
+    resultCacheMisses.inc(stats.result_cache_misses());
+    resultCacheEntries.set(stats.result_cache_entries());
+    resultCacheMemoryUsage.set(stats.result_cache_memory_usage());
+    globalFilterCacheHits.inc(stats.global_filter_cache_hits());
+    globalFilterCacheMisses.inc(stats.global_filter_cache_misses());
+    globalFilterCacheEntries.set(stats.global_filter_cache_entries());
+    globalFilterCacheMemoryUsage.set(stats.global_filter_cache_memory_usage());
     softDoomFactor.set(stats.softDoomFactor());
     matchTime.addValueBatch(stats.matchTimeAvg(), stats.matchTimeCount(),
                             stats.matchTimeMin(), stats.matchTimeMax());
@@ -110,6 +110,14 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
         metrics::LongCountMetric docsReRanked;
         metrics::LongCountMetric queries;
         metrics::LongCountMetric softDoomedQueries;
+        metrics::LongCountMetric resultCacheHits;
+        metrics::LongCountMetric resultCacheMisses;
+        metrics::LongValueMetric resultCacheEntries;
+        metrics::LongValueMetric resultCacheMemoryUsage;
+        metrics::LongCountMetric globalFilterCacheHits;
+        metrics::LongCountMetric globalFilterCacheMisses;
+        metrics::LongValueMetric globalFilterCacheEntries;
+        metrics::LongValueMetric globalFilterCacheMemoryUsage;
         metrics::DoubleAverageMetric querySetupTime;
         metrics::DoubleAverageMetric queryLatency;
 
@@ -135,6 +143,14 @@ struct DocumentDBTaggedMetrics : metrics::MetricSet
             metrics::LongCountMetric     queries;
             metrics::LongCountMetric     limitedQueries;
             metrics::LongCountMetric     softDoomedQueries;
+            metrics::LongCountMetric     resultCacheHits;
+            metrics::LongCountMetric     resultCacheMisses;
+            metrics::LongValueMetric     resultCacheEntries;
+            metrics::LongValueMetric     resultCacheMemoryUsage;
+            metrics::LongCountMetric     globalFilterCacheHits;
+            metrics::LongCountMetric     globalFilterCacheMisses;
+            metrics::LongValueMetric     globalFilterCacheEntries;
+            metrics::LongValueMetric     globalFilterCacheMemoryUsage;
             metrics::DoubleValueMetric   softDoomFactor;
             metrics::DoubleAverageMetric matchTime;
             metrics::DoubleAverageMetric groupingTime;
@@ -0,0 +1,122 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "adaptive_master_task_limit.h"
+#include "feed_handler_stats.h"
+#include <vespa/searchcore/proton/metrics/executor_threading_service_stats.h>
+#include <algorithm>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".proton.server.adaptive_master_task_limit");
+
+namespace proton {
+
+AdaptiveMasterTaskLimitConfig::AdaptiveMasterTaskLimitConfig() noexcept
+    : AdaptiveMasterTaskLimitConfig(false, 16, 1024, 0.1, 0.9)
+{
+}
+
+AdaptiveMasterTaskLimitConfig::AdaptiveMasterTaskLimitConfig(bool enabled, uint32_t min_limit, uint32_t max_limit,
+                                                             double target_latency, double max_saturation) noexcept
+    : _enabled(enabled),
+      _min_limit(std::max(1u, min_limit)),
+      _max_limit(std::max(std::max(1u, min_limit), max_limit)),
+      _target_latency(target_latency),
+      _max_saturation(max_saturation)
+{
+}
+
+AdaptiveMasterTaskLimit::AdaptiveMasterTaskLimit()
+    : AdaptiveMasterTaskLimit(0)
+{
+}
+
+AdaptiveMasterTaskLimit::AdaptiveMasterTaskLimit(uint32_t static_limit)
+    : _lock(),
+      _config(),
+      _static_limit(static_limit),
+      _limit(static_limit),
+      _increases(0),
+      _decreases(0)
+{
+}
+
+AdaptiveMasterTaskLimit::~AdaptiveMasterTaskLimit() = default;
+
+uint32_t
+AdaptiveMasterTaskLimit::clamp(uint32_t limit) const noexcept
+{
+    return std::clamp(limit, _config.min_limit(), _config.max_limit());
+}
+
+uint32_t
+AdaptiveMasterTaskLimit::configure(const AdaptiveMasterTaskLimitConfig& config, uint32_t static_limit)
+{
+    std::lock_guard guard(_lock);
+    bool was_enabled = _config.enabled();
+    _config = config;
+    _static_limit = static_limit;
+    if (!_config.enabled()) {
+        _limit = _static_limit;
+    } else if (!was_enabled) {
+        // Start from the static limit, or fully open when there is none
+        _limit = clamp((_static_limit != 0) ? _static_limit : _config.max_limit());
+    } else {
+        _limit = clamp(_limit);
+    }
+    return _limit;
+}
+
+uint32_t
+AdaptiveMasterTaskLimit::update(const ExecutorThreadingServiceStats& executor_stats, const FeedLatencyStats& latency_stats)
+{
+    std::lock_guard guard(_lock);
+    if (!_config.enabled()) {
+        return _limit;
+    }
+    const auto& master_stats = executor_stats.getMasterExecutorStats();
+    double saturation = std::max({master_stats.get_saturation(),
+                                  executor_stats.getIndexExecutorStats().get_saturation(),
+                                  executor_stats.getSummaryExecutorStats().get_saturation()});
+    uint64_t operations = latency_stats.get_count();
+    double avg_latency = (operations != 0) ? (latency_stats.get_total() / operations) : 0.0;
+    uint32_t old_limit = _limit;
+    if (((operations != 0) && (avg_latency > _config.target_latency())) || (saturation > _config.max_saturation())) {
+        _limit = clamp(_limit / 2);
+        if (_limit < old_limit) {
+            ++_decreases;
+        }
+    } else if ((operations != 0) && (master_stats.queueSize.max() >= _limit)) {
+        _limit = clamp(_limit + _config.min_limit());
+        if (_limit > old_limit) {
+            ++_increases;
+        }
+    }
+    if (_limit != old_limit) {
+        LOG(debug, "Master task limit changed from %u to %u (avg latency %.3f s, max saturation %.3f)",
+            old_limit, _limit, avg_latency, saturation);
+    }
+    return _limit;
+}
+
+uint32_t
+AdaptiveMasterTaskLimit::get_limit() const
+{
+    std::lock_guard guard(_lock);
+    return _limit;
+}
+
+uint64_t
+AdaptiveMasterTaskLimit::get_increases() const
+{
+    std::lock_guard guard(_lock);
+    return _increases;
+}
+
+uint64_t
+AdaptiveMasterTaskLimit::get_decreases() const
+{
+    std::lock_guard guard(_lock);
+    return _decreases;
+}
+
+}
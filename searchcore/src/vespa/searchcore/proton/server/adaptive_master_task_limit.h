@@ -0,0 +1,73 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+
+namespace proton {
+
+class ExecutorThreadingServiceStats;
+class FeedLatencyStats;
+
+/*
+ * Config for adaptive adjustment of the master task limit in a document db.
+ */
+class AdaptiveMasterTaskLimitConfig {
+    bool     _enabled;
+    uint32_t _min_limit;
+    uint32_t _max_limit;
+    double   _target_latency;
+    double   _max_saturation;
+public:
+    AdaptiveMasterTaskLimitConfig() noexcept;
+    AdaptiveMasterTaskLimitConfig(bool enabled, uint32_t min_limit, uint32_t max_limit,
+                                  double target_latency, double max_saturation) noexcept;
+    bool enabled() const noexcept { return _enabled; }
+    uint32_t min_limit() const noexcept { return _min_limit; }
+    uint32_t max_limit() const noexcept { return _max_limit; }
+    double target_latency() const noexcept { return _target_latency; }
+    double max_saturation() const noexcept { return _max_saturation; }
+    bool operator==(const AdaptiveMasterTaskLimitConfig& rhs) const noexcept = default;
+};
+
+/*
+ * Adjusts the master task limit in a document db, i.e. the number of pending master
+ * tasks before persistence threads feeding the document db are blocked.
+ *
+ * The limit is halved when the average feed operation latency is above the target latency
+ * or when the master, index or summary executor is saturated. The latency is measured from
+ * the operation being handled in the master thread until it is acked, excluding the time
+ * persistence threads are blocked by the limit, as a lower limit would only increase that.
+ * The limit is increased additively when the master executor queue reached the limit during
+ * the sample period while latency and saturation stayed within bounds.
+ * When disabled, or before being configured, the static limit is used.
+ */
+class AdaptiveMasterTaskLimit {
+    mutable std::mutex            _lock;
+    AdaptiveMasterTaskLimitConfig _config;
+    uint32_t                      _static_limit;
+    uint32_t                      _limit;
+    uint64_t                      _increases;
+    uint64_t                      _decreases;
+
+    uint32_t clamp(uint32_t limit) const noexcept;
+public:
+    AdaptiveMasterTaskLimit();
+    explicit AdaptiveMasterTaskLimit(uint32_t static_limit);
+    ~AdaptiveMasterTaskLimit();
+    /*
+     * Returns the master task limit to be used after the config change.
+     */
+    uint32_t configure(const AdaptiveMasterTaskLimitConfig& config, uint32_t static_limit);
+    /*
+     * Adjusts the limit based on executor stats and feed operation latencies sampled since the
+     * previous call, and returns the master task limit to be used.
+     */
+    uint32_t update(const ExecutorThreadingServiceStats& executor_stats, const FeedLatencyStats& latency_stats);
+    uint32_t get_limit() const;
+    uint64_t get_increases() const;
+    uint64_t get_decreases() const;
+};
+
+}
@@ -9,8 +9,16 @@ DocumentDBFlushConfig::DocumentDBFlushConfig() noexcept
 }
 
 DocumentDBFlushConfig::DocumentDBFlushConfig(uint32_t maxFlushed, uint32_t maxFlushedRetired) noexcept
+    : DocumentDBFlushConfig(maxFlushed, maxFlushedRetired, 0.0, 8)
+{
+}
+
+DocumentDBFlushConfig::DocumentDBFlushConfig(uint32_t maxFlushed, uint32_t maxFlushedRetired,
+                                             double fusionSizeRatio, uint32_t maxFlushedDeferred) noexcept
     : _maxFlushed(maxFlushed),
-      _maxFlushedRetired(maxFlushedRetired)
+      _maxFlushedRetired(maxFlushedRetired),
+      _fusionSizeRatio(fusionSizeRatio),
+      _maxFlushedDeferred(maxFlushedDeferred)
 {
 }
 
@@ -19,7 +27,9 @@ DocumentDBFlushConfig::operator==(const DocumentDBFlushConfig &rhs) const noexce
 {
     return
         _maxFlushed == rhs._maxFlushed &&
-        _maxFlushedRetired == rhs._maxFlushedRetired;
+        _maxFlushedRetired == rhs._maxFlushedRetired &&
+        _fusionSizeRatio == rhs._fusionSizeRatio &&
+        _maxFlushedDeferred == rhs._maxFlushedDeferred;
 }
 
 } // namespace proton
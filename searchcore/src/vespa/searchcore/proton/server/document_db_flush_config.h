@@ -11,13 +11,19 @@ namespace proton {
 class DocumentDBFlushConfig {
     uint32_t _maxFlushed;
     uint32_t _maxFlushedRetired;
+    double   _fusionSizeRatio;
+    uint32_t _maxFlushedDeferred;
 
 public:
     DocumentDBFlushConfig() noexcept;
     DocumentDBFlushConfig(uint32_t maxFlushed, uint32_t maxFlushedRetired) noexcept;
+    DocumentDBFlushConfig(uint32_t maxFlushed, uint32_t maxFlushedRetired,
+                          double fusionSizeRatio, uint32_t maxFlushedDeferred) noexcept;
     bool operator==(const DocumentDBFlushConfig &rhs) const noexcept;
     uint32_t getMaxFlushed() const noexcept { return _maxFlushed; }
     uint32_t getMaxFlushedRetired() const noexcept { return _maxFlushedRetired; }
+    double getFusionSizeRatio() const noexcept { return _fusionSizeRatio; }
+    uint32_t getMaxFlushedDeferred() const noexcept { return _maxFlushedDeferred; }
 };
 
 } // namespace proton
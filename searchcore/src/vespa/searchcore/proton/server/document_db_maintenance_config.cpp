@@ -50,6 +50,7 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig() noexcep
       _allowedLidBloatFactor(1.0),
       _remove_batch_block_rate(0.5),
       _remove_block_rate(100),
+      _max_docs_to_move_per_run(1),
       _disabled(false)
 {
 }
@@ -60,12 +61,25 @@ DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(vespalib:
                                                                        double remove_batch_block_rate,
                                                                        double remove_block_rate,
                                                                        bool disabled) noexcept
+    : DocumentDBLidSpaceCompactionConfig(interval, allowedLidBloat, allowedLidBloatFactor,
+                                         remove_batch_block_rate, remove_block_rate, 1, disabled)
+{
+}
+
+DocumentDBLidSpaceCompactionConfig::DocumentDBLidSpaceCompactionConfig(vespalib::duration interval,
+                                                                       uint32_t allowedLidBloat,
+                                                                       double allowedLidBloatFactor,
+                                                                       double remove_batch_block_rate,
+                                                                       double remove_block_rate,
+                                                                       uint32_t max_docs_to_move_per_run,
+                                                                       bool disabled) noexcept
     : _delay(std::min(MAX_DELAY_SEC, interval)),
       _interval(interval),
       _allowedLidBloat(allowedLidBloat),
       _allowedLidBloatFactor(allowedLidBloatFactor),
       _remove_batch_block_rate(remove_batch_block_rate),
       _remove_block_rate(remove_block_rate),
+      _max_docs_to_move_per_run(std::max(1u, max_docs_to_move_per_run)),
       _disabled(disabled)
 {
 }
@@ -85,6 +99,7 @@ DocumentDBLidSpaceCompactionConfig::operator==(const DocumentDBLidSpaceCompactio
            _interval == rhs._interval &&
            _allowedLidBloat == rhs._allowedLidBloat &&
            _allowedLidBloatFactor == rhs._allowedLidBloatFactor &&
+           _max_docs_to_move_per_run == rhs._max_docs_to_move_per_run &&
            _disabled == rhs._disabled;
 }
 
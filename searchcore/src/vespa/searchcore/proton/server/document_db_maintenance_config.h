@@ -50,6 +50,7 @@ private:
     double               _allowedLidBloatFactor;
     double               _remove_batch_block_rate;
     double               _remove_block_rate;
+    uint32_t             _max_docs_to_move_per_run;
     bool                 _disabled;
 
 public:
@@ -60,6 +61,13 @@ public:
                                        double remove_batch_block_rate,
                                        double remove_block_rate,
                                        bool disabled) noexcept;
+    DocumentDBLidSpaceCompactionConfig(vespalib::duration interval,
+                                       uint32_t allowedLidBloat,
+                                       double allowwedLidBloatFactor,
+                                       double remove_batch_block_rate,
+                                       double remove_block_rate,
+                                       uint32_t max_docs_to_move_per_run,
+                                       bool disabled) noexcept;
 
     static DocumentDBLidSpaceCompactionConfig createDisabled() noexcept;
     bool operator==(const DocumentDBLidSpaceCompactionConfig &rhs) const noexcept;
@@ -69,6 +77,7 @@ public:
     double getAllowedLidBloatFactor() const noexcept { return _allowedLidBloatFactor; }
     double get_remove_batch_block_rate() const noexcept { return _remove_batch_block_rate; }
     double get_remove_block_rate() const noexcept { return _remove_block_rate; }
+    uint32_t get_max_docs_to_move_per_run() const noexcept { return _max_docs_to_move_per_run; }
     bool isDisabled() const noexcept { return _disabled; }
 };
 
@@ -74,7 +74,8 @@ namespace {
 
 index::IndexConfig
 makeIndexConfig(const ProtonConfig::Index & cfg) {
-    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed)};
+    return {WarmupConfig(vespalib::from_s(cfg.warmup.time), cfg.warmup.unpack), size_t(cfg.maxflushed),
+            uint32_t(std::max(1, cfg.invertShards))};
 }
 
 class MetricsUpdateHook : public metrics::UpdateHook {
@@ -181,6 +182,7 @@ DocumentDB::DocumentDB(const std::string &baseDir,
       _writeServiceConfig(configSnapshot->get_threading_service_config()),
       _writeService(shared_service.shared(), shared_service.transport(), shared_service.field_writer(),
                     &shared_service.invokeService(), _writeServiceConfig),
+      _master_task_limit(_writeServiceConfig.master_task_limit()),
       _initializeThreads(std::move(initializeThreads)),
       _initConfigSnapshot(),
       _initConfigSerialNum(0u),
@@ -213,7 +215,7 @@ DocumentDB::DocumentDB(const std::string &baseDir,
       _maintenanceController(shared_service.transport(), _writeService.master(), _refCount, _docTypeName),
       _jobTrackers(),
       _calc(),
-      _metricsUpdater(_subDBs, _writeService, _jobTrackers, _writeFilter, *_feedHandler)
+      _metricsUpdater(_subDBs, _writeService, _master_task_limit, _jobTrackers, _writeFilter, *_feedHandler)
 {
     assert(configSnapshot);
 
@@ -464,7 +466,8 @@ DocumentDB::applyConfig(DocumentDBConfig::SP configSnapshot, SerialNum serialNum
     if (_state.getState() >= DDBState::State::APPLY_LIVE_CONFIG) {
         _writeServiceConfig.update(configSnapshot->get_threading_service_config());
     }
-    _writeService.set_task_limits(_writeServiceConfig.master_task_limit(),
+    _writeService.set_task_limits(_master_task_limit.configure(_writeServiceConfig.adaptive_master_task_limit(),
+                                                               _writeServiceConfig.master_task_limit()),
                                   _writeServiceConfig.defaultTaskLimit(),
                                   _writeServiceConfig.defaultTaskLimit());
     if (params.shouldSubDbsChange()) {
@@ -861,8 +864,8 @@ DocumentDB::reportStatus() const
                 message("DocumentDB initializing components"));
     } else if (_feedHandler->isDoingReplay()) {
         float progress = _feedHandler->getReplayProgress() * 100.0f;
-        std::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done)",
-                static_cast<uint32_t>(progress));
+        std::string msg = vespalib::make_string("DocumentDB replay transaction log on startup (%u%% done, %.0f operations/s)",
+                static_cast<uint32_t>(progress), _feedHandler->getReplayOperationsPerSecond());
         return StatusReport::create(params.state(StatusReport::PARTIAL).progress(progress).message(msg));
     } else if (rawState == DDBState::State::APPLY_LIVE_CONFIG) {
         return StatusReport::create(params.state(StatusReport::PARTIAL)
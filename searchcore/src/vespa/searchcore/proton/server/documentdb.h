@@ -110,6 +110,7 @@ private:
     ThreadingServiceConfig        _writeServiceConfig;
     // Only one thread per executor, or dropFeedView() will fail.
     ExecutorThreadingService      _writeService;
+    AdaptiveMasterTaskLimit       _master_task_limit;
     // threads for initializer tasks during proton startup
     InitializeThreads             _initializeThreads;
 
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "documentdb_metrics_updater.h"
+#include "adaptive_master_task_limit.h"
 #include "document_meta_store_read_guards.h"
 #include "documentsubdbcollection.h"
 #include "executorthreadingservice.h"
@@ -35,11 +36,13 @@ using matching::MatchingStats;
 
 DocumentDBMetricsUpdater::DocumentDBMetricsUpdater(const DocumentSubDBCollection &subDBs,
                                                    ExecutorThreadingService &writeService,
+                                                   AdaptiveMasterTaskLimit &master_task_limit,
                                                    DocumentDBJobTrackers &jobTrackers,
                                                    const AttributeUsageFilter &writeFilter,
                                                    FeedHandler& feed_handler)
     : _subDBs(subDBs),
       _writeService(writeService),
+      _master_task_limit(master_task_limit),
       _jobTrackers(jobTrackers),
       _writeFilter(writeFilter),
       _feed_handler(feed_handler),
@@ -274,6 +277,15 @@ updateLidSpaceMetrics(MetricSetType &metrics, const search::IDocumentMetaStore &
 }
 
 void
+update_latency_metric(metrics::DoubleAverageMetric& metric, const FeedLatencyStats& stats)
+{
+    uint64_t count = stats.get_count();
+    if (count != 0) {
+        metric.addValueBatch(stats.get_total() / count, count, stats.get_min().value_or(0.0), stats.get_max().value_or(0.0));
+    }
+}
+
+FeedHandlerStats
 update_feeding_metrics(DocumentDBFeedingMetrics& metrics, FeedHandlerStats stats, std::optional<FeedHandlerStats>& last_stats)
 {
     auto delta_stats = stats;
@@ -292,6 +304,23 @@ update_feeding_metrics(DocumentDBFeedingMetrics& metrics, FeedHandlerStats stats
         double avg_latency = delta_stats.get_total_latency() / commits;
         metrics.commit.latency.addValueBatch(avg_latency, commits, min_latency, max_latency);
     }
+    update_latency_metric(metrics.operation.wait_latency, delta_stats.get_operation_wait_latency());
+    update_latency_metric(metrics.operation.master_latency, delta_stats.get_operation_master_latency());
+    update_latency_metric(metrics.operation.completion_latency, delta_stats.get_operation_completion_latency());
+    update_latency_metric(metrics.operation.attributes_latency, delta_stats.get_operation_attributes_latency());
+    update_latency_metric(metrics.operation.memory_index_latency, delta_stats.get_operation_memory_index_latency());
+    update_latency_metric(metrics.operation.document_store_latency, delta_stats.get_operation_document_store_latency());
+    update_latency_metric(metrics.operation.latency, delta_stats.get_operation_latency());
+    return delta_stats;
+}
+
+void
+update_master_task_limit_metrics(DocumentDBMasterTaskLimitMetrics& metrics, const AdaptiveMasterTaskLimit& master_task_limit,
+                                 uint32_t limit)
+{
+    metrics.limit.set(limit);
+    metrics.increases.set(master_task_limit.get_increases());
+    metrics.decreases.set(master_task_limit.get_decreases());
 }
 
 }
@@ -310,7 +339,13 @@ DocumentDBMetricsUpdater::updateMetrics(const metrics::MetricLockGuard & guard,
 
     metrics.totalMemoryUsage.update(totalStats.memoryUsage);
     metrics.totalDiskUsage.set(totalStats.diskUsage);
-    update_feeding_metrics(metrics.feeding, _feed_handler.get_stats(true), _last_feed_handler_stats);
+    auto feed_handler_stats = update_feeding_metrics(metrics.feeding, _feed_handler.get_stats(true), _last_feed_handler_stats);
+    // Reuses the samples above since both executor stats and feed handler stats are reset when sampled.
+    // Latency is measured from the master thread starting the operation, since the time waiting for
+    // the master thread includes time blocked by the master task limit itself.
+    uint32_t master_task_limit = _master_task_limit.update(threadingServiceStats, feed_handler_stats.get_operation_processing_latency());
+    _writeService.set_master_task_limit(master_task_limit);
+    update_master_task_limit_metrics(metrics.feeding.master_task_limit, _master_task_limit, master_task_limit);
 }
 
 void
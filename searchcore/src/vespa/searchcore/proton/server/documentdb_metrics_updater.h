@@ -8,6 +8,7 @@
 
 namespace proton {
 
+class AdaptiveMasterTaskLimit;
 class AttributeUsageFilter;
 class DDBState;
 class DocumentDBJobTrackers;
@@ -22,6 +23,7 @@ class FeedHandler;
 class DocumentDBMetricsUpdater {
     const DocumentSubDBCollection &_subDBs;
     ExecutorThreadingService      &_writeService;
+    AdaptiveMasterTaskLimit       &_master_task_limit;
     DocumentDBJobTrackers         &_jobTrackers;
     const AttributeUsageFilter    &_writeFilter;
     FeedHandler                   &_feed_handler;
@@ -33,6 +35,7 @@ class DocumentDBMetricsUpdater {
 public:
     DocumentDBMetricsUpdater(const DocumentSubDBCollection &subDBs,
                              ExecutorThreadingService &writeService,
+                             AdaptiveMasterTaskLimit &master_task_limit,
                              DocumentDBJobTrackers &jobTrackers,
                              const AttributeUsageFilter &writeFilter,
                              FeedHandler& feed_handler);
@@ -130,6 +130,7 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
                     proton.lidspacecompaction.allowedlidbloatfactor,
                     proton.lidspacecompaction.removebatchblockrate,
                     proton.lidspacecompaction.removeblockrate,
+                    proton.lidspacecompaction.maxdocstomoveperrun,
                     isDocumentTypeGlobal),
             AttributeUsageFilterConfig(
                     proton.writefilter.attribute.addressSpaceLimit),
@@ -137,7 +138,8 @@ buildMaintenanceConfig(const BootstrapConfig::SP &bootstrapConfig,
             BlockableMaintenanceJobConfig(
                     proton.maintenancejobs.resourcelimitfactor,
                     proton.maintenancejobs.maxoutstandingmoveops),
-            DocumentDBFlushConfig(proton.index.maxflushed,proton.index.maxflushedretired),
+            DocumentDBFlushConfig(proton.index.maxflushed, proton.index.maxflushedretired,
+                                  proton.index.fusion.sizeratio, proton.index.fusion.maxflusheddeferred),
             BucketMoveConfig(proton.bucketmove.maxdocstomoveperbucket));
 }
 
@@ -254,7 +256,7 @@ build_alloc_config(const vespalib::HwInfo & hwInfo, const ProtonConfig& proton_c
             : alloc_config.initialnumdocs;
     auto& distribution_config = proton_config.distribution;
     search::GrowStrategy grow_strategy(target_numdocs, alloc_config.growfactor, alloc_config.growbias, target_numdocs, alloc_config.multivaluegrowfactor);
-    CompactionStrategy compaction_strategy(alloc_config.maxDeadBytesRatio, alloc_config.maxDeadAddressSpaceRatio, alloc_config.maxCompactBuffers, alloc_config.activeBuffersRatio);
+    CompactionStrategy compaction_strategy(alloc_config.maxDeadBytesRatio, alloc_config.maxDeadAddressSpaceRatio, alloc_config.maxCompactBuffers, alloc_config.activeBuffersRatio, alloc_config.maxCompactStepEntries);
     return AllocConfig(AllocStrategy(grow_strategy, compaction_strategy, alloc_config.amortizecount),
                        distribution_config.redundancy, distribution_config.searchablecopies);
 }
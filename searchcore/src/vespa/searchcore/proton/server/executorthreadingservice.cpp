@@ -99,7 +99,7 @@ ExecutorThreadingService::set_task_limits(uint32_t master_task_limit,
                                           uint32_t field_task_limit,
                                           uint32_t summary_task_limit)
 {
-    _master_task_limit.store(master_task_limit, std::memory_order_release);
+    set_master_task_limit(master_task_limit);
     _indexExecutor->setTaskLimit(field_task_limit);
     _summaryExecutor->setTaskLimit(summary_task_limit);
     _field_writer.setTaskLimit(field_task_limit);
@@ -54,6 +54,9 @@ public:
     uint32_t master_task_limit() const {
         return _master_task_limit.load(std::memory_order_relaxed);
     }
+    void set_master_task_limit(uint32_t master_task_limit) {
+        _master_task_limit.store(master_task_limit, std::memory_order_release);
+    }
     void set_task_limits(uint32_t master_task_limit,
                          uint32_t field_task_limit,
                          uint32_t summary_task_limit);
@@ -5,10 +5,12 @@
 #include "operationdonecontext.h"
 #include "removedonecontext.h"
 #include "putdonecontext.h"
+#include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 
 using document::Document;
 using document::DocumentUpdate;
+using proton::feedtoken::WriteStage;
 using search::index::Schema;
 
 namespace proton {
@@ -21,14 +23,14 @@ namespace proton {
 void
 FastAccessFeedView::putAttributes(SerialNum serialNum, search::DocumentIdT lid, const Document &doc, const OnPutDoneType& onWriteDone)
 {
-    _attributeWriter->put(serialNum, doc, lid, onWriteDone);
+    _attributeWriter->put(serialNum, doc, lid, make_write_done_callback(onWriteDone, WriteStage::ATTRIBUTES));
 }
 
 void
 FastAccessFeedView::updateAttributes(SerialNum serialNum, search::DocumentIdT lid, const DocumentUpdate &upd,
                                      const OnOperationDoneType& onWriteDone, IFieldUpdateCallback & onUpdate)
 {
-    _attributeWriter->update(serialNum, upd, lid, onWriteDone, onUpdate);
+    _attributeWriter->update(serialNum, upd, lid, make_write_done_callback(onWriteDone, WriteStage::ATTRIBUTES), onUpdate);
 }
 
 void
@@ -37,7 +39,7 @@ FastAccessFeedView::updateAttributes(SerialNum serialNum, Lid lid, FutureDoc fut
     if (_attributeWriter->hasStructFieldAttribute()) {
         const std::unique_ptr<const Document> & doc = futureDoc.get();
         if (doc) {
-            _attributeWriter->update(serialNum, *doc, lid, onWriteDone);
+            _attributeWriter->update(serialNum, *doc, lid, make_write_done_callback(onWriteDone, WriteStage::ATTRIBUTES));
         }
     }
 }
@@ -45,7 +47,7 @@ FastAccessFeedView::updateAttributes(SerialNum serialNum, Lid lid, FutureDoc fut
 void
 FastAccessFeedView::removeAttributes(SerialNum serialNum, search::DocumentIdT lid, const OnRemoveDoneType& onWriteDone)
 {
-    _attributeWriter->remove(serialNum, lid, onWriteDone);
+    _attributeWriter->remove(serialNum, lid, make_write_done_callback(onWriteDone, WriteStage::ATTRIBUTES));
 }
 
 void
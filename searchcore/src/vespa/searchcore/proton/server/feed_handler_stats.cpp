@@ -2,6 +2,7 @@
 
 #include "feed_handler_stats.h"
 #include <cassert>
+#include <limits>
 #include <vespa/log/log.h>
 
 LOG_SETUP(".proton.server.feed_handler_stats");
@@ -21,6 +22,142 @@ void update_min_max(T value, std::optional<T>& min, std::optional<T>& max)
     }
 }
 
+constexpr double no_min = std::numeric_limits<double>::infinity();
+constexpr double no_max = -std::numeric_limits<double>::infinity();
+
+std::optional<double>
+get_bound(std::atomic<double>& bound, double none, bool reset) noexcept
+{
+    double value = reset ? bound.exchange(none, std::memory_order_relaxed) : bound.load(std::memory_order_relaxed);
+    return (value != none) ? std::optional<double>(value) : std::nullopt;
+}
+
+}
+
+FeedLatencyStats::FeedLatencyStats(uint64_t count, double total, std::optional<double> min, std::optional<double> max) noexcept
+    : _count(count),
+      _total(total),
+      _min(min),
+      _max(max)
+{
+}
+
+FeedLatencyStats::FeedLatencyStats() noexcept
+    : _count(0),
+      _total(0.0),
+      _min(),
+      _max()
+{
+}
+
+FeedLatencyStats&
+FeedLatencyStats::operator-=(const FeedLatencyStats& rhs) noexcept
+{
+    _count -= rhs._count;
+    _total -= rhs._total;
+    return *this;
+}
+
+void
+FeedLatencyStats::add(double latency) noexcept
+{
+    ++_count;
+    _total += latency;
+    update_min_max(latency, _min, _max);
+}
+
+void
+FeedLatencyStats::reset_min_max() noexcept
+{
+    _min.reset();
+    _max.reset();
+}
+
+FeedOperationLatencies::FeedOperationLatencies() noexcept = default;
+
+FeedOperationLatencies&
+FeedOperationLatencies::operator-=(const FeedOperationLatencies& rhs) noexcept
+{
+    wait -= rhs.wait;
+    master -= rhs.master;
+    completion -= rhs.completion;
+    processing -= rhs.processing;
+    total -= rhs.total;
+    attributes -= rhs.attributes;
+    memory_index -= rhs.memory_index;
+    document_store -= rhs.document_store;
+    return *this;
+}
+
+FeedOperationLatencyTracker::Stage::Stage() noexcept
+    : _count(0),
+      _total(0.0),
+      _min(no_min),
+      _max(no_max)
+{
+}
+
+void
+FeedOperationLatencyTracker::Stage::add(double latency) noexcept
+{
+    _count.fetch_add(1, std::memory_order_relaxed);
+    _total.fetch_add(latency, std::memory_order_relaxed);
+    double min = _min.load(std::memory_order_relaxed);
+    while (latency < min && !_min.compare_exchange_weak(min, latency, std::memory_order_relaxed)) { }
+    double max = _max.load(std::memory_order_relaxed);
+    while (latency > max && !_max.compare_exchange_weak(max, latency, std::memory_order_relaxed)) { }
+}
+
+FeedLatencyStats
+FeedOperationLatencyTracker::Stage::get_stats(bool reset_min_max) noexcept
+{
+    return {_count.load(std::memory_order_relaxed), _total.load(std::memory_order_relaxed),
+            get_bound(_min, no_min, reset_min_max), get_bound(_max, no_max, reset_min_max)};
+}
+
+FeedOperationLatencyTracker::FeedOperationLatencyTracker() noexcept = default;
+
+FeedOperationLatencyTracker::~FeedOperationLatencyTracker() = default;
+
+void
+FeedOperationLatencyTracker::add_operation(double wait_latency, double master_latency, double completion_latency) noexcept
+{
+    _wait.add(wait_latency);
+    _master.add(master_latency);
+    _completion.add(completion_latency);
+    _processing.add(master_latency + completion_latency);
+    _total.add(wait_latency + master_latency + completion_latency);
+}
+
+void
+FeedOperationLatencyTracker::add_write(feedtoken::WriteStage stage, double latency) noexcept
+{
+    switch (stage) {
+    case feedtoken::WriteStage::ATTRIBUTES:
+        _attributes.add(latency);
+        break;
+    case feedtoken::WriteStage::MEMORY_INDEX:
+        _memory_index.add(latency);
+        break;
+    case feedtoken::WriteStage::DOCUMENT_STORE:
+        _document_store.add(latency);
+        break;
+    }
+}
+
+FeedOperationLatencies
+FeedOperationLatencyTracker::get_stats(bool reset_min_max) noexcept
+{
+    FeedOperationLatencies result;
+    result.wait = _wait.get_stats(reset_min_max);
+    result.master = _master.get_stats(reset_min_max);
+    result.completion = _completion.get_stats(reset_min_max);
+    result.processing = _processing.get_stats(reset_min_max);
+    result.total = _total.get_stats(reset_min_max);
+    result.attributes = _attributes.get_stats(reset_min_max);
+    result.memory_index = _memory_index.get_stats(reset_min_max);
+    result.document_store = _document_store.get_stats(reset_min_max);
+    return result;
 }
 
 FeedHandlerStats::FeedHandlerStats(uint64_t commits, uint64_t operations, double total_latency) noexcept
@@ -30,7 +167,8 @@ FeedHandlerStats::FeedHandlerStats(uint64_t commits, uint64_t operations, double
       _min_operations(),
       _max_operations(),
       _min_latency(),
-      _max_latency()
+      _max_latency(),
+      _operation_latencies()
 {
 }
 
@@ -48,6 +186,7 @@ FeedHandlerStats::operator-=(const FeedHandlerStats& rhs) noexcept
     _commits -= rhs._commits;
     _operations -= rhs._operations;
     _total_latency -= rhs._total_latency;
+    _operation_latencies -= rhs._operation_latencies;
     return *this;
 }
 
@@ -2,11 +2,89 @@
 
 #pragma once
 
+#include <vespa/searchcore/proton/common/feedtoken.h>
+#include <atomic>
 #include <cstdint>
 #include <optional>
 
 namespace proton {
 
+/*
+ * Latency stats for one stage of feed operations.
+ */
+class FeedLatencyStats
+{
+    uint64_t              _count;
+    double                _total;
+    std::optional<double> _min;
+    std::optional<double> _max;
+
+public:
+    FeedLatencyStats() noexcept;
+    FeedLatencyStats(uint64_t count, double total, std::optional<double> min, std::optional<double> max) noexcept;
+    FeedLatencyStats& operator-=(const FeedLatencyStats& rhs) noexcept;
+    void add(double latency) noexcept;
+    void reset_min_max() noexcept;
+    uint64_t get_count() const noexcept { return _count; }
+    double get_total() const noexcept { return _total; }
+    const std::optional<double>& get_min() const noexcept { return _min; }
+    const std::optional<double>& get_max() const noexcept { return _max; }
+};
+
+/*
+ * Latency stats for the stages of feed operations. The writer stages
+ * are measured from when the operation was handled in the master thread
+ * until the writer was done with it.
+ */
+struct FeedOperationLatencies
+{
+    FeedLatencyStats wait;           // waiting for master thread
+    FeedLatencyStats master;         // handled in master thread
+    FeedLatencyStats completion;     // transaction log commit and writers until acked
+    FeedLatencyStats processing;     // handled in master thread until acked
+    FeedLatencyStats total;          // received until acked
+    FeedLatencyStats attributes;     // attribute writer
+    FeedLatencyStats memory_index;   // memory index writer
+    FeedLatencyStats document_store; // document store writer
+
+    FeedOperationLatencies() noexcept;
+    FeedOperationLatencies& operator-=(const FeedOperationLatencies& rhs) noexcept;
+};
+
+/*
+ * Accumulates latency stats for the stages of feed operations. Feed
+ * operations are acked from many threads, thus the stats are updated
+ * without taking a lock.
+ */
+class FeedOperationLatencyTracker
+{
+    class Stage {
+        std::atomic<uint64_t> _count;
+        std::atomic<double>   _total;
+        std::atomic<double>   _min;
+        std::atomic<double>   _max;
+    public:
+        Stage() noexcept;
+        void add(double latency) noexcept;
+        FeedLatencyStats get_stats(bool reset_min_max) noexcept;
+    };
+    Stage _wait;
+    Stage _master;
+    Stage _completion;
+    Stage _processing;
+    Stage _total;
+    Stage _attributes;
+    Stage _memory_index;
+    Stage _document_store;
+
+public:
+    FeedOperationLatencyTracker() noexcept;
+    ~FeedOperationLatencyTracker();
+    void add_operation(double wait_latency, double master_latency, double completion_latency) noexcept;
+    void add_write(feedtoken::WriteStage stage, double latency) noexcept;
+    FeedOperationLatencies get_stats(bool reset_min_max) noexcept;
+};
+
 /*
  * Stats for feed handler.
  */
@@ -19,6 +97,7 @@ class FeedHandlerStats
     std::optional<uint32_t> _max_operations;
     std::optional<double>   _min_latency;
     std::optional<double>   _max_latency;
+    FeedOperationLatencies  _operation_latencies;
 
 public:
     FeedHandlerStats(uint64_t commits, uint64_t operations, double total_latency) noexcept;
@@ -26,6 +105,7 @@ public:
     ~FeedHandlerStats();
     FeedHandlerStats& operator-=(const FeedHandlerStats& rhs) noexcept;
     void add_commit(uint32_t operations, double latency) noexcept;
+    void set_operation_latencies(const FeedOperationLatencies& latencies) noexcept { _operation_latencies = latencies; }
     void reset_min_max() noexcept;
     uint64_t get_commits() noexcept { return _commits; }
     uint64_t get_operations() noexcept { return _operations; }
@@ -34,6 +114,14 @@ public:
     const std::optional<uint32_t>& get_max_operations() noexcept { return _max_operations; }
     const std::optional<double>& get_min_latency() noexcept { return _min_latency; }
     const std::optional<double>& get_max_latency() noexcept { return _max_latency; }
+    const FeedLatencyStats& get_operation_wait_latency() const noexcept { return _operation_latencies.wait; }
+    const FeedLatencyStats& get_operation_master_latency() const noexcept { return _operation_latencies.master; }
+    const FeedLatencyStats& get_operation_completion_latency() const noexcept { return _operation_latencies.completion; }
+    const FeedLatencyStats& get_operation_processing_latency() const noexcept { return _operation_latencies.processing; }
+    const FeedLatencyStats& get_operation_latency() const noexcept { return _operation_latencies.total; }
+    const FeedLatencyStats& get_operation_attributes_latency() const noexcept { return _operation_latencies.attributes; }
+    const FeedLatencyStats& get_operation_memory_index_latency() const noexcept { return _operation_latencies.memory_index; }
+    const FeedLatencyStats& get_operation_document_store_latency() const noexcept { return _operation_latencies.document_store; }
 };
 
 /**
@@ -23,6 +23,7 @@
 #include <vespa/vespalib/util/atomic.h>
 #include <vespa/vespalib/util/exceptions.h>
 #include <vespa/vespalib/util/lambdatask.h>
+#include <array>
 #include <cassert>
 #include <thread>
 
@@ -141,6 +142,71 @@ private:
 
 DaisyChainedFeedToken::~DaisyChainedFeedToken() = default;
 
+/**
+ * Wraps the original feed token to track how long an external feed
+ * operation waits for the master thread, is handled in the master
+ * thread and waits for transaction log commit and writers before
+ * being acked. The time each writer is done with the operation is
+ * tracked separately.
+ */
+class LatencyTrackingFeedToken : public feedtoken::IState {
+    using WriteStage = feedtoken::WriteStage;
+    static constexpr size_t num_write_stages = 3;
+public:
+    LatencyTrackingFeedToken(FeedToken token, FeedOperationLatencyTracker& tracker) noexcept
+        : _token(std::move(token)),
+          _tracker(tracker),
+          _received_time(vespalib::steady_clock::now()),
+          _master_start_time(),
+          _master_done_time(),
+          _write_done_time()
+    {}
+    ~LatencyTrackingFeedToken() override;
+    bool is_replay() const noexcept override { return _token->is_replay(); }
+    void fail() override { _token->fail(); }
+    void setResult(ResultUP result, bool documentWasFound) override { _token->setResult(std::move(result), documentWasFound); }
+    const Result &getResult() override { return _token->getResult(); }
+    bool tracks_write_stages() const noexcept override { return true; }
+    void write_done(WriteStage stage) noexcept override;
+    void master_start() noexcept { _master_start_time = vespalib::steady_clock::now(); }
+    void master_done() noexcept { _master_done_time = vespalib::steady_clock::now(); }
+private:
+    FeedToken                    _token;
+    FeedOperationLatencyTracker& _tracker;
+    vespalib::steady_time        _received_time;
+    vespalib::steady_time        _master_start_time;
+    vespalib::steady_time        _master_done_time;
+    std::array<std::atomic<vespalib::steady_time>, num_write_stages> _write_done_time;
+};
+
+void
+LatencyTrackingFeedToken::write_done(WriteStage stage) noexcept
+{
+    // A writer might be handed the operation more than once, e.g. attribute updates followed by struct field updates
+    auto& done_time = _write_done_time[static_cast<size_t>(stage)];
+    auto now = vespalib::steady_clock::now();
+    auto old_done_time = done_time.load(std::memory_order_relaxed);
+    while (now > old_done_time && !done_time.compare_exchange_weak(old_done_time, now, std::memory_order_relaxed)) { }
+}
+
+LatencyTrackingFeedToken::~LatencyTrackingFeedToken()
+{
+    if (_master_done_time == vespalib::steady_time()) {
+        return;
+    }
+    // Stats are updated before the wrapped token is acked
+    vespalib::steady_time now = vespalib::steady_clock::now();
+    _tracker.add_operation(vespalib::to_s(_master_start_time - _received_time),
+                           vespalib::to_s(_master_done_time - _master_start_time),
+                           vespalib::to_s(std::max(now, _master_done_time) - _master_done_time));
+    for (size_t i = 0; i < num_write_stages; ++i) {
+        auto done_time = _write_done_time[i].load(std::memory_order_relaxed);
+        if (done_time != vespalib::steady_time()) {
+            _tracker.add_write(static_cast<WriteStage>(i), vespalib::to_s(std::max(done_time, _master_done_time) - _master_done_time));
+        }
+    }
+}
+
 }  // namespace
 
 void
@@ -432,7 +498,8 @@ FeedHandler::FeedHandler(IThreadingService &writeService,
       _allowSync(false),
       _heart_beat_time(vespalib::steady_time()),
       _stats_lock(),
-      _stats()
+      _stats(),
+      _operation_latencies()
 { }
 
 
@@ -474,7 +541,7 @@ FeedHandler::replayTransactionLog(SerialNum flushedIndexMgrSerial, SerialNum flu
     assert(_bucketDBHandler);
     auto state = make_shared<ReplayTransactionLogState>
                           (getDocTypeName(), _activeFeedView, *_bucketDBHandler, _replayConfig,
-                           config_store, std::move(shared_replay_throttler), *this);
+                           config_store, std::move(shared_replay_throttler), *this, &_writeService.shared());
     changeFeedState(state);
     // Resurrected attribute vector might cause oldestFlushedSerial to
     // be lower than _prunedSerialNum, so don't warn for now.
@@ -689,8 +756,18 @@ FeedHandler::handleOperation(FeedToken token, FeedOperation::UP op)
     // NOTE: Tasks that are created and executed from the master thread itself or some of its helpers
     //       cannot use blocking_master_execute() as that could lead to deadlocks.
     //       See FeedHandler::initiateCommit() for a concrete example.
-    _writeService.blocking_master_execute(makeLambdaTask([this, token = std::move(token), op = std::move(op)]() mutable {
-        doHandleOperation(std::move(token), std::move(op));
+    std::shared_ptr<LatencyTrackingFeedToken> tracked_token;
+    if (token) {
+        tracked_token = std::make_shared<LatencyTrackingFeedToken>(std::move(token), _operation_latencies);
+    }
+    _writeService.blocking_master_execute(makeLambdaTask([this, token = std::move(tracked_token), op = std::move(op)]() mutable {
+        if (token) {
+            token->master_start();
+        }
+        doHandleOperation(token, std::move(op));
+        if (token) {
+            token->master_done();
+        }
     }));
 }
 
@@ -779,6 +856,7 @@ FeedHandler::get_stats(bool reset_min_max) const {
     if (reset_min_max) {
         _stats.reset_min_max();
     }
+    result.set_operation_latencies(_operation_latencies.get_stats(reset_min_max));
     return result;
 }
 
@@ -96,6 +96,7 @@ private:
     std::atomic<vespalib::steady_time>     _heart_beat_time;
     mutable std::mutex                     _stats_lock;
     mutable FeedHandlerStats               _stats;
+    mutable FeedOperationLatencyTracker    _operation_latencies;
 
     /**
      * Delayed handling of feed operations, in master write thread.
@@ -229,6 +230,9 @@ public:
     float getReplayProgress() const {
         return _tlsReplayProgress ? _tlsReplayProgress->getProgress() : 0;
     }
+    double getReplayOperationsPerSecond() const {
+        return _tlsReplayProgress ? _tlsReplayProgress->getOperationsPerSecond() : 0;
+    }
     bool getTransactionLogReplayDone() const;
     std::string getDocTypeName() const { return _docTypeName.getName(); }
     void tlsPrune(SerialNum oldest_to_keep);
@@ -11,10 +11,12 @@
 #include <vespa/searchcore/proton/common/eventlogger.h>
 #include <vespa/searchcore/proton/common/memory_usage_logger.h>
 #include <vespa/searchcore/proton/common/replay_feed_token_factory.h>
+#include <vespa/vespalib/util/count_down_latch.h>
 #include <vespa/vespalib/util/idestructorcallback.h>
 #include <vespa/vespalib/util/lambdatask.h>
 #include <vespa/vespalib/util/shared_operation_throttler.h>
 #include <cassert>
+#include <exception>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".proton.server.feedstates");
@@ -34,6 +36,7 @@ namespace proton {
 namespace {
 
 const search::SerialNum REPLAY_PROGRESS_INTERVAL = 50000;
+const size_t REPLAY_DESERIALIZE_BLOCK_SIZE = 64;
 
 void
 handleProgress(TlsReplayProgress &progress, SerialNum currentSerial)
@@ -147,27 +150,50 @@ public:
 
 class PacketDispatcher {
 public:
-    PacketDispatcher(IReplayPacketHandler *packet_handler)
-        : _packet_handler(packet_handler)
+    PacketDispatcher(IReplayPacketHandler *packet_handler, Executor *deserialize_executor)
+        : _packet_handler(packet_handler),
+          _deserialize_executor(deserialize_executor)
     {}
 
     void handlePacket(PacketWrapper & wrap);
 private:
+    using Entries = std::vector<Packet::Entry>;
+    using Operations = std::vector<std::unique_ptr<FeedOperation>>;
     void handleEntry(const Packet::Entry &entry);
+    void handleEntries(const Entries &entries, size_t begin, size_t end, TlsReplayProgress *progress);
+    Operations deserializeEntries(const Entries &entries, size_t begin, size_t end);
     IReplayPacketHandler *_packet_handler;
+    Executor             *_deserialize_executor;
 };
 
 void
 PacketDispatcher::handlePacket(PacketWrapper & wrap)
 {
     vespalib::nbostream_longlivedbuf handle(wrap.packet.getHandle().data(), wrap.packet.getHandle().size());
+    Entries entries;
+    entries.reserve(wrap.packet.size());
     while ( !handle.empty() ) {
-        Packet::Entry entry;
-        entry.deserialize(handle);
-        handleEntry(entry);
-        if (wrap.progress != nullptr) {
-            handleProgress(*wrap.progress, entry.serial());
+        entries.emplace_back();
+        entries.back().deserialize(handle);
+    }
+    // Config entries may change the document type repo, so operations are only
+    // deserialized ahead of time between them.
+    size_t begin = 0;
+    while (begin < entries.size()) {
+        if (ReplayPacketDispatcher::isConfigEntry(entries[begin])) {
+            handleEntry(entries[begin]);
+            if (wrap.progress != nullptr) {
+                handleProgress(*wrap.progress, entries[begin].serial());
+            }
+            ++begin;
+            continue;
+        }
+        size_t end = begin + 1;
+        while ((end < entries.size()) && !ReplayPacketDispatcher::isConfigEntry(entries[end])) {
+            ++end;
         }
+        handleEntries(entries, begin, end, wrap.progress);
+        begin = end;
     }
     wrap.result = RPC::OK;
     wrap.gate.countDown();
@@ -185,6 +211,69 @@ PacketDispatcher::handleEntry(const Packet::Entry &entry) {
     _packet_handler->optionalCommit(entry_serial_num);
 }
 
+void
+PacketDispatcher::handleEntries(const Entries &entries, size_t begin, size_t end, TlsReplayProgress *progress)
+{
+    if ((_deserialize_executor == nullptr) || (end - begin < 2 * REPLAY_DESERIALIZE_BLOCK_SIZE)) {
+        for (size_t i = begin; i < end; ++i) {
+            handleEntry(entries[i]);
+            if (progress != nullptr) {
+                handleProgress(*progress, entries[i].serial());
+            }
+        }
+        return;
+    }
+    Operations ops = deserializeEntries(entries, begin, end);
+    ReplayPacketDispatcher dispatcher(*_packet_handler);
+    for (const auto &op : ops) {
+        auto serial_num = op->getSerialNum();
+        LOG(spam, "replay operation: serial(%" PRIu64 "), type(%u)", serial_num, op->getType());
+        _packet_handler->check_serial_num(serial_num);
+        dispatcher.replayOperation(*op);
+        _packet_handler->optionalCommit(serial_num);
+        if (progress != nullptr) {
+            handleProgress(*progress, serial_num);
+        }
+    }
+}
+
+PacketDispatcher::Operations
+PacketDispatcher::deserializeEntries(const Entries &entries, size_t begin, size_t end)
+{
+    // Deserializing documents and updates is the expensive part of replay. It is done in
+    // blocks on the deserialize executor, while operations are applied in serial number order.
+    const document::DocumentTypeRepo &repo = _packet_handler->getDeserializeRepo();
+    Operations ops(end - begin);
+    size_t num_blocks = (ops.size() + REPLAY_DESERIALIZE_BLOCK_SIZE - 1) / REPLAY_DESERIALIZE_BLOCK_SIZE;
+    std::vector<std::exception_ptr> errors(num_blocks);
+    vespalib::CountDownLatch latch(num_blocks);
+    for (size_t block = 0; block < num_blocks; ++block) {
+        size_t block_begin = block * REPLAY_DESERIALIZE_BLOCK_SIZE;
+        size_t block_end = std::min(ops.size(), block_begin + REPLAY_DESERIALIZE_BLOCK_SIZE);
+        auto task = makeLambdaTask([&, block, block_begin, block_end]() {
+            try {
+                for (size_t i = block_begin; i < block_end; ++i) {
+                    ops[i] = ReplayPacketDispatcher::deserializeEntry(entries[begin + i], repo);
+                }
+            } catch (...) {
+                errors[block] = std::current_exception();
+            }
+            latch.countDown();
+        });
+        auto rejected = _deserialize_executor->execute(std::move(task));
+        if (rejected) {
+            rejected->run();
+        }
+    }
+    latch.await();
+    for (const auto &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return ops;
+}
+
 }  // namespace
 
 ReplayTransactionLogState::ReplayTransactionLogState(
@@ -194,12 +283,14 @@ ReplayTransactionLogState::ReplayTransactionLogState(
         IReplayConfig &replay_config,
         FeedConfigStore &config_store,
         std::shared_ptr<vespalib::SharedOperationThrottler> shared_replay_throttler,
-        IIncSerialNum& inc_serial_num)
+        IIncSerialNum& inc_serial_num,
+        Executor *deserialize_executor)
     : FeedState(REPLAY_TRANSACTION_LOG),
       _doc_type_name(name),
       _packet_handler(std::make_unique<TransactionLogReplayPacketHandler>(
             feed_view_ptr, bucketDBHandler, replay_config, config_store,
-            std::move(shared_replay_throttler), inc_serial_num))
+            std::move(shared_replay_throttler), inc_serial_num)),
+      _deserialize_executor(deserialize_executor)
 { }
 
 ReplayTransactionLogState::~ReplayTransactionLogState() = default;
@@ -207,7 +298,7 @@ ReplayTransactionLogState::~ReplayTransactionLogState() = default;
 void
 ReplayTransactionLogState::receive(const PacketWrapper::SP &wrap, Executor &executor) {
     executor.execute(makeLambdaTask([this, wrap = wrap] () {
-        PacketDispatcher dispatcher(_packet_handler.get());
+        PacketDispatcher dispatcher(_packet_handler.get(), _deserialize_executor);
         dispatcher.handlePacket(*wrap);
     }));
 }
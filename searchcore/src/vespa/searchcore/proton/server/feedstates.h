@@ -44,10 +44,13 @@ public:
 /**
  * The feed handler is replaying the transaction log.
  * Replayed messages from the transaction log are sent to the active feed view.
+ * If a deserialize executor is given, operations are deserialized in parallel
+ * on it before being sent to the feed view in serial number order.
  */
 class ReplayTransactionLogState : public FeedState {
     std::string _doc_type_name;
     std::unique_ptr<IReplayPacketHandler> _packet_handler;
+    vespalib::Executor *_deserialize_executor;
 
 public:
     ReplayTransactionLogState(const std::string &name,
@@ -56,7 +59,8 @@ public:
             IReplayConfig &replay_config,
             FeedConfigStore &config_store,
             std::shared_ptr<vespalib::SharedOperationThrottler> shared_replay_throttler,
-            IIncSerialNum &inc_serial_num);
+            IIncSerialNum &inc_serial_num,
+            vespalib::Executor *deserialize_executor);
 
     ~ReplayTransactionLogState() override;
     void handleOperation(FeedToken, FeedOperationUP op) override {
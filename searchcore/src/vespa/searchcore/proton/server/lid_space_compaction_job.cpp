@@ -72,14 +72,17 @@ private:
 bool
 CompactionJob::scanDocuments(const LidUsageStats &stats)
 {
-    if (_scanItr->valid()) {
+    // Start moving a batch of documents to limit the per run overhead. The moves are performed
+    // concurrently by the bucket executor, each one targeting the lowest free lid when completed.
+    for (uint32_t i = 0; (i < _cfg.get_max_docs_to_move_per_run()) && _scanItr->valid(); ++i) {
         DocumentMetaData document = getNextDocument(stats);
-        if (document.valid()) {
-            Bucket metaBucket(document::Bucket(_bucketSpace, document.bucketId));
-            _bucketExecutor.execute(metaBucket, std::make_unique<MoveTask>(shared_from_this(), document, getLimiter().beginOperation()));
-            if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
-                return true;
-            }
+        if (!document.valid()) {
+            break;
+        }
+        Bucket metaBucket(document::Bucket(_bucketSpace, document.bucketId));
+        _bucketExecutor.execute(metaBucket, std::make_unique<MoveTask>(shared_from_this(), document, getLimiter().beginOperation()));
+        if (isBlocked(BlockedReason::OUTSTANDING_OPS)) {
+            return true;
         }
     }
     return false;
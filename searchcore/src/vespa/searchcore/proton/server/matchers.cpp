@@ -7,6 +7,7 @@
 #include <vespa/vespalib/util/issue.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
 
 namespace proton {
 
@@ -70,4 +71,12 @@ Matchers::lookup(const std::string &name) const
     return found->second;
 }
 
+std::vector<std::pair<std::string, std::shared_ptr<Matcher>>>
+Matchers::get_all() const
+{
+    std::vector<std::pair<std::string, std::shared_ptr<Matcher>>> result(_rpmap.begin(), _rpmap.end());
+    std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    return result;
+}
+
 } // namespace proton
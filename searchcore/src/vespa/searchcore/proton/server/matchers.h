@@ -32,6 +32,8 @@ public:
     matching::MatchingStats getStats() const;
     matching::MatchingStats getStats(const std::string &name) const;
     std::shared_ptr<matching::Matcher> lookup(const std::string &name) const;
+    // all matchers with their rank profile names, sorted by name
+    std::vector<std::pair<std::string, std::shared_ptr<matching::Matcher>>> get_all() const;
     const search::fef::RankingAssetsRepo& get_ranking_assets_repo() const noexcept { return _ranking_assets_repo; }
 };
 
@@ -0,0 +1,49 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "matchers_explorer.h"
+#include "matchers.h"
+#include <vespa/searchcore/proton/matching/matcher.h>
+#include <vespa/searchcore/proton/matching/query_profile_sampler.h>
+#include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/data/slime/inserter.h>
+
+using proton::matching::QueryProfileSampler;
+using vespalib::slime::Cursor;
+using vespalib::slime::Inserter;
+
+namespace proton {
+
+MatchersExplorer::MatchersExplorer(std::shared_ptr<Matchers> matchers)
+    : _matchers(std::move(matchers))
+{
+}
+
+MatchersExplorer::~MatchersExplorer() = default;
+
+void
+MatchersExplorer::get_state(const Inserter &inserter, bool full) const
+{
+    Cursor &object = inserter.insertObject();
+    Cursor &profiles = object.setObject("profiling");
+    for (const auto &[name, matcher] : _matchers->get_all()) {
+        const QueryProfileSampler *sampler = matcher->getProfileSampler();
+        if (sampler == nullptr) {
+            continue;
+        }
+        auto stats = sampler->get_stats();
+        Cursor &profile = profiles.setObject(name);
+        profile.setLong("sample_interval", sampler->interval());
+        profile.setLong("queries", stats.queries);
+        profile.setLong("samples", stats.samples);
+        profile.setLong("stacks", stats.stacks);
+        profile.setLong("dropped_stacks", stats.dropped);
+        if (full) {
+            Cursor &stacks = profile.setArray("folded_stacks");
+            for (const auto &line : sampler->folded_stacks()) {
+                stacks.addString(line);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,29 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/net/http/state_explorer.h>
+#include <memory>
+
+namespace proton {
+
+class Matchers;
+
+/**
+ * Class used to explore the sampled query profiles of the rank
+ * profiles in a document sub database. The full state contains the
+ * merged profile of each rank profile in folded stack format.
+ */
+class MatchersExplorer : public vespalib::StateExplorer
+{
+private:
+    std::shared_ptr<Matchers> _matchers;
+
+public:
+    explicit MatchersExplorer(std::shared_ptr<Matchers> matchers);
+    ~MatchersExplorer() override;
+
+    void get_state(const vespalib::slime::Inserter &inserter, bool full) const override;
+};
+
+}
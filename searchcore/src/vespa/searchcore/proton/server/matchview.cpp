@@ -58,7 +58,8 @@ MatchView::getMatcher(const std::string & rankProfile) const
 
 MatchContext
 MatchView::createContext() const {
-    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get());
+    uint64_t visibilityGeneration = _docIdLimit.getGeneration();
+    auto searchCtx = std::make_unique<SearchContext>(_indexSearchable, _docIdLimit.get(), visibilityGeneration);
     return {_attrMgr->createContext(), std::move(searchCtx)};
 }
 
@@ -5,6 +5,21 @@
 
 namespace proton {
 
+namespace {
+
+class WriteDoneCallback : public vespalib::IDestructorCallback {
+    std::shared_ptr<OperationDoneContext> _context;
+    feedtoken::WriteStage                 _stage;
+public:
+    WriteDoneCallback(std::shared_ptr<OperationDoneContext> context, feedtoken::WriteStage stage) noexcept
+        : _context(std::move(context)),
+          _stage(stage)
+    {}
+    ~WriteDoneCallback() override { _context->write_done(_stage); }
+};
+
+}
+
 OperationDoneContext::OperationDoneContext(std::shared_ptr<feedtoken::IState> token, std::shared_ptr<vespalib::IDestructorCallback> done_callback)
     : _token(std::move(token)),
       _done_callback(std::move(done_callback))
@@ -19,5 +34,25 @@ OperationDoneContext::is_replay() const
     return (!_token || _token->is_replay());
 }
 
+bool
+OperationDoneContext::tracks_write_stages() const noexcept
+{
+    return (_token && _token->tracks_write_stages());
+}
+
+void
+OperationDoneContext::write_done(feedtoken::WriteStage stage) noexcept
+{
+    _token->write_done(stage);
+}
+
+std::shared_ptr<vespalib::IDestructorCallback>
+make_write_done_callback(std::shared_ptr<OperationDoneContext> context, feedtoken::WriteStage stage)
+{
+    if (!context || !context->tracks_write_stages()) {
+        return context;
+    }
+    return std::make_shared<WriteDoneCallback>(std::move(context), stage);
+}
 
 }  // namespace proton
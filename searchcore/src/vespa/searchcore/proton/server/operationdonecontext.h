@@ -3,8 +3,12 @@
 #pragma once
 
 #include <vespa/vespalib/util/idestructorcallback.h>
+#include <cstdint>
 
-namespace proton::feedtoken { class IState; }
+namespace proton::feedtoken {
+class IState;
+enum class WriteStage : uint8_t;
+}
 
 namespace proton {
 
@@ -22,9 +26,19 @@ public:
 
     ~OperationDoneContext() override;
     bool is_replay() const;
+    bool tracks_write_stages() const noexcept;
+    void write_done(feedtoken::WriteStage stage) noexcept;
 private:
     std::shared_ptr<feedtoken::IState> _token;
     std::shared_ptr<vespalib::IDestructorCallback> _done_callback;
 };
 
+/**
+ * Returns the callback to hand to one writer of a document operation.
+ * If the feed token tracks write stages, the returned callback tells it
+ * when the writer has released the callback, before releasing the context.
+ */
+std::shared_ptr<vespalib::IDestructorCallback>
+make_write_done_callback(std::shared_ptr<OperationDoneContext> context, feedtoken::WriteStage stage);
+
 }  // namespace proton
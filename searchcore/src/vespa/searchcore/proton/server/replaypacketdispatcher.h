@@ -4,6 +4,9 @@
 
 #include "ireplaypackethandler.h"
 #include <vespa/searchlib/transactionlog/common.h>
+#include <memory>
+
+namespace document { class DocumentTypeRepo; }
 
 namespace proton {
 
@@ -19,9 +22,6 @@ private:
     using Packet = search::transactionlog::Packet;
     IReplayPacketHandler &_handler;
 
-    template <typename OperationType>
-    void replay(OperationType &op, vespalib::nbostream &is, const Packet::Entry &entry);
-
 protected:
     virtual void store(const FeedOperation &op);
 
@@ -30,6 +30,19 @@ public:
     virtual ~ReplayPacketDispatcher();
 
     void replayEntry(const Packet::Entry &entry);
+
+    /**
+     * Deserializes a packet entry into a feed operation without replaying it.
+     * This does not touch the handler, and can be called from any thread as
+     * long as the given repo is the one in effect at the entry's serial number.
+     * Config entries must be replayed with replayEntry().
+     */
+    static std::unique_ptr<FeedOperation> deserializeEntry(const Packet::Entry &entry,
+                                                           const document::DocumentTypeRepo &repo);
+    static bool isConfigEntry(const Packet::Entry &entry) noexcept;
+
+    // Replays an operation returned by deserializeEntry().
+    void replayOperation(const FeedOperation &op);
 };
 
 } // namespace proton
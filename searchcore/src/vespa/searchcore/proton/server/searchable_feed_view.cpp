@@ -4,6 +4,7 @@
 #include "forcecommitcontext.h"
 #include "operationdonecontext.h"
 #include "removedonecontext.h"
+#include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchcore/proton/feedoperation/compact_lid_space_operation.h>
 #include <vespa/vespalib/util/isequencedtaskexecutor.h>
 #include <vespa/document/fieldvalue/document.h>
@@ -16,6 +17,7 @@ using document::Document;
 using document::DocumentId;
 using document::DocumentTypeRepo;
 using document::DocumentUpdate;
+using proton::feedtoken::WriteStage;
 using search::index::Schema;
 using storage::spi::BucketInfoResult;
 using storage::spi::Timestamp;
@@ -61,7 +63,7 @@ SearchableFeedView::performIndexPut(SerialNum serialNum, search::DocumentIdT lid
          "database(%s): performIndexPut: serialNum(%" PRIu64 "), docId(%s), lid(%d)",
          _params._docTypeName.toString().c_str(), serialNum, doc.getId().toString().c_str(), lid);
 
-    _indexWriter->put(serialNum, doc, lid, onWriteDone);
+    _indexWriter->put(serialNum, doc, lid, make_write_done_callback(onWriteDone, WriteStage::MEMORY_INDEX));
 }
 
 void
@@ -190,6 +190,7 @@ SearchableDocSubDB::propagateFlushConfig()
 {
     uint32_t maxFlushed = is_node_retired_or_maintenance() ? _flushConfig.getMaxFlushedRetired() : _flushConfig.getMaxFlushed();
     _indexMgr->setMaxFlushed(maxFlushed);
+    _indexMgr->setFusionSizeRatio(_flushConfig.getFusionSizeRatio(), _flushConfig.getMaxFlushedDeferred());
 }
 
 void
@@ -336,6 +337,12 @@ SearchableDocSubDB::getMatcherStats(const std::string &rankProfile) const
     return _rSearchView.get()->getMatcherStats(rankProfile);
 }
 
+std::shared_ptr<Matchers>
+SearchableDocSubDB::getMatchers() const
+{
+    return _rSearchView.get()->getMatchers();
+}
+
 void
 SearchableDocSubDB::close()
 {
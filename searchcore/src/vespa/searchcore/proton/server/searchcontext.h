@@ -19,13 +19,16 @@ private:
     std::shared_ptr<IndexSearchable>  _indexSearchable;
     search::AttributeBlueprintFactory _attributeBlueprintFactory;
     uint32_t                          _docIdLimit;
+    uint64_t                          _visibilityGeneration;
 
     IndexSearchable &getIndexes() override;
     Searchable &getAttributes() override;
     uint32_t getDocIdLimit() override;
+    uint64_t getVisibilityGeneration() override;
 
 public:
-    SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit);
+    SearchContext(const std::shared_ptr<IndexSearchable> &indexSearchable, uint32_t docIdLimit,
+                  uint64_t visibilityGeneration);
     ~SearchContext() override;
 };
 
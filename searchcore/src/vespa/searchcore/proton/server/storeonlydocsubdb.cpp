@@ -564,6 +564,12 @@ StoreOnlyDocSubDB::getMatcherStats(const std::string &rankProfile) const
     return {};
 }
 
+std::shared_ptr<Matchers>
+StoreOnlyDocSubDB::getMatchers() const
+{
+    return {};
+}
+
 void
 StoreOnlyDocSubDB::close()
 {
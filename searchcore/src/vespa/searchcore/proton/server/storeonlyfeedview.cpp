@@ -7,6 +7,7 @@
 #include "removedonecontext.h"
 #include "updatedonecontext.h"
 #include <vespa/searchcore/proton/attribute/ifieldupdatecallback.h>
+#include <vespa/searchcore/proton/common/feedtoken.h>
 #include <vespa/searchcore/proton/feedoperation/operations.h>
 #include <vespa/searchcore/proton/reference/i_gid_to_lid_change_handler.h>
 #include <vespa/searchcore/proton/reference/i_pending_gid_to_lid_changes.h>
@@ -29,6 +30,7 @@ using document::DocumentTypeRepo;
 using document::DocumentUpdate;
 using document::GlobalId;
 using proton::documentmetastore::LidReuseDelayer;
+using proton::feedtoken::WriteStage;
 using search::SerialNum;
 using search::index::Schema;
 using storage::spi::BucketInfoResult;
@@ -365,7 +367,8 @@ StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid,
                               FutureStream futureStream, const OnOperationDoneType& onDone)
 {
     summaryExecutor().execute(
-            makeLambdaTask([serialNum, lid, futureStream = std::move(futureStream), trackerToken = _pendingLidsForDocStore.produce(lid), onDone, this] () mutable {
+            makeLambdaTask([serialNum, lid, futureStream = std::move(futureStream), trackerToken = _pendingLidsForDocStore.produce(lid),
+                            onDone = make_write_done_callback(onDone, WriteStage::DOCUMENT_STORE), this] () mutable {
                 (void) onDone;
                 (void) trackerToken;
                 vespalib::nbostream os = futureStream.get();
@@ -390,7 +393,8 @@ void
 StoreOnlyFeedView::putSummary(SerialNum serialNum, Lid lid, Document::SP doc, const OnOperationDoneType& onDone)
 {
     summaryExecutor().execute(
-            makeLambdaTask([serialNum, doc = std::move(doc), trackerToken = _pendingLidsForDocStore.produce(lid), onDone, lid, this] {
+            makeLambdaTask([serialNum, doc = std::move(doc), trackerToken = _pendingLidsForDocStore.produce(lid),
+                            onDone = make_write_done_callback(onDone, WriteStage::DOCUMENT_STORE), lid, this] {
                 (void) onDone;
                 (void) trackerToken;
                 _summaryAdapter->put(serialNum, lid, *doc);
@@ -463,6 +467,8 @@ StoreOnlyFeedView::internalUpdate(FeedToken token, const UpdateOperation &updOp)
     UpdateScope updateScope(_indexedFields, upd);
     updateAttributes(serialNum, lid, upd, onWriteDone, updateScope);
 
+    // Updates only touching attributes that are updateable in memory only neither read nor write
+    // the document store. Document summaries and gets use the attributes for those fields.
     if (updateScope.hasIndexOrNonAttributeFields()) {
         PromisedDoc promisedDoc;
         FutureDoc futureDoc = promisedDoc.get_future().share();
@@ -619,7 +625,7 @@ StoreOnlyFeedView::internalRemove(FeedToken token, std::shared_ptr<IDestructorCa
 {
     _lidReuseDelayer.delayReuse(lid);
     auto onWriteDone = createRemoveDoneContext(std::move(token), std::move(done_callback), std::move(uncommitted));
-    removeSummary(serialNum, lid, onWriteDone);
+    removeSummary(serialNum, lid, make_write_done_callback(onWriteDone, WriteStage::DOCUMENT_STORE));
     removeAttributes(serialNum, lid, onWriteDone);
     removeIndexedFields(serialNum, lid, onWriteDone);
 }
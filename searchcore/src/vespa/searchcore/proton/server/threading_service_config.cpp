@@ -11,11 +11,13 @@ using OptimizeFor = vespalib::Executor::OptimizeFor;
 
 
 ThreadingServiceConfig::ThreadingServiceConfig(uint32_t master_task_limit_,
+                                               const AdaptiveMasterTaskLimitConfig& adaptive_master_task_limit_,
                                                int32_t defaultTaskLimit_,
                                                OptimizeFor optimize_,
                                                uint32_t kindOfWatermark_,
                                                vespalib::duration reactionTime_)
     : _master_task_limit(master_task_limit_),
+      _adaptive_master_task_limit(adaptive_master_task_limit_),
       _defaultTaskLimit(std::abs(defaultTaskLimit_)),
       _is_task_limit_hard(defaultTaskLimit_ >= 0),
       _optimize(optimize_),
@@ -37,12 +39,19 @@ selectOptimization(ProtonConfig::Indexing::Optimize optimize) {
     return OptimizeFor::LATENCY;
 }
 
+AdaptiveMasterTaskLimitConfig
+make_adaptive_master_task_limit_config(const ProtonConfig::Feeding::AdaptiveMasterTaskLimit& cfg)
+{
+    return AdaptiveMasterTaskLimitConfig(cfg.enabled, cfg.min, cfg.max, cfg.targetLatency, cfg.maxSaturation);
+}
+
 }
 
 ThreadingServiceConfig
 ThreadingServiceConfig::make(const ProtonConfig& cfg)
 {
     return ThreadingServiceConfig(cfg.feeding.masterTaskLimit,
+                                  make_adaptive_master_task_limit_config(cfg.feeding.adaptiveMasterTaskLimit),
                                   cfg.indexing.tasklimit,
                                   selectOptimization(cfg.indexing.optimize),
                                   cfg.indexing.kindOfWatermark,
@@ -51,13 +60,14 @@ ThreadingServiceConfig::make(const ProtonConfig& cfg)
 
 ThreadingServiceConfig
 ThreadingServiceConfig::make() {
-    return ThreadingServiceConfig(0, 100, OptimizeFor::LATENCY, 0, 10ms);
+    return ThreadingServiceConfig(0, AdaptiveMasterTaskLimitConfig(), 100, OptimizeFor::LATENCY, 0, 10ms);
 }
 
 void
 ThreadingServiceConfig::update(const ThreadingServiceConfig& cfg)
 {
     _master_task_limit = cfg._master_task_limit;
+    _adaptive_master_task_limit = cfg._adaptive_master_task_limit;
     _defaultTaskLimit = cfg._defaultTaskLimit;
 }
 
@@ -65,6 +75,7 @@ bool
 ThreadingServiceConfig::operator==(const ThreadingServiceConfig &rhs) const
 {
     return _master_task_limit == rhs._master_task_limit &&
+        _adaptive_master_task_limit == rhs._adaptive_master_task_limit &&
         _defaultTaskLimit == rhs._defaultTaskLimit &&
         _is_task_limit_hard == rhs._is_task_limit_hard &&
         _optimize == rhs._optimize &&
@@ -1,6 +1,7 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 #pragma once
 
+#include "adaptive_master_task_limit.h"
 #include <vespa/config-proton.h>
 #include <vespa/vespalib/util/executor.h>
 #include <vespa/vespalib/util/hw_info.h>
@@ -20,6 +21,7 @@ public:
 
 private:
     uint32_t           _master_task_limit;
+    AdaptiveMasterTaskLimitConfig _adaptive_master_task_limit;
     uint32_t           _defaultTaskLimit;
     bool               _is_task_limit_hard;
     OptimizeFor        _optimize;
@@ -27,14 +29,15 @@ private:
     vespalib::duration _reactionTime;         // Maximum reaction time to new tasks
 
 private:
-    ThreadingServiceConfig(uint32_t master_task_limit_, int32_t defaultTaskLimit_,
-                           OptimizeFor optimize_, uint32_t kindOfWatermark_, vespalib::duration reactionTime_);
+    ThreadingServiceConfig(uint32_t master_task_limit_, const AdaptiveMasterTaskLimitConfig& adaptive_master_task_limit_,
+                           int32_t defaultTaskLimit_, OptimizeFor optimize_, uint32_t kindOfWatermark_, vespalib::duration reactionTime_);
 
 public:
     static ThreadingServiceConfig make(const ProtonConfig& cfg);
     static ThreadingServiceConfig make();
     void update(const ThreadingServiceConfig& cfg);
     uint32_t master_task_limit() const { return _master_task_limit; }
+    const AdaptiveMasterTaskLimitConfig& adaptive_master_task_limit() const { return _adaptive_master_task_limit; }
     uint32_t defaultTaskLimit() const { return _defaultTaskLimit; }
     bool is_task_limit_hard() const { return _is_task_limit_hard; }
     OptimizeFor optimize() const { return _optimize; }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include <vespa/searchlib/common/serialnum.h>
+#include <vespa/vespalib/util/time.h>
 #include <atomic>
 #include <memory>
 #include <string>
@@ -16,6 +17,7 @@ private:
     const search::SerialNum _first;
     const search::SerialNum _last;
     std::atomic<search::SerialNum> _current;
+    const vespalib::steady_time _start_time;
 
 public:
     using UP = std::unique_ptr<TlsReplayProgress>;
@@ -26,7 +28,8 @@ public:
         : _domainName(domainName),
           _first(first),
           _last(last),
-          _current(first)
+          _current(first),
+          _start_time(vespalib::steady_clock::now())
     {
     }
     const std::string &getDomainName() const noexcept { return _domainName; }
@@ -40,6 +43,10 @@ public:
             return ((float)(getCurrent() - _first)/float(_last - _first));
         }
     }
+    double getOperationsPerSecond() const noexcept {
+        double elapsed = vespalib::to_s(vespalib::steady_clock::now() - _start_time);
+        return (elapsed > 0.0) ? (getCurrent() - _first) / elapsed : 0.0;
+    }
     void updateCurrent(search::SerialNum current) noexcept { _current.store(current, std::memory_order_relaxed); }
 };
 
@@ -29,7 +29,9 @@ struct MockIndexManager : public searchcorespi::IIndexManager
     void heartBeat(SerialNum) override {}
     void compactLidSpace(uint32_t, SerialNum) override {}
     void setMaxFlushed(uint32_t) override { }
+    void setFusionSizeRatio(double, uint32_t) override { }
     bool has_pending_urgent_flush() const override { return false; }
+    std::shared_ptr<const search::diskindex::FusionProgress> get_fusion_progress() const override { return {}; }
 };
 
 }
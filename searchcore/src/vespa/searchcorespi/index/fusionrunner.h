@@ -52,12 +52,14 @@ public:
      * @param fusion_spec the specification on which indexes to run fusion on.
      * @param lastSerialNum the serial number of the last flushed index part of the fusion spec.
      * @param operations interface used for running the actual fusion.
+     * @param progress where per field progress is reported, if set.
      * @return the id of the fusioned disk index
      **/
     uint32_t fuse(const FusionSpec &fusion_spec,
                   search::SerialNum lastSerialNum,
                   IIndexMaintainerOperations &operations,
-                  std::shared_ptr<search::IFlushToken> flush_token);
+                  std::shared_ptr<search::IFlushToken> flush_token,
+                  std::shared_ptr<search::diskindex::FusionProgress> progress = {});
 };
 
 }  // namespace index
@@ -9,6 +9,7 @@
 #include <vespa/searchlib/index/i_field_length_inspector.h>
 
 namespace search { class IFlushToken; }
+namespace search::diskindex { class FusionProgress; }
 
 namespace searchcorespi::index {
 
@@ -49,13 +50,15 @@ struct IIndexMaintainerOperations {
      * @param sources the directories of the input disk indexes.
      * @param selectorArray the array specifying in which input disk index a document is located.
      * @param lastSerialNum the serial number of the last operation in the last input disk index.
+     * @param progress where per field progress is reported, if set.
      */
     virtual bool runFusion(const Schema &schema,
                            const std::string &outputDir,
                            const std::vector<std::string> &sources,
                            const SelectorArray &selectorArray,
                            search::SerialNum lastSerialNum,
-                           std::shared_ptr<search::IFlushToken> flush_token) = 0;
+                           std::shared_ptr<search::IFlushToken> flush_token,
+                           std::shared_ptr<search::diskindex::FusionProgress> progress) = 0;
 };
 
 }
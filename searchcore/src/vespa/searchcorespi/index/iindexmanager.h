@@ -9,6 +9,7 @@
 
 namespace vespalib { class IDestructorCallback; }
 namespace document { class Document; }
+namespace search::diskindex { class FusionProgress; }
 
 namespace searchcorespi {
 
@@ -201,6 +202,16 @@ public:
      */
     virtual void setMaxFlushed(uint32_t maxFlushed) = 0;
 
+    /*
+     * Sets the policy for deferring fusion when the flushed indexes are
+     * small compared to the fused index.
+     *
+     * @param sizeRatio          Fusion is not urgent due to max flushed while the flushed indexes
+     *                           are smaller than this fraction of the fused index. 0.0 disables deferring.
+     * @param maxFlushedDeferred The max number of flushed indexes before fusion is urgent while deferred.
+     */
+    virtual void setFusionSizeRatio(double sizeRatio, uint32_t maxFlushedDeferred) = 0;
+
     /**
      * Checks if we have a pending urgent flush due to a recent
      * schema change (e.g. regeneration of interleaved features in
@@ -209,6 +220,13 @@ public:
      * @return whether an urgent flush is pending
      */
     virtual bool has_pending_urgent_flush() const = 0;
+
+    /**
+     * Returns the per field progress of the running fusion, or of the
+     * last fusion if none is running. Returns nullptr if no fusion has
+     * been run.
+     */
+    virtual std::shared_ptr<const search::diskindex::FusionProgress> get_fusion_progress() const = 0;
 };
 
 } // namespace searchcorespi
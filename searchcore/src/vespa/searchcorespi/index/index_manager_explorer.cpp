@@ -4,11 +4,13 @@
 #include "index_manager_stats.h"
 #include <vespa/searchcorespi/index/imemoryindex.h>
 #include <vespa/searchcorespi/index/indexsearchablevisitor.h>
+#include <vespa/searchlib/diskindex/fusion_progress.h>
 #include <vespa/vespalib/data/slime/cursor.h>
 
 using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
 using search::IndexStats;
+using search::diskindex::FusionProgress;
 using searchcorespi::index::DiskIndexStats;
 using searchcorespi::index::MemoryIndexStats;
 
@@ -52,6 +54,29 @@ insertMemoryIndex(Cursor &arrayCursor, const MemoryIndexStats &memoryIndex)
     insertMemoryUsage(memoryIndexCursor, sstats.memoryUsage());
 }
 
+void
+insertFusionProgress(Cursor &object, const FusionProgress &progress)
+{
+    Cursor &fusion = object.setObject("fusion");
+    auto now = vespalib::steady_clock::now();
+    fusion.setDouble("elapsed_s", vespalib::to_s(now - progress.get_start_time()));
+    Cursor &fields = fusion.setArray("fields");
+    for (const auto &field_progress : progress.get_fields()) {
+        if (field_progress.name.empty()) {
+            continue;
+        }
+        Cursor &field = fields.addObject();
+        field.setString("name", field_progress.name);
+        field.setString("state", FusionProgress::state_name(field_progress.state));
+        field.setLong("input_size", field_progress.input_size);
+        field.setLong("words", field_progress.num_words);
+        field.setLong("merged_words", field_progress.merged_words);
+        double elapsed = vespalib::to_s(field_progress.elapsed(now));
+        field.setDouble("elapsed_s", elapsed);
+        field.setDouble("merged_words_per_s", (elapsed > 0.0) ? (field_progress.merged_words / elapsed) : 0.0);
+    }
+}
+
 class WriteContextInserter : public IndexSearchableVisitor {
 private:
     Cursor& _object;
@@ -91,6 +116,10 @@ IndexManagerExplorer::get_state(const Inserter &inserter, bool full) const
         for (const auto &memoryIndex : stats.getMemoryIndexes()) {
             insertMemoryIndex(memoryIndexArrayCursor, memoryIndex);
         }
+        auto fusion_progress = _mgr->get_fusion_progress();
+        if (fusion_progress) {
+            insertFusionProgress(object, *fusion_progress);
+        }
         auto& write_contexts = object.setObject("write_contexts");
         WriteContextInserter visitor(write_contexts);
         _mgr->getSearchable()->accept(visitor);
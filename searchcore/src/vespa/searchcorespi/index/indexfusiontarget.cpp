@@ -69,7 +69,8 @@ IndexFusionTarget::getApproxDiskGain() const
 bool
 IndexFusionTarget::needUrgentFlush() const
 {
-    bool urgent = (_fusionStats.numUnfused > _fusionStats.maxFlushed || _indexMaintainer.urgent_disk_index_fusion()) &&
+    bool tooManyFlushed = (_fusionStats.numUnfused > _fusionStats.maxFlushed) && !_fusionStats.deferFusion();
+    bool urgent = (tooManyFlushed || _indexMaintainer.urgent_disk_index_fusion()) &&
                   (_fusionStats._canRunFusion);
     LOG(debug, "Num flushed: %d Urgent: %d", _fusionStats.numUnfused, urgent);
     return urgent;
@@ -15,6 +15,7 @@
 #include <vespa/document/fieldvalue/document.h>
 #include <vespa/searchcorespi/flush/lambdaflushtask.h>
 #include <vespa/searchlib/common/i_flush_token.h>
+#include <vespa/searchlib/diskindex/fusion_progress.h>
 #include <vespa/searchlib/queryeval/blueprint.h>
 #include <vespa/searchlib/index/schemautil.h>
 #include <vespa/searchlib/util/filekit.h>
@@ -36,6 +37,7 @@ using search::TuneFileAttributes;
 using search::index::Schema;
 using search::index::SchemaUtil;
 using search::common::FileHeaderContext;
+using search::diskindex::FusionProgress;
 using search::queryeval::ISourceSelector;
 using search::queryeval::Source;
 using search::queryeval::Blueprint;
@@ -880,8 +882,11 @@ IndexMaintainer::IndexMaintainer(const IndexMaintainerConfig &config,
       _new_search_lock(),
       _remove_lock(std::make_shared<std::mutex>()),
       _fusion_spec(),
+      _fusion_progress(),
       _fusion_lock(),
       _maxFlushed(config.getMaxFlushed()),
+      _fusionSizeRatio(0.0),
+      _maxFlushedDeferred(0),
       _maxFrozen(10),
       _changeGens(),
       _schemaUpdateLock(),
@@ -1070,8 +1075,13 @@ IndexMaintainer::runFusion(const FusionSpec &fusion_spec, std::shared_ptr<search
     }
     IndexDiskDir fusion_index_disk_dir(fusion_spec.flush_ids.back(), true);
     RemoveFusionIndexGuard remove_fusion_index_guard(*_disk_indexes, fusion_index_disk_dir);
+    auto progress = std::make_shared<FusionProgress>();
+    {
+        LockGuard lock(_fusion_lock);
+        _fusion_progress = progress;
+    }
     FusionRunner fusion_runner(_base_dir, args._schema, tuneFileAttributes, _ctx.getFileHeaderContext());
-    uint32_t new_fusion_id = fusion_runner.fuse(fusion_spec, serialNum, _operations, flush_token);
+    uint32_t new_fusion_id = fusion_runner.fuse(fusion_spec, serialNum, _operations, flush_token, std::move(progress));
     bool ok = (new_fusion_id != 0);
     if (ok) {
         ok = IndexWriteUtilities::copySerialNumFile(getFlushDir(fusion_spec.flush_ids.back()),
@@ -1178,19 +1188,44 @@ IndexMaintainer::getFusionStats() const
     // Called by flush engine scheduler thread (from getFlushTargets())
     FusionStats stats;
     std::shared_ptr<IndexSearchable> source_list;
+    std::shared_ptr<ISearchableIndexCollection> leaf;
 
     {
         LockGuard lock(_new_search_lock);
         source_list = _source_list;
         stats.maxFlushed = _maxFlushed;
+        stats.fusionSizeRatio = _fusionSizeRatio;
+        stats.maxFlushedDeferred = _maxFlushedDeferred;
+        if (stats.fusionSizeRatio > 0.0) {
+            leaf = getLeaf(lock, _source_list);
+        }
     }
     stats.diskUsage = source_list->get_index_stats(false).sizeOnDisk();
+    std::string fusionDir;
     {
         LockGuard guard(_fusion_lock);
         stats.numUnfused = _fusion_spec.flush_ids.size() + ((_fusion_spec.last_fusion_id != 0) ? 1 : 0);
+        stats.numFlushed = _fusion_spec.flush_ids.size();
         stats._canRunFusion = canRunFusion(_fusion_spec);
+        if (leaf && (_fusion_spec.last_fusion_id != 0)) {
+            fusionDir = getFusionDir(_fusion_spec.last_fusion_id);
+        }
     }
-    LOG(debug, "Get fusion stats. Disk usage: %" PRIu64 ", maxflushed: %d", stats.diskUsage, stats.maxFlushed);
+    if (leaf) {
+        for (uint32_t i = 0; i < leaf->getSourceCount(); ++i) {
+            const auto *diskIndex = dynamic_cast<const IDiskIndex *>(&leaf->getSearchable(i));
+            if (diskIndex == nullptr) {
+                continue; // memory index
+            }
+            uint64_t sizeOnDisk = diskIndex->get_index_stats(false).sizeOnDisk();
+            if (!fusionDir.empty() && (diskIndex->getIndexDir() == fusionDir)) {
+                stats.fusedDiskUsage += sizeOnDisk;
+            } else {
+                stats.unfusedDiskUsage += sizeOnDisk;
+            }
+        }
+    }
+    LOG(debug, "Get fusion stats. Disk usage: %" PRIu64 ", flushed: %u, maxflushed: %u", stats.diskUsage, stats.numFlushed, stats.maxFlushed);
     return stats;
 }
 
@@ -1341,6 +1376,14 @@ IndexMaintainer::setMaxFlushed(uint32_t maxFlushed)
     _maxFlushed = maxFlushed;
 }
 
+void
+IndexMaintainer::setFusionSizeRatio(double sizeRatio, uint32_t maxFlushedDeferred)
+{
+    LockGuard lock(_new_search_lock);
+    _fusionSizeRatio = sizeRatio;
+    _maxFlushedDeferred = maxFlushedDeferred;
+}
+
 void
 IndexMaintainer::consider_urgent_flush(const Schema& old_schema, const Schema& new_schema, uint32_t flush_id)
 {
@@ -1415,4 +1458,11 @@ IndexMaintainer::has_pending_urgent_flush() const
     return urgent_flush_id > _fusion_spec.last_fusion_id;
 }
 
+std::shared_ptr<const FusionProgress>
+IndexMaintainer::get_fusion_progress() const
+{
+    LockGuard lock(_fusion_lock);
+    return _fusion_progress;
+}
+
 }
@@ -131,8 +131,11 @@ class IndexMaintainer : public IIndexManager,
     mutable std::mutex               _new_search_lock;   // Inner lock (NSL)
     std::shared_ptr<std::mutex>      _remove_lock;       // Lock for removing indexes.
     FusionSpec                       _fusion_spec;       // Protected by FL
+    std::shared_ptr<const search::diskindex::FusionProgress> _fusion_progress; // Protected by FL
     mutable std::mutex               _fusion_lock;       // Fusion spec lock (FL)
     uint32_t                         _maxFlushed;        // Protected by NSL
+    double                           _fusionSizeRatio;   // Protected by NSL
+    uint32_t                         _maxFlushedDeferred;// Protected by NSL
     const uint32_t                   _maxFrozen;
     ChangeGens                       _changeGens;        // Protected by SL + IUL
     std::mutex                       _schemaUpdateLock;  // Serialize rewrite of schema
@@ -313,14 +316,33 @@ public:
     struct FusionStats {
         FusionStats()
             : diskUsage(0),
+              fusedDiskUsage(0),
+              unfusedDiskUsage(0),
               maxFlushed(0),
               numUnfused(0),
+              numFlushed(0),
+              fusionSizeRatio(0.0),
+              maxFlushedDeferred(0),
               _canRunFusion(false)
         { }
 
+        /**
+         * Returns true if fusion should wait for more flushed indexes since
+         * they are small compared to the fused index.
+         */
+        bool deferFusion() const noexcept {
+            return (fusionSizeRatio > 0.0) && (fusedDiskUsage > 0) && (numFlushed <= maxFlushedDeferred) &&
+                   (unfusedDiskUsage < fusionSizeRatio * fusedDiskUsage);
+        }
+
         uint64_t diskUsage;
+        uint64_t fusedDiskUsage;
+        uint64_t unfusedDiskUsage;
         uint32_t maxFlushed;
-        uint32_t numUnfused;
+        uint32_t numUnfused;        // flushed indexes plus the fused index, if any
+        uint32_t numFlushed;        // flushed indexes not yet fused
+        double   fusionSizeRatio;
+        uint32_t maxFlushedDeferred;
         bool _canRunFusion;
     };
 
@@ -368,12 +390,14 @@ public:
     IFlushTarget::List getFlushTargets() override;
     void setSchema(const Schema & schema, SerialNum serialNum) override ;
     void setMaxFlushed(uint32_t maxFlushed) override;
+    void setFusionSizeRatio(double sizeRatio, uint32_t maxFlushedDeferred) override;
     void consider_urgent_flush(const Schema& old_schema, const Schema& new_schema, uint32_t flush_id);
     void consider_initial_urgent_flush();
     uint32_t get_urgent_flush_id() const;
     bool urgent_memory_index_flush() const;
     bool urgent_disk_index_fusion() const;
     bool has_pending_urgent_flush() const override;
+    std::shared_ptr<const search::diskindex::FusionProgress> get_fusion_progress() const override;
 };
 
 }
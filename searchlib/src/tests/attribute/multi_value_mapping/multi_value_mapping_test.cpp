@@ -372,4 +372,37 @@ TEST_F(CompactionIntMappingTest, test_that_compaction_works)
     EXPECT_LT(bufferCountAfter, bufferCountBefore);
 }
 
+TEST_F(CompactionIntMappingTest, test_that_compaction_can_be_spread_over_multiple_steps)
+{
+    setup(3, 64, 512, 129);
+    uint32_t addDocs = 10;
+    uint32_t bufferCountBefore = 0;
+    do {
+        addRandomDocs(addDocs);
+        addDocs *= 2;
+        bufferCountBefore = countBuffers();
+    } while (bufferCountBefore < 10);
+    uint32_t docIdLimit = size();
+    // Leave live values in all buffers, forcing compaction to move values
+    for (uint32_t docId = 0; docId < docIdLimit; docId += 3) {
+        clearDoc(docId);
+    }
+    CompactionStrategy compaction_strategy(0.05, 0.2, 1, 0.1, 16);
+    _mvMapping->set_compaction_spec(CompactionSpec(true, false));
+    _mvMapping->compact_worst(compaction_strategy);
+    uint32_t steps = 1;
+    while (_mvMapping->is_compacting()) {
+        // Feed is interleaved with compaction steps
+        addRandomDoc();
+        clearDoc(docIdLimit - 1 - 3 * steps);
+        EXPECT_TRUE(_mvMapping->consider_compact(compaction_strategy));
+        _attr->commit();
+        _attr->incGeneration();
+        ++steps;
+    }
+    LOG(info, "Compaction completed in %u steps", steps);
+    EXPECT_LT(1u, steps);
+    checkRefMapping();
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
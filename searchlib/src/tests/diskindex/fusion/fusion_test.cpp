@@ -8,6 +8,7 @@
 #include <vespa/document/repo/configbuilder.h>
 #include <vespa/searchlib/common/flush_token.h>
 #include <vespa/searchlib/diskindex/diskindex.h>
+#include <vespa/searchlib/diskindex/fusion_progress.h>
 #include <vespa/searchlib/diskindex/indexbuilder.h>
 #include <vespa/searchlib/diskindex/zcposoccrandread.h>
 #include <vespa/searchlib/fef/fieldpositionsiterator.h>
@@ -28,6 +29,7 @@
 #include <vespa/vespalib/util/threadstackexecutor.h>
 #include <vespa/vespalib/util/sequencedtaskexecutor.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <algorithm>
 #include <filesystem>
 
 #include <vespa/log/log.h>
@@ -78,7 +80,8 @@ protected:
 
     void requireThatFusionIsWorking(const std::string &prefix, bool directio, bool readmmap, bool force_short_merge_chunk);
     void make_simple_index(const std::string &dump_dir, const IFieldLengthInspector &field_length_inspector);
-    bool try_merge_simple_indexes(const std::string &dump_dir, const std::vector<std::string> &sources, std::shared_ptr<IFlushToken> flush_token);
+    bool try_merge_simple_indexes(const std::string &dump_dir, const std::vector<std::string> &sources, std::shared_ptr<IFlushToken> flush_token,
+                                  std::shared_ptr<FusionProgress> progress = {});
     void merge_simple_indexes(const std::string &dump_dir, const std::vector<std::string> &sources);
     void reconstruct_interleaved_features();
 public:
@@ -472,7 +475,8 @@ FusionTest::make_simple_index(const std::string &dump_dir, const IFieldLengthIns
 }
 
 bool
-FusionTest::try_merge_simple_indexes(const std::string &dump_dir, const std::vector<std::string> &sources, std::shared_ptr<IFlushToken> flush_token)
+FusionTest::try_merge_simple_indexes(const std::string &dump_dir, const std::vector<std::string> &sources, std::shared_ptr<IFlushToken> flush_token,
+                                     std::shared_ptr<FusionProgress> progress)
 {
     vespalib::ThreadStackExecutor executor(4);
     TuneFileIndexing tuneFileIndexing;
@@ -480,6 +484,7 @@ FusionTest::try_merge_simple_indexes(const std::string &dump_dir, const std::vec
     SelectorArray selector(20, 0);
     Fusion fusion(_schema, dump_dir, sources, selector, tuneFileIndexing, fileHeaderContext);
     fusion.set_force_small_merge_chunk(_force_small_merge_chunk);
+    fusion.set_progress(std::move(progress));
     return fusion.merge(executor, flush_token);
 }
 
@@ -625,6 +630,33 @@ TEST_F(FusionTest, require_that_fusion_can_be_stopped)
     clean_stopped_fusion_testdirs();
 }
 
+TEST_F(FusionTest, require_that_fusion_progress_is_reported_per_field)
+{
+    clean_stopped_fusion_testdirs();
+    make_simple_index("stopdump2", MockFieldLengthInspector());
+    auto progress = std::make_shared<FusionProgress>();
+    ASSERT_TRUE(try_merge_simple_indexes("stopdump3", {"stopdump2"}, std::make_shared<FlushToken>(), progress));
+    auto fields = progress->get_fields();
+    ASSERT_EQ(_schema.getNumIndexFields(), fields.size());
+    uint64_t total_words = 0;
+    for (uint32_t id = 0; id < fields.size(); ++id) {
+        const auto& field = fields[id];
+        EXPECT_EQ(_schema.getIndexField(id).getName(), field.name);
+        EXPECT_EQ(FusionProgress::State::DONE, field.state);
+        EXPECT_EQ(field.num_words, field.merged_words);
+        EXPECT_LT(0u, field.input_size);
+        total_words += field.num_words;
+    }
+    EXPECT_LT(0u, total_words);
+    std::filesystem::remove_all(std::filesystem::path("stopdump3"));
+    progress = std::make_shared<FusionProgress>();
+    ASSERT_FALSE(try_merge_simple_indexes("stopdump3", {"stopdump2"}, std::make_shared<MyFlushToken>(1), progress));
+    fields = progress->get_fields();
+    EXPECT_TRUE(std::any_of(fields.begin(), fields.end(),
+                            [](auto& field) { return field.state != FusionProgress::State::DONE; }));
+    clean_stopped_fusion_testdirs();
+}
+
 }
 
 }
@@ -0,0 +1,36 @@
+# Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+import onnx
+from onnx import helper, TensorProto
+
+IN1 = helper.make_tensor_value_info('in1', TensorProto.FLOAT, ['batch', 2])
+IN2 = helper.make_tensor_value_info('in2', TensorProto.FLOAT, ['batch', 2])
+SUM = helper.make_tensor_value_info('sum', TensorProto.FLOAT, ['batch', 2])
+PROD = helper.make_tensor_value_info('prod', TensorProto.FLOAT, ['batch', 2])
+
+nodes = [
+    helper.make_node(
+        'Add',
+        ['in1', 'in2'],
+        ['sum'],
+    ),
+    helper.make_node(
+        'Mul',
+        ['in1', 'in2'],
+        ['prod'],
+    ),
+]
+graph_def = helper.make_graph(
+    nodes,
+    'batched',
+    [
+        IN1,
+        IN2,
+    ],
+    [
+        SUM,
+        PROD,
+    ],
+)
+model_def = helper.make_model(graph_def, producer_name='batched.py', opset_imports=[onnx.OperatorSetIdProto(version=12)])
+model_def.ir_version = 7
+onnx.save(model_def, 'batched.onnx')
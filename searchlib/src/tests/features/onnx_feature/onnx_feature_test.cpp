@@ -11,7 +11,11 @@
 #include <vespa/searchlib/fef/test/queryenvironment.h>
 #include <vespa/searchlib/fef/rank_program.h>
 #include <vespa/searchlib/test/test_features.h>
+#include <vespa/eval/eval/fast_value.h>
+#include <vespa/eval/eval/value_codec.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <vespa/vespalib/objects/nbostream.h>
+#include <vespa/vespalib/util/execution_profiler.h>
 #include <string>
 
 using namespace search::fef;
@@ -31,6 +35,7 @@ std::string simple_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper
 std::string dynamic_model = vespa_dir + "/" + "eval/src/tests/tensor/onnx_wrapper/dynamic.onnx";
 std::string strange_names_model = source_dir + "/" + "strange_names.onnx";
 std::string fragile_model = source_dir + "/" + "fragile.onnx";
+std::string batched_model = source_dir + "/" + "batched.onnx";
 
 uint32_t default_docid = 1;
 
@@ -46,22 +51,23 @@ std::string onnx_feature_old(const std::string &name) {
     return fmt("onnxModel(%s)", name.c_str());
 }
 
-struct OnnxFeatureTest : ::testing::Test {
+struct OnnxFeatureFixture {
     BlueprintFactory factory;
     IndexEnvironment indexEnv;
     BlueprintResolver::SP resolver;
     Properties overrides;
     MatchData::UP match_data;
     RankProgram program;
-    OnnxFeatureTest() : factory(), indexEnv(), resolver(new BlueprintResolver(factory, indexEnv)),
-                        overrides(), match_data(), program(resolver)
+    vespalib::ExecutionProfiler *profiler;
+    OnnxFeatureFixture() : factory(), indexEnv(), resolver(new BlueprintResolver(factory, indexEnv)),
+                           overrides(), match_data(), program(resolver), profiler(nullptr)
     {
         factory.addPrototype(std::make_shared<DocidBlueprint>());
         factory.addPrototype(std::make_shared<RankingExpressionBlueprint>());
         factory.addPrototype(std::make_shared<OnnxBlueprint>("onnx"));
         factory.addPrototype(std::make_shared<OnnxBlueprint>("onnxModel"));
     }
-    ~OnnxFeatureTest() override;
+    ~OnnxFeatureFixture();
     void add_expr(const std::string &name, const std::string &expr) {
         std::string feature_name = expr_feature(name);
         std::string expr_name = feature_name + ".rankingScript";
@@ -78,7 +84,7 @@ struct OnnxFeatureTest : ::testing::Test {
         MatchDataLayout mdl;
         QueryEnvironment queryEnv(&indexEnv);
         match_data = mdl.createMatchData();
-        program.setup(*match_data, queryEnv, overrides);
+        program.setup(*match_data, queryEnv, overrides, profiler);
         return true;
     }
     void compile(const std::string &seed) {
@@ -100,7 +106,9 @@ struct OnnxFeatureTest : ::testing::Test {
     }
 };
 
-OnnxFeatureTest::~OnnxFeatureTest() = default;
+OnnxFeatureFixture::~OnnxFeatureFixture() = default;
+
+struct OnnxFeatureTest : ::testing::Test, OnnxFeatureFixture {};
 
 TEST_F(OnnxFeatureTest, simple_onnx_model_can_be_calculated) {
     add_expr("query_tensor", "tensor<float>(a[1],b[4]):[[docid,2,3,4]]");
@@ -206,4 +214,83 @@ TEST_F(OnnxFeatureTest, broken_model_fails_with_dry_run) {
     EXPECT_FALSE(try_compile(onnx_feature("fragile")));
 }
 
+void setup_batched_model(OnnxFeatureFixture &f, uint32_t batch_size) {
+    f.add_expr("in1", "tensor<float>(a[1],b[2]):[[docid,2]]");
+    f.add_expr("in2", "tensor<float>(a[1],b[2]):[[3,docid]]");
+    if (batch_size > 0) {
+        f.indexEnv.getProperties().add(indexproperties::eval::OnnxBatchSize::NAME, std::to_string(batch_size));
+    }
+    f.add_onnx(OnnxModel("batched", batched_model));
+    f.compile(onnx_feature("batched"));
+}
+
+void expect_batched_results_equal_unbatched_results(OnnxFeatureFixture &batched, OnnxFeatureFixture &unbatched) {
+    // batch size 3: one full batch and one partial batch
+    std::vector<uint32_t> prepared = {1, 2, 3, 5, 8};
+    batched.program.prepare_batch(prepared);
+    // 4 and 9 are not prepared and fall back to evaluating one document at a time
+    for (uint32_t docid: {1, 2, 3, 5, 4, 8, 2, 9}) {
+        SCOPED_TRACE(fmt("docid %u", docid));
+        EXPECT_EQ(batched.get(docid), unbatched.get(docid));
+        EXPECT_EQ(batched.get("onnx(batched).prod", docid), unbatched.get("onnx(batched).prod", docid));
+    }
+}
+
+TEST(OnnxFeatureBatchTest, batched_evaluation_gives_same_results_as_unbatched_evaluation) {
+    OnnxFeatureFixture batched;
+    OnnxFeatureFixture unbatched;
+    setup_batched_model(batched, 3);
+    setup_batched_model(unbatched, 0);
+    expect_batched_results_equal_unbatched_results(batched, unbatched);
+    batched.program.prepare_batch(std::vector<uint32_t>{5});
+    EXPECT_EQ(batched.get(5), TensorSpec::from_expr("tensor<float>(d0[1],d1[2]):[[8,7]]"));
+    EXPECT_EQ(batched.get("onnx(batched).prod", 5), TensorSpec::from_expr("tensor<float>(d0[1],d1[2]):[[15,10]]"));
+}
+
+TEST(OnnxFeatureBatchTest, batched_evaluation_works_with_profiling_and_feature_overrides) {
+    auto prod_override = vespalib::eval::value_from_spec(TensorSpec::from_expr("tensor<float>(d0[1],d1[2]):[[-1,-2]]"),
+                                                         vespalib::eval::FastValueBuilderFactory::get());
+    vespalib::nbostream encoded;
+    vespalib::eval::encode_value(*prod_override, encoded);
+    vespalib::ExecutionProfiler profiler(64);
+    OnnxFeatureFixture batched;
+    OnnxFeatureFixture unbatched;
+    batched.profiler = &profiler;
+    for (auto *f: {&batched, &unbatched}) {
+        f->overrides.add("onnx(batched).prod", std::string(encoded.peek(), encoded.size()));
+    }
+    setup_batched_model(batched, 3);
+    setup_batched_model(unbatched, 0);
+    expect_batched_results_equal_unbatched_results(batched, unbatched);
+    EXPECT_EQ(batched.get("onnx(batched).prod", 1), TensorSpec::from_expr("tensor<float>(d0[1],d1[2]):[[-1,-2]]"));
+}
+
+size_t count_profiled_onnx_runs(const vespalib::ExecutionProfiler &profiler) {
+    size_t count = 0;
+    profiler.visit_stacks([&count](const std::vector<std::string> &stack, size_t task_count, vespalib::duration) {
+        if (!stack.empty() && stack.back().starts_with("onnx(")) {
+            count += task_count;
+        }
+    });
+    return count;
+}
+
+TEST(OnnxFeatureBatchTest, model_with_only_const_inputs_is_not_evaluated_per_batch) {
+    vespalib::ExecutionProfiler profiler(64);
+    OnnxFeatureFixture f;
+    f.profiler = &profiler;
+    f.add_expr("in1", "tensor<float>(a[1],b[2]):[[1,2]]");
+    f.add_expr("in2", "tensor<float>(a[1],b[2]):[[3,4]]");
+    f.indexEnv.getProperties().add(indexproperties::eval::OnnxBatchSize::NAME, "3");
+    f.add_onnx(OnnxModel("batched", batched_model));
+    f.compile(onnx_feature("batched"));
+    EXPECT_EQ(1u, count_profiled_onnx_runs(profiler));
+    f.program.prepare_batch(std::vector<uint32_t>{1, 2, 3, 5, 8});
+    for (uint32_t docid: {1, 2, 3, 5, 8}) {
+        EXPECT_EQ(f.get(docid), TensorSpec::from_expr("tensor<float>(d0[1],d1[2]):[[4,6]]"));
+        EXPECT_EQ(f.get("onnx(batched).prod", docid), TensorSpec::from_expr("tensor<float>(d0[1],d1[2]):[[3,8]]"));
+    }
+    EXPECT_EQ(1u, count_profiled_onnx_runs(profiler));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -141,6 +141,13 @@ struct Fixture {
         }
         return 31212.0;
     }
+    std::vector<double> get_batch(const std::vector<uint32_t> &docids) {
+        auto result = program.get_seeds();
+        EXPECT_EQ(1u, result.num_features());
+        std::vector<double> numbers(docids.size());
+        result.resolve(0).as_numbers(docids, numbers);
+        return numbers;
+    }
     std::map<std::string, double> all(uint32_t docid = default_docid) {
         auto result = program.get_seeds();
         std::map<std::string, double> result_map;
@@ -241,6 +248,25 @@ TEST(RankProgramTest, rank_program_can_calculate_scores_for_multiple_documents)
     EXPECT_EQ(f1.get(1), 11.0);
 }
 
+TEST(RankProgramTest, rank_program_can_calculate_scores_for_batch_of_documents)
+{
+    Fixture f1;
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+value(10)").compile();
+    std::vector<double> expect({12.0, 14.0, 20.0, 16.0});
+    EXPECT_EQ(expect, f1.get_batch({1, 2, 5, 3}));
+    EXPECT_EQ(f1.get(expr_feature("rank"), 4), 18.0);
+}
+
+TEST(RankProgramTest, executors_without_batch_support_are_calculated_per_document_in_batch)
+{
+    Fixture f1;
+    f1.add("track(mysum(track(value(10)),docid))").compile();
+    EXPECT_EQ(f1.track_cnt, 1u);
+    std::vector<double> expect({11.0, 12.0, 13.0});
+    EXPECT_EQ(expect, f1.get_batch({1, 2, 3}));
+    EXPECT_EQ(f1.track_cnt, 4u);
+}
+
 TEST(RankProgramTest, only_non_const_features_are_calculated_per_document)
 {
     Fixture f1;
@@ -422,6 +448,23 @@ TEST(RankProgramTest, interpreted_ranking_expressions_are_pure)
 
 const std::string tree_expr = "if(value(1)<2,1,2)+if(value(2)<1,10,20)";
 
+TEST(RankProgramTest, compiled_ranking_expressions_can_read_inputs_directly)
+{
+    Fixture f1;
+    f1.lazy_expressions(false).add_expr("rank", "docid*2+track(ivalue(1))+value(10)").compile();
+    EXPECT_EQ(f1.get(expr_feature("rank"), 1), 13.0);
+    EXPECT_EQ(f1.get(expr_feature("rank"), 5), 21.0);
+    EXPECT_EQ(f1.track_cnt, 2u);
+}
+
+TEST(RankProgramTest, overridden_inputs_are_not_read_directly_by_compiled_ranking_expressions)
+{
+    Fixture f1;
+    f1.lazy_expressions(false).add_expr("rank", "docid*2").override("docid", 4.0).compile();
+    EXPECT_EQ(f1.get(expr_feature("rank"), 1), 8.0);
+    EXPECT_EQ(f1.get(expr_feature("rank"), 5), 8.0);
+}
+
 TEST(RankProgramTest, fast_forest_gbdt_evaluation_can_be_enabled)
 {
     Fixture f1;
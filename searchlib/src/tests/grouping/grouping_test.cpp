@@ -2,6 +2,7 @@
 
 #include <vespa/searchlib/aggregation/perdocexpression.h>
 #include <vespa/searchlib/aggregation/aggregation.h>
+#include <vespa/searchlib/aggregation/columnaraggregator.h>
 #include <vespa/searchlib/attribute/extendableattributes.h>
 #include <vespa/searchlib/attribute/attributemanager.h>
 #include <vespa/searchlib/aggregation/hitsaggregationresult.h>
@@ -570,6 +571,157 @@ TEST(GroupingTest, testAggregationMaxGroups)
     }
 }
 
+TEST(GroupingTest, Verify_that_reserving_first_level_groups_during_aggregation_does_not_change_result)
+{
+    AggregationContext ctx;
+    IntAttrBuilder attr("attr");
+    for (uint32_t i = 0; i < 1000; ++i) {
+        attr.add(i % 300);
+        ctx.result().add(i, 1000 - i);
+    }
+    ctx.add(attr.sp());
+    Grouping request = Grouping().addLevel(createGL(MU<AttributeNode>("attr"), MU<AttributeNode>("attr")));
+
+    Grouping expect = request;
+    ctx.setup(expect);
+    expect.aggregate(ctx.result().hits(), ctx.result().size());
+
+    Grouping tmp = request;
+    ctx.setup(tmp);
+    tmp.preAggregate(false);
+    const RankedHit *hits = ctx.result().hits();
+    for (uint32_t i = 0; i < 100; ++i) {
+        tmp.aggregate(hits[i].getDocId(), hits[i].getRank());
+    }
+    EXPECT_EQ(100u, tmp.getRoot().getChildrenSize());
+    tmp.reserveFirstLevelGroups(0, 100, ctx.result().size());
+    for (uint32_t i = 100; i < ctx.result().size(); ++i) {
+        tmp.aggregate(hits[i].getDocId(), hits[i].getRank());
+    }
+    tmp.postProcess();
+    EXPECT_EQ(300u, tmp.getRoot().getChildrenSize());
+    EXPECT_EQ(expect.getRoot().asString(), tmp.getRoot().asString());
+}
+
+namespace {
+
+GroupingLevel
+createColumnarGL(const char *key, int64_t maxGroups) {
+    GroupingLevel level = createGL(MU<AttributeNode>(key));
+    level.setMaxGroups(maxGroups)
+         .addResult(CountAggregationResult().setExpression(MU<ConstantNode>(MU<Int64ResultNode>(0))))
+         .addResult(SumAggregationResult().setExpression(MU<AttributeNode>("ival")))
+         .addResult(AverageAggregationResult().setExpression(MU<AttributeNode>("fval")));
+    return level;
+}
+
+}
+
+TEST(GroupingTest, Verify_that_columnar_aggregation_gives_same_result_as_aggregating_each_hit)
+{
+    AggregationContext ctx;
+    IntAttrBuilder small("small");
+    IntAttrBuilder wide("wide");
+    IntAttrBuilder ival("ival");
+    FloatAttrBuilder fval("fval");
+    for (uint32_t i = 0; i < 1000; ++i) {
+        small.add(i % 37);
+        wide.add((i % 37) * 1000003);
+        ival.add(int64_t(i) * 3 - 500);
+        fval.add(i * 0.5);
+        ctx.result().add(i, i % 100);
+    }
+    ctx.add(small.sp());
+    ctx.add(wide.sp());
+    ctx.add(ival.sp());
+    ctx.add(fval.sp());
+    const RankedHit *hits = ctx.result().hits();
+    uint32_t numHits = ctx.result().size();
+    for (const char *key : {"small", "wide"}) {
+        for (bool isOrdered : {false, true}) {
+            SCOPED_TRACE(std::string(key) + (isOrdered ? " ordered" : " unordered"));
+            Grouping request = Grouping().setLastLevel(1).addLevel(createColumnarGL(key, isOrdered ? 5 : -1));
+
+            Grouping expect = request;
+            ctx.setup(expect);
+            expect.preAggregate(isOrdered);
+            for (uint32_t i = 0; i < numHits; ++i) {
+                expect.aggregate(hits[i].getDocId(), hits[i].getRank());
+            }
+            expect.postProcess();
+
+            Grouping actual = request;
+            ctx.setup(actual);
+            actual.preAggregate(isOrdered);
+            auto columnar = ColumnarAggregator::create(actual);
+            ASSERT_TRUE(columnar);
+            for (uint32_t i = 0; i < numHits; i += 256) {
+                columnar->aggregate(hits + i, std::min(256u, numHits - i));
+            }
+            actual.postProcess();
+            EXPECT_EQ(isOrdered ? 5u : 37u, actual.getRoot().getChildrenSize());
+            EXPECT_EQ(expect.getRoot().asString(), actual.getRoot().asString());
+        }
+    }
+}
+
+TEST(GroupingTest, Verify_that_columnar_aggregation_is_only_used_for_supported_groupings)
+{
+    AggregationContext ctx;
+    ctx.add(IntAttrBuilder("key").add(1).add(2).sp());
+    ctx.add(IntAttrBuilder("ival").add(3).add(4).sp());
+    ctx.add(FloatAttrBuilder("fval").add(3).add(4).sp());
+    ctx.add(IntArrayAttrBuilder("array").add({1, 2}).add({3}).sp());
+    auto create = [&ctx](Grouping request) {
+        ctx.setup(request);
+        request.preAggregate(false);
+        return bool(ColumnarAggregator::create(request));
+    };
+    EXPECT_TRUE(create(Grouping().setLastLevel(1).addLevel(createColumnarGL("key", -1))));
+    EXPECT_FALSE(create(Grouping().setLastLevel(0).addLevel(createColumnarGL("key", -1))));
+    EXPECT_FALSE(create(Grouping().setLastLevel(1).addLevel(createColumnarGL("array", -1))));
+    EXPECT_FALSE(create(Grouping().setLastLevel(2)
+                                  .addLevel(createColumnarGL("key", -1))
+                                  .addLevel(createColumnarGL("key", -1))));
+    EXPECT_FALSE(create(Grouping().setLastLevel(1)
+                                  .setRoot(Group().addResult(SumAggregationResult().setExpression(MU<AttributeNode>("ival"))))
+                                  .addLevel(createColumnarGL("key", -1))));
+    GroupingLevel maxLevel = createGL(MU<AttributeNode>("key"));
+    maxLevel.addResult(MaxAggregationResult().setExpression(MU<AttributeNode>("ival")));
+    EXPECT_FALSE(create(Grouping().setLastLevel(1).addLevel(std::move(maxLevel))));
+}
+
+TEST(GroupingTest, Verify_that_reserved_first_level_groups_are_capped)
+{
+    AggregationContext ctx;
+    IntAttrBuilder attr("attr");
+    for (uint32_t i = 0; i < 1000; ++i) {
+        attr.add(i);
+        ctx.result().add(i, 1000 - i);
+    }
+    ctx.add(attr.sp());
+    // A sample of 256 hits with distinct group keys, extrapolated to 100M hits
+    auto sampleAndReserve = [&ctx](Grouping request) {
+        ctx.setup(request);
+        request.preAggregate(false);
+        const RankedHit *hits = ctx.result().hits();
+        for (uint32_t i = 0; i < 256; ++i) {
+            request.aggregate(hits[i].getDocId(), hits[i].getRank());
+        }
+        EXPECT_EQ(256u, request.getRoot().getChildrenSize());
+        return request.reserveFirstLevelGroups(0, 256, 100'000'000);
+    };
+    // capped by the number of unique values in the attribute
+    EXPECT_EQ(1001u, sampleAndReserve(Grouping().addLevel(createGL(MU<AttributeNode>("attr")))));
+    // capped by max groups
+    EXPECT_EQ(500u, sampleAndReserve(Grouping().addLevel(createGL(500, MU<AttributeNode>("attr")))));
+    // capped by a fixed upper bound when the cardinality is not known
+    auto bucket = MU<FixedWidthBucketFunctionNode>(MU<AttributeNode>("attr"));
+    bucket->setWidth(Int64ResultNode(1));
+    EXPECT_EQ(Grouping::MAX_RESERVED_FIRST_LEVEL_GROUPS,
+              sampleAndReserve(Grouping().addLevel(createGL(std::move(bucket)))));
+}
+
 TEST(GroupingTest, Verify_that_groups_are_sorted_by_group_id)
 {
     AggregationContext ctx;
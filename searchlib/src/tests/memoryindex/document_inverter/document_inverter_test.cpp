@@ -168,6 +168,34 @@ TEST_F(DocumentInverterTest, require_that_multiple_docs_work)
               _inserter_backend.toStr());
 }
 
+TEST_F(DocumentInverterTest, require_that_documents_are_inverted_by_multiple_shards)
+{
+    auto invert_threads = SequencedTaskExecutor::create(invert_executor, 2);
+    DocumentInverterContext inv_context(_schema, *invert_threads, *_pushThreads, _fic, 2);
+    DocumentInverter inv(inv_context);
+    auto doc10 = makeDoc10(_b);
+    auto doc11 = makeDoc11(_b);
+    auto doc12 = makeDoc12(_b);
+    inv.invertDocument(10, *doc10, {});
+    inv.invertDocument(11, *doc11, {});
+    inv.invertDocument(12, *doc12, {});
+    inv.removeDocument(12);
+    vespalib::Gate gate;
+    inv.pushDocuments(std::make_shared<vespalib::GateCallback>(gate));
+    gate.await();
+    EXPECT_EQ("f=0,w=a,a=10,"
+              "w=b,a=10,"
+              "w=c,a=10,"
+              "w=d,a=10,"
+              "f=0,w=a,a=11,"
+              "w=b,a=11,"
+              "w=e,a=11,"
+              "w=f,a=11,"
+              "f=1,w=a,a=11,"
+              "w=g,a=11",
+              _inserter_backend.toStr());
+}
+
 TEST_F(DocumentInverterTest, require_that_remove_works)
 {
     _inv.getInverter(0)->remove("b", 10);
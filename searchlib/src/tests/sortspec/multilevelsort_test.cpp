@@ -66,8 +66,11 @@ private:
     template <typename V>
     int compareTemplate(AttributeVector *vector, uint32_t a, uint32_t b);
     int compare(AttributeVector *vector, AttrType type, uint32_t a, uint32_t b);
+    int compareHits(const std::vector<Spec> &specs, VectorMap &vec, const RankedHit &a, const RankedHit &b);
     void sortAndCheck(const std::vector<Spec> &spec, uint32_t num,
                       uint32_t unique, const std::vector<std::string> &strValues);
+    void sortAndCheck(const std::vector<Spec> &spec, uint32_t num, uint32_t topn,
+                      uint32_t unique, const std::vector<std::string> &strValues);
 public:
     MultilevelSortTest() { srand(time(nullptr)); }
     void testSort();
@@ -198,9 +201,44 @@ MultilevelSortTest::compare(AttributeVector *vector, AttrType type, uint32_t a,
     }
 }
 
+int
+MultilevelSortTest::compareHits(const std::vector<Spec> &specs, VectorMap &vec, const RankedHit &a, const RankedHit &b)
+{
+    for (const Spec & spec : specs) {
+        int cmp = 0;
+        if (spec._type == RANK) {
+            if (a.getRank() < b.getRank()) {
+                cmp = -1;
+            } else if (a.getRank() > b.getRank()) {
+                cmp = 1;
+            }
+        } else if (spec._type == DOCID) {
+            if (a.getDocId() < b.getDocId()) {
+                cmp = -1;
+            } else if (a.getDocId() > b.getDocId()) {
+                cmp = 1;
+            }
+        } else {
+            AttributeVector *av = vec[spec._name].get();
+            cmp = compare(av, spec._type, a.getDocId(), b.getDocId());
+        }
+        if (cmp != 0) {
+            return spec._asc ? cmp : -cmp;
+        }
+    }
+    return 0;
+}
+
 void
 MultilevelSortTest::sortAndCheck(const std::vector<Spec> &specs, uint32_t num,
                                  uint32_t unique, const std::vector<std::string> &strValues)
+{
+    sortAndCheck(specs, num, num, unique, strValues);
+}
+
+void
+MultilevelSortTest::sortAndCheck(const std::vector<Spec> &specs, uint32_t num, uint32_t topn,
+                                 uint32_t unique, const std::vector<std::string> &strValues)
 {
     VectorMap vec;
     // generate attribute vectors
@@ -264,45 +302,16 @@ MultilevelSortTest::sortAndCheck(const std::vector<Spec> &specs, uint32_t num,
     }
 
     vespalib::Timer timer;
-    sorter.sortResults(&hits[0], num, num);
+    sorter.sortResults(&hits[0], num, topn);
     LOG(info, "sort time = %" PRId64 " ms", vespalib::count_ms(timer.elapsed()));
 
-    std::vector<uint32_t> offsets(num + 1, 0);
-    auto buf = std::make_unique<char []>(sorter.getSortDataSize(0, num));
-    sorter.copySortData(0, num, &offsets[0], buf.get());
+    std::vector<uint32_t> offsets(topn + 1, 0);
+    auto buf = std::make_unique<char []>(sorter.getSortDataSize(0, topn));
+    sorter.copySortData(0, topn, &offsets[0], buf.get());
 
     // check results
-    for (uint32_t i = 0; i < num - 1; ++i) {
-        for (const Spec & spec : specs) {
-            int cmp = 0;
-            if (spec._type == RANK) {
-                if (hits[i].getRank() < hits[i+1].getRank()) {
-                    cmp = -1;
-                } else if (hits[i].getRank() > hits[i+1].getRank()) {
-                    cmp = 1;
-                }
-            } else if (spec._type == DOCID) {
-                if (hits[i].getDocId() < hits[i+1].getDocId()) {
-                    cmp = -1;
-                } else if (hits[i].getDocId() > hits[i+1].getDocId()) {
-                    cmp = 1;
-                }
-            } else {
-                AttributeVector *av = vec[spec._name].get();
-                cmp = compare(av, spec._type, hits[i].getDocId(), hits[i+1].getDocId());
-            }
-            if (spec._asc) {
-                EXPECT_TRUE(cmp <= 0);
-                if (cmp < 0) {
-                    break;
-                }
-            } else {
-                EXPECT_TRUE(cmp >= 0);
-                if (cmp > 0) {
-                    break;
-                }
-            }
-        }
+    for (uint32_t i = 0; i < topn - 1; ++i) {
+        EXPECT_LE(compareHits(specs, vec, hits[i], hits[i+1]), 0);
         // check binary sort data
         uint32_t minLen = std::min(sorter._sortDataArray[i]._len, sorter._sortDataArray[i+1]._len);
         int cmp = memcmp(&sorter._binarySortData[0] + sorter._sortDataArray[i]._idx,
@@ -314,10 +323,23 @@ MultilevelSortTest::sortAndCheck(const std::vector<Spec> &specs, uint32_t num,
                      buf.get() + offsets[i], sorter._sortDataArray[i]._len);
         EXPECT_TRUE(cmp == 0);
     }
-    EXPECT_TRUE(sorter._sortDataArray[num-1]._len == (offsets[num] - offsets[num-1]));
-    int cmp = memcmp(&sorter._binarySortData[0] + sorter._sortDataArray[num-1]._idx,
-                 buf.get() + offsets[num-1], sorter._sortDataArray[num-1]._len);
+    EXPECT_TRUE(sorter._sortDataArray[topn-1]._len == (offsets[topn] - offsets[topn-1]));
+    int cmp = memcmp(&sorter._binarySortData[0] + sorter._sortDataArray[topn-1]._idx,
+                 buf.get() + offsets[topn-1], sorter._sortDataArray[topn-1]._len);
     EXPECT_TRUE(cmp == 0);
+
+    // hits not sorted are kept, and none of them is better than the sorted ones
+    for (uint32_t i = topn; i < num; ++i) {
+        EXPECT_GE(compareHits(specs, vec, hits[i], hits[topn-1]), 0);
+    }
+    std::vector<uint32_t> docIds;
+    for (const RankedHit & hit : hits) {
+        docIds.push_back(hit.getDocId());
+    }
+    std::sort(docIds.begin(), docIds.end());
+    for (uint32_t i = 0; i < num; ++i) {
+        EXPECT_EQ(i, docIds[i]);
+    }
 }
 
 void MultilevelSortTest::testSort()
@@ -355,6 +377,24 @@ void MultilevelSortTest::testSort()
         srand(time(nullptr));
         sortAndCheck(spec, 5000, 8, strValues);
     }
+    {
+        std::vector<std::string> strValues;
+        strValues.emplace_back("applications");
+        strValues.emplace_back("places");
+        strValues.emplace_back("system");
+        strValues.emplace_back("vespa search core");
+
+        std::vector<Spec> spec;
+        spec.emplace_back("string", STRING);
+        spec.emplace_back("int32", INT32, false);
+        spec.emplace_back("docid", DOCID);
+        srand(13579);
+        sortAndCheck(spec, 5000, 100, 4, strValues);
+        sortAndCheck(spec, 5000, 1, 4, strValues);
+        sortAndCheck(std::vector<Spec>(1, Spec("int8", INT8, true)), 5000, 10, 0, strValues);
+        sortAndCheck(std::vector<Spec>(1, Spec("double", DOUBLE, false)), 5000, 10, 0, strValues);
+        sortAndCheck(std::vector<Spec>(1, Spec("rank", RANK, false)), 5000, 10, 0, strValues);
+    }
     {
         std::vector<std::string> none;
         uint32_t num = 50;
@@ -1,6 +1,8 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include <vespa/searchlib/transactionlog/chunks.h>
+#include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <atomic>
 #include <vespa/vespalib/gtest/gtest.h>
 
@@ -11,6 +13,7 @@ using namespace search::transactionlog;
 using vespalib::ConstBufferRef;
 using vespalib::nbostream;
 using vespalib::compression::CompressionConfig;
+using vespalib::compression::ZStdDictionary;
 
 constexpr const char * TEXT = "abcdefghijklmnopqrstuvwxyz_abcdefghijklmnopqrstuvwxyz_abcdefghijklmnopqrstuvwxyz_abcdefghijklmnopqrstuvwxyz_abcdefghijklmnopqrstuvwxyz";
 constexpr const char * TEXT2 = "something else";
@@ -71,6 +74,66 @@ TEST(TransactionLogChunksTest, test_serialization_and_deserialization_of_uncompr
     verifySerializationAndDeserialization(chunk, 1, Encoding(Encoding::Crc::xxh64, Encoding::Compression::none_multi));
 }
 
+std::shared_ptr<const ZStdDictionary>
+trainDictionary() {
+    std::string samples;
+    std::vector<size_t> sizes;
+    for (size_t i(0); i < 1000; i++) {
+        std::string sample = std::string("{\"id\":\"id:test:doc::") + std::to_string(i) + "\",\"text\":\"" + (TEXT + (i%20)) + "\"}";
+        samples += sample;
+        sizes.push_back(sample.size());
+    }
+    return ZStdDictionary::train(samples, sizes, 4096, 3);
+}
+
+TEST(TransactionLogChunksTest, test_serialization_and_deserialization_of_multientry_xxh64_zstd_dictionary_compression) {
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    XXH64ZStdDictionaryChunk chunk(dictionary);
+    for (size_t i(0); i < 10; i++) {
+        const char *start = TEXT + (i%20);
+        chunk.add(Packet::Entry(i, i%8, ConstBufferRef(start, strlen(start))));
+    }
+    nbostream os;
+    Encoding encoding = chunk.encode(os);
+    EXPECT_EQ(Encoding(Encoding::Crc::xxh64, Encoding::Compression::zstd_dict), encoding);
+    EXPECT_THROW(IChunk::create(encoding.getRaw()), vespalib::IllegalArgumentException);
+    auto deserialized = IChunk::create(encoding, 3, dictionary);
+    deserialized->decode(os);
+    EXPECT_TRUE(os.empty());
+    ASSERT_EQ(10u, deserialized->getEntries().size());
+    EXPECT_EQ(chunk.getEntries()[9].serial(), deserialized->getEntries()[9].serial());
+    EXPECT_EQ(std::string(chunk.getEntries()[9].data().c_str(), chunk.getEntries()[9].data().size()),
+              std::string(deserialized->getEntries()[9].data().c_str(), deserialized->getEntries()[9].data().size()));
+}
+
+TEST(TransactionLogChunksTest, test_zstd_dictionary_chunk_requires_the_same_dictionary) {
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    XXH64ZStdDictionaryChunk chunk(dictionary);
+    for (size_t i(0); i < 10; i++) {
+        chunk.add(Packet::Entry(i, 1, ConstBufferRef(TEXT, strlen(TEXT))));
+    }
+    nbostream os;
+    Encoding encoding = chunk.encode(os);
+    auto other = std::make_shared<const ZStdDictionary>(std::string(1024, 'x'), 3);
+    auto deserialized = IChunk::create(encoding, 3, other);
+    EXPECT_THROW(deserialized->decode(os), std::runtime_error);
+}
+
+TEST(TransactionLogChunksTest, test_serialization_and_deserialization_of_uncompressable_zstd_dictionary) {
+    auto dictionary = trainDictionary();
+    ASSERT_TRUE(dictionary);
+    XXH64ZStdDictionaryChunk chunk(dictionary);
+    chunk.add(Packet::Entry(1, 1, ConstBufferRef(TEXT2, strlen(TEXT2))));
+    nbostream os;
+    Encoding encoding = chunk.encode(os);
+    EXPECT_EQ(Encoding(Encoding::Crc::xxh64, Encoding::Compression::none_multi), encoding);
+    auto deserialized = IChunk::create(encoding.getRaw());
+    deserialized->decode(os);
+    EXPECT_EQ(1u, deserialized->getEntries().size());
+}
+
 TEST(TransactionLogChunksTest, test_empty_commitchunk) {
     CommitChunk cc(1,1);
     EXPECT_EQ(0u, cc.sizeBytes());
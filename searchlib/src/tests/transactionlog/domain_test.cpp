@@ -0,0 +1,216 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/searchlib/transactionlog/domain.h>
+#include <vespa/searchlib/transactionlog/domainpart.h>
+#include <vespa/searchlib/index/dummyfileheadercontext.h>
+#include <vespa/searchlib/test/directory_handler.h>
+#include <vespa/vespalib/util/count_down_latch.h>
+#include <vespa/vespalib/util/destructor_callbacks.h>
+#include <vespa/vespalib/util/gate.h>
+#include <vespa/vespalib/util/lambdatask.h>
+#include <vespa/vespalib/util/threadstackexecutor.h>
+#include <atomic>
+#include <map>
+#include <vespa/vespalib/gtest/gtest.h>
+
+#include <vespa/log/log.h>
+LOG_SETUP("translog_domain_test");
+
+using namespace search::transactionlog;
+using search::SerialNum;
+using search::index::DummyFileHeaderContext;
+using vespalib::ConstBufferRef;
+
+namespace {
+
+std::string
+make_payload(SerialNum serial) {
+    return "{\"id\":\"id:test:doc::" + std::to_string(serial) + "\",\"title\":\"title " + std::to_string(serial % 97) +
+           "\",\"body\":\"some text that is shared by many documents, " + std::to_string(serial % 13) + "\"}";
+}
+
+void
+append_and_commit(Domain & domain, SerialNum from, SerialNum to) {
+    Packet packet(0x10000);
+    for (SerialNum serial = from; serial <= to; ++serial) {
+        std::string payload = make_payload(serial);
+        packet.add(Packet::Entry(serial, 1, ConstBufferRef(payload.data(), payload.size())));
+    }
+    vespalib::Gate committed;
+    domain.append(packet, Writer::DoneCallback());
+    (void) domain.startCommit(std::make_shared<vespalib::GateCallback>(committed));
+    committed.await();
+}
+
+struct CollectingDestination : Destination {
+    std::map<SerialNum, std::string> & _entries;
+    vespalib::Gate                   & _done;
+    CollectingDestination(std::map<SerialNum, std::string> & entries, vespalib::Gate & done)
+        : _entries(entries), _done(done) {}
+    bool send(int32_t, const std::string &, const Packet & packet) override {
+        vespalib::nbostream_longlivedbuf is(packet.getHandle().data(), packet.getHandle().size());
+        while ( ! is.empty()) {
+            Packet::Entry entry;
+            entry.deserialize(is);
+            _entries[entry.serial()] = std::string(entry.data().c_str(), entry.data().size());
+        }
+        return true;
+    }
+    bool sendDone(int32_t, const std::string &) override {
+        _done.countDown();
+        return true;
+    }
+    bool connected() const override { return true; }
+    bool ok() const override { return true; }
+};
+
+std::map<SerialNum, std::string>
+visit_all(const Domain::SP & domain) {
+    std::map<SerialNum, std::string> entries;
+    vespalib::Gate done;
+    int id = domain->visit(domain, 0, std::numeric_limits<SerialNum>::max(),
+                           std::make_unique<CollectingDestination>(entries, done));
+    EXPECT_EQ(0, domain->startSession(id));
+    done.await();
+    EXPECT_EQ(0, domain->closeSession(id));
+    return entries;
+}
+
+}
+
+TEST(DomainTest, queued_commits_share_one_fsync_and_are_acked_after_it) {
+    constexpr size_t NUM_COMMITS = 20;
+    search::test::DirectoryHandler testDir("test_group_commit");
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1);
+    auto cfg = DomainConfig().setPartSizeLimit(0x1000000)
+                             .setEncoding(Encoding(Encoding::xxh64, Encoding::none_multi))
+                             .setFSyncOnCommit(true);
+    Domain domain("group", testDir.getDir(), executor, cfg, fileHeaderContext);
+    // Hold back serialization of the chunks until all commits are queued behind the first one
+    vespalib::Gate queued;
+    executor.execute(vespalib::makeLambdaTask([&queued]() { queued.await(); }));
+    std::atomic<size_t> acked(0);
+    std::atomic<size_t> ackedBeforeSync(0);
+    vespalib::CountDownLatch allAcked(NUM_COMMITS);
+    for (SerialNum serial = 1; serial <= NUM_COMMITS; ++serial) {
+        Packet packet(0x1000);
+        packet.add(Packet::Entry(serial, 1, ConstBufferRef(&serial, sizeof(serial))));
+        domain.append(packet, vespalib::makeSharedLambdaCallback([&domain, &acked, &ackedBeforeSync, &allAcked, serial]() {
+            if (domain.getSynced() < serial) {
+                ackedBeforeSync++;
+            }
+            acked++;
+            allAcked.countDown();
+        }));
+        (void) domain.startCommit(Writer::DoneCallback());
+    }
+    EXPECT_EQ(0u, acked.load());
+    queued.countDown();
+    allAcked.await();
+    EXPECT_EQ(NUM_COMMITS, acked.load());
+    EXPECT_EQ(0u, ackedBeforeSync.load());
+    EXPECT_EQ(1u, domain.getNumSyncs());
+    EXPECT_EQ(NUM_COMMITS, domain.getSynced());
+}
+
+TEST(DomainTest, number_of_commits_sharing_one_fsync_is_bounded) {
+    constexpr size_t NUM_COMMITS = 2 * Domain::MAX_GROUPED_COMMITS + 10;
+    search::test::DirectoryHandler testDir("test_bounded_group_commit");
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1);
+    auto cfg = DomainConfig().setPartSizeLimit(0x1000000)
+                             .setEncoding(Encoding(Encoding::xxh64, Encoding::none_multi))
+                             .setFSyncOnCommit(true);
+    Domain domain("bounded", testDir.getDir(), executor, cfg, fileHeaderContext);
+    vespalib::Gate queued;
+    executor.execute(vespalib::makeLambdaTask([&queued]() { queued.await(); }));
+    std::atomic<size_t> ackedBeforeSync(0);
+    vespalib::CountDownLatch allAcked(NUM_COMMITS);
+    for (SerialNum serial = 1; serial <= NUM_COMMITS; ++serial) {
+        Packet packet(0x1000);
+        packet.add(Packet::Entry(serial, 1, ConstBufferRef(&serial, sizeof(serial))));
+        domain.append(packet, vespalib::makeSharedLambdaCallback([&domain, &ackedBeforeSync, &allAcked, serial]() {
+            if (domain.getSynced() < serial) {
+                ackedBeforeSync++;
+            }
+            allAcked.countDown();
+        }));
+        (void) domain.startCommit(Writer::DoneCallback());
+    }
+    queued.countDown();
+    allAcked.await();
+    EXPECT_EQ(0u, ackedBeforeSync.load());
+    // at least one sync per full group and one for the rest, more if the delay bound is hit
+    EXPECT_LE(3u, domain.getNumSyncs());
+    EXPECT_EQ(NUM_COMMITS, domain.getSynced());
+}
+
+TEST(DomainTest, every_commit_is_synced_when_nothing_is_queued_behind_it) {
+    constexpr size_t NUM_COMMITS = 5;
+    search::test::DirectoryHandler testDir("test_single_commit");
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(1);
+    auto cfg = DomainConfig().setPartSizeLimit(0x1000000)
+                             .setEncoding(Encoding(Encoding::xxh64, Encoding::none_multi))
+                             .setFSyncOnCommit(true);
+    Domain domain("single", testDir.getDir(), executor, cfg, fileHeaderContext);
+    for (SerialNum serial = 1; serial <= NUM_COMMITS; ++serial) {
+        vespalib::Gate acked;
+        Packet packet(0x1000);
+        packet.add(Packet::Entry(serial, 1, ConstBufferRef(&serial, sizeof(serial))));
+        domain.append(packet, std::make_shared<vespalib::GateCallback>(acked));
+        (void) domain.startCommit(Writer::DoneCallback());
+        acked.await();
+        EXPECT_EQ(serial, domain.getSynced());
+        EXPECT_EQ(serial, domain.getNumSyncs());
+    }
+}
+
+TEST(DomainTest, entries_written_across_dictionary_changes_are_replayed_after_restart) {
+    constexpr SerialNum ENTRIES_PER_COMMIT = 100;
+    search::test::DirectoryHandler testDir("test_dictionary");
+    DummyFileHeaderContext fileHeaderContext;
+    vespalib::ThreadStackExecutor executor(2);
+    auto cfg = DomainConfig().setPartSizeLimit(0x1000000)
+                             .setEncoding(Encoding(Encoding::xxh64, Encoding::zstd))
+                             .setDictionarySize(4096);
+    SerialNum last = 0;
+    {
+        auto domain = std::make_shared<Domain>("dict", testDir.getDir(), executor, cfg, fileHeaderContext);
+        // Feed until a dictionary has been trained and installed, which starts a new part
+        for (size_t i = 0; (i < 1000) && (domain->getDomainInfo().parts.size() < 2); ++i) {
+            append_and_commit(*domain, last + 1, last + ENTRIES_PER_COMMIT);
+            last += ENTRIES_PER_COMMIT;
+        }
+        ASSERT_EQ(2u, domain->getDomainInfo().parts.size());
+        append_and_commit(*domain, last + 1, last + ENTRIES_PER_COMMIT);
+        last += ENTRIES_PER_COMMIT;
+    }
+    // A part started right before a crash, with no entries written to it
+    DomainPart(std::string("dict"), Domain::getDir(testDir.getDir(), "dict"), last + 1, fileHeaderContext, false);
+    {
+        auto domain = std::make_shared<Domain>("dict", testDir.getDir(), executor, cfg, fileHeaderContext);
+        EXPECT_EQ(last, domain->end());
+        // The empty part was dropped and a new empty part started in its place
+        EXPECT_EQ(3u, domain->getDomainInfo().parts.size());
+        EXPECT_EQ(0u, domain->getDomainInfo().parts.back().numEntries);
+        // The empty part is replaced by one with the dictionary restored from the part before it
+        append_and_commit(*domain, last + 1, last + ENTRIES_PER_COMMIT);
+        last += ENTRIES_PER_COMMIT;
+        auto info = domain->getDomainInfo();
+        ASSERT_EQ(3u, info.parts.size());
+        EXPECT_EQ(last - ENTRIES_PER_COMMIT + 1, info.parts.back().range.from());
+    }
+    auto domain = std::make_shared<Domain>("dict", testDir.getDir(), executor, cfg, fileHeaderContext);
+    EXPECT_EQ(3u, domain->getDomainInfo().parts.size());
+    auto entries = visit_all(domain);
+    ASSERT_EQ(last, entries.size());
+    for (const auto & [serial, payload] : entries) {
+        EXPECT_EQ(make_payload(serial), payload);
+    }
+    EXPECT_EQ(1u, entries.begin()->first);
+    EXPECT_EQ(last, entries.rbegin()->first);
+}
+
+GTEST_MAIN_RUN_ALL_TESTS()
@@ -794,6 +794,33 @@ TEST(TransactionLogClientTest, test_sending_a_lot_of_data_both_sync_and_async) {
     testSendingAlotOfDataAsync(testDir.getDir());
 }
 
+TEST(TransactionLogClientTest, test_sending_a_lot_of_data_async_with_fsync_on_commit) {
+    const unsigned int NUM_PACKETS = 200;
+    const unsigned int NUM_ENTRIES = 100;
+    const unsigned int TOTAL_NUM_ENTRIES = NUM_PACKETS * NUM_ENTRIES;
+    const std::string MANY("many-fsync");
+    test::DirectoryHandler testDir("test8fsync");
+    DummyFileHeaderContext fileHeaderContext;
+    TLS tlss(testDir.getDir(), 18377, ".", fileHeaderContext, createDomainConfig(0x10000).setFSyncOnCommit(true));
+    TransLogClient tls(tlss.transport, "tcp/localhost:18377");
+    createDomainTest(tls, MANY, 0);
+    auto s1 = openDomainTest(tls, MANY);
+    fillDomainTest(tlss.tls, MANY, NUM_PACKETS, NUM_ENTRIES);
+    SerialNum b(0), e(0);
+    size_t c(0);
+    EXPECT_TRUE(s1->status(b, e, c));
+    EXPECT_EQ(b, 1u);
+    EXPECT_EQ(e, TOTAL_NUM_ENTRIES);
+    EXPECT_EQ(c, TOTAL_NUM_ENTRIES);
+    CallBackManyTest ca(0);
+    auto visitor = tls.createVisitor(MANY, ca);
+    ASSERT_TRUE(visitor);
+    ASSERT_TRUE( visitor->visit(0, TOTAL_NUM_ENTRIES) );
+    ASSERT_TRUE( ca.wait_for_eof() );
+    EXPECT_EQ(ca._count, TOTAL_NUM_ENTRIES);
+    EXPECT_EQ(ca._value, TOTAL_NUM_ENTRIES);
+}
+
 
 TEST(TransactionLogClientTest, testErase) {
     const unsigned int NUM_PACKETS = 1000;
@@ -23,6 +23,7 @@ Config::Config(BasicType bt, CollectionType ct, bool fastSearch_) noexcept
       _fastAccess(false),
       _mutable(false),
       _paged(false),
+      _huge_pages(false),
       _distance_metric(DistanceMetric::Euclidean),
       _match(Match::UNCASED),
       _dictionary(),
@@ -51,6 +52,7 @@ Config::operator==(const Config &b) const noexcept
            _fastAccess == b._fastAccess &&
            _mutable == b._mutable &&
            _paged == b._paged &&
+           _huge_pages == b._huge_pages &&
            _maxUnCommittedMemory == b._maxUnCommittedMemory &&
            _match == b._match &&
            _dictionary == b._dictionary &&
@@ -37,6 +37,7 @@ public:
     CollectionType collectionType()       const noexcept { return _type; }
     bool fastSearch()                     const noexcept { return _fastSearch; }
     bool paged()                          const noexcept { return _paged; }
+    bool huge_pages()                     const noexcept { return _huge_pages; }
     const PredicateParams &predicateParams() const noexcept { return _predicateParams; }
     const vespalib::eval::ValueType & tensorType() const noexcept { return _tensorType; }
     DistanceMetric distance_metric() const noexcept { return _distance_metric; }
@@ -84,6 +85,11 @@ public:
     Config & setIsFilter(bool isFilter) { _isFilter = isFilter; return *this; }
     Config & setMutable(bool isMutable) { _mutable = isMutable; return *this; }
     Config & setPaged(bool paged_in) { _paged = paged_in; return *this; }
+    /**
+     * Back large data store buffers and vectors with 2MB huge pages,
+     * falling back to transparent huge pages when none are available.
+     */
+    Config & set_huge_pages(bool huge_pages_in) { _huge_pages = huge_pages_in; return *this; }
     Config & setFastAccess(bool v) { _fastAccess = v; return *this; }
     Config & setGrowStrategy(const GrowStrategy &gs) { _growStrategy = gs; return *this; }
     Config & setCompactionStrategy(const CompactionStrategy &compactionStrategy) {
@@ -107,6 +113,7 @@ private:
     bool           _fastAccess : 1;
     bool           _mutable : 1;
     bool           _paged : 1;
+    bool           _huge_pages : 1;
     DistanceMetric                 _distance_metric;
     Match                          _match;
     DictionaryConfig               _dictionary;
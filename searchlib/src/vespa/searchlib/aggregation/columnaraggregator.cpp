@@ -0,0 +1,245 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "columnaraggregator.h"
+#include "averageaggregationresult.h"
+#include "countaggregationresult.h"
+#include "grouping.h"
+#include "sumaggregationresult.h"
+#include <vespa/searchlib/expression/attributenode.h>
+#include <vespa/searchlib/expression/enumresultnode.h>
+#include <vespa/searchlib/expression/floatresultnode.h>
+#include <vespa/searchlib/expression/integerresultnode.h>
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <algorithm>
+
+using search::expression::AttributeNode;
+using search::expression::EnumResultNode;
+using search::expression::ExpressionNode;
+using search::expression::FloatResultNode;
+using search::expression::Int64ResultNode;
+using search::expression::ResultNode;
+
+namespace search::aggregation {
+
+namespace {
+
+// Keys spanning at most this many values are mapped to groups through a dense array
+constexpr int64_t MAX_DENSE_RANGE = 1024;
+constexpr uint32_t NO_SLOT = -1;
+
+bool
+hasClass(const ResultNode * result, uint32_t classId) noexcept
+{
+    return (result != nullptr) && (result->getClass().id() == classId);
+}
+
+const attribute::IAttributeVector *
+singleValueAttribute(const ExpressionNode * node)
+{
+    if ((node == nullptr) || (node->getClass().id() != AttributeNode::classId)) {
+        return nullptr;
+    }
+    const auto & attributeNode = static_cast<const AttributeNode &>(*node);
+    if (attributeNode.hasMultiValue()) {
+        return nullptr;
+    }
+    return attributeNode.getAttribute();
+}
+
+}
+
+ColumnarAggregator::ColumnarAggregator(Group & root, const GroupingLevel & level,
+                                       const IAttributeVector & keyAttribute, bool enumKey)
+    : _root(root),
+      _level(level),
+      _keyAttribute(keyAttribute),
+      _enumRefs(enumKey ? keyAttribute.make_enum_read_view() : IAttributeVector::EnumRefs()),
+      _enumKey(enumKey),
+      _results(),
+      _columns(),
+      _keys(),
+      _hitSlots(),
+      _slots(),
+      _denseBase(0),
+      _denseSlots(),
+      _sparseSlots()
+{
+}
+
+ColumnarAggregator::~ColumnarAggregator() = default;
+
+std::unique_ptr<ColumnarAggregator>
+ColumnarAggregator::create(Grouping & grouping)
+{
+    const auto & levels = grouping.getLevels();
+    if ((levels.size() != 1) || (grouping.getFirstLevel() != 0) || (grouping.getLastLevel() < 1)) {
+        return {};
+    }
+    if (grouping.getRoot().getAggrSize() != 0) {
+        return {};
+    }
+    const GroupingLevel & level = levels[0];
+    if (level.isFrozen() || level.hasFilter()) {
+        return {};
+    }
+    const IAttributeVector * keyAttribute = singleValueAttribute(level.getExpression().getRoot());
+    const ResultNode * key = level.getExpression().getResult();
+    bool enumKey = hasClass(key, EnumResultNode::classId);
+    if ((keyAttribute == nullptr) || !(enumKey || hasClass(key, Int64ResultNode::classId))) {
+        return {};
+    }
+    std::unique_ptr<ColumnarAggregator> aggregator(new ColumnarAggregator(grouping.root(), level, *keyAttribute, enumKey));
+    const Group & prototype = level.getGroupPrototype();
+    for (uint32_t i(0), m(prototype.getAggrSize()); i < m; i++) {
+        const AggregationResult & result = prototype.getAggregationResult(i);
+        const ExpressionNode * expression = result.getExpression();
+        uint32_t classId = result.getClass().id();
+        if (classId == CountAggregationResult::classId) {
+            if ((expression != nullptr) && expression->getResult()->isMultiValue()) {
+                return {};
+            }
+            aggregator->_results.push_back({Op::COUNT, 0});
+            continue;
+        }
+        Op op;
+        if (classId == SumAggregationResult::classId) {
+            op = Op::SUM;
+        } else if (classId == AverageAggregationResult::classId) {
+            op = Op::AVERAGE;
+        } else {
+            return {};
+        }
+        const IAttributeVector * attribute = singleValueAttribute(expression);
+        const ResultNode * value = (expression != nullptr) ? expression->getResult() : nullptr;
+        bool isFloat = hasClass(value, FloatResultNode::classId);
+        if ((attribute == nullptr) || !(isFloat || hasClass(value, Int64ResultNode::classId))) {
+            return {};
+        }
+        aggregator->_results.push_back({op, uint32_t(aggregator->_columns.size())});
+        aggregator->_columns.push_back({attribute, isFloat, {}, {}});
+    }
+    return aggregator;
+}
+
+void
+ColumnarAggregator::readKeys(const RankedHit * hits, size_t numHits)
+{
+    _keys.resize(numHits);
+    if (_enumKey) {
+        for (size_t i(0); i < numHits; i++) {
+            uint32_t docId = hits[i].getDocId();
+            _keys[i] = (docId < _enumRefs.size())
+                ? static_cast<int64_t>(_enumRefs[docId].load_relaxed().ref())
+                : static_cast<int64_t>(_keyAttribute.getEnum(docId));
+        }
+    } else {
+        for (size_t i(0); i < numHits; i++) {
+            _keys[i] = _keyAttribute.getInt(hits[i].getDocId());
+        }
+    }
+}
+
+uint32_t
+ColumnarAggregator::slotOf(int64_t key, HitRank rank)
+{
+    // Groups are looked up in hit order, so ordered levels stop adding groups at the same hit as before
+    Group * group = _enumKey
+        ? _root.groupSingle(EnumResultNode(key), rank, _level)
+        : _root.groupSingle(Int64ResultNode(key), rank, _level);
+    _slots.push_back({group, rank, 0});
+    return _slots.size() - 1;
+}
+
+void
+ColumnarAggregator::assignSlots(const RankedHit * hits, size_t numHits)
+{
+    _slots.clear();
+    _hitSlots.resize(numHits);
+    auto [minKey, maxKey] = std::minmax_element(_keys.begin(), _keys.end());
+    if (uint64_t(*maxKey) - uint64_t(*minKey) < uint64_t(MAX_DENSE_RANGE)) {
+        _denseBase = *minKey;
+        _denseSlots.assign(*maxKey - *minKey + 1, NO_SLOT);
+        for (size_t i(0); i < numHits; i++) {
+            uint32_t & slot = _denseSlots[_keys[i] - _denseBase];
+            if (slot == NO_SLOT) {
+                slot = slotOf(_keys[i], hits[i].getRank());
+            }
+            _hitSlots[i] = slot;
+        }
+    } else {
+        _sparseSlots.clear();
+        for (size_t i(0); i < numHits; i++) {
+            auto found = _sparseSlots.find(_keys[i]);
+            if (found == _sparseSlots.end()) {
+                found = _sparseSlots.insert(std::make_pair(_keys[i], slotOf(_keys[i], hits[i].getRank()))).first;
+            }
+            _hitSlots[i] = found->second;
+        }
+    }
+}
+
+void
+ColumnarAggregator::accumulate(const RankedHit * hits, size_t numHits)
+{
+    for (size_t i(0); i < numHits; i++) {
+        Slot & slot = _slots[_hitSlots[i]];
+        slot.maxRank = std::max(slot.maxRank, hits[i].getRank());
+        slot.count++;
+    }
+    for (Column & column : _columns) {
+        if (column.isFloat) {
+            column.floatSums.assign(_slots.size(), 0.0);
+            for (size_t i(0); i < numHits; i++) {
+                column.floatSums[_hitSlots[i]] += column.attribute->getFloat(hits[i].getDocId());
+            }
+        } else {
+            column.intSums.assign(_slots.size(), 0);
+            for (size_t i(0); i < numHits; i++) {
+                column.intSums[_hitSlots[i]] += uint64_t(column.attribute->getInt(hits[i].getDocId()));
+            }
+        }
+    }
+}
+
+void
+ColumnarAggregator::flush()
+{
+    for (size_t s(0); s < _slots.size(); s++) {
+        const Slot & slot = _slots[s];
+        if (slot.group == nullptr) {
+            continue;
+        }
+        slot.group->updateRank(slot.maxRank);
+        for (size_t r(0); r < _results.size(); r++) {
+            AggregationResult & result = slot.group->getAggregationResult(r);
+            if (_results[r].op == Op::COUNT) {
+                auto & count = static_cast<CountAggregationResult &>(result);
+                count.setCount(count.getCount() + slot.count);
+                continue;
+            }
+            const Column & column = _columns[_results[r].column];
+            FloatResultNode floatSum(column.isFloat ? column.floatSums[s] : 0.0);
+            Int64ResultNode intSum(column.isFloat ? 0 : int64_t(column.intSums[s]));
+            const ResultNode & sum = column.isFloat ? static_cast<const ResultNode &>(floatSum) : intSum;
+            if (_results[r].op == Op::SUM) {
+                static_cast<SumAggregationResult &>(result).addPartialSum(sum);
+            } else {
+                static_cast<AverageAggregationResult &>(result).addPartial(sum, slot.count);
+            }
+        }
+    }
+}
+
+void
+ColumnarAggregator::aggregate(const RankedHit * hits, size_t numHits)
+{
+    if (numHits == 0) {
+        return;
+    }
+    readKeys(hits, numHits);
+    assignSlots(hits, numHits);
+    accumulate(hits, numHits);
+    flush();
+}
+
+}
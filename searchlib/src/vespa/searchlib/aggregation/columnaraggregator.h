@@ -0,0 +1,83 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <vespa/searchcommon/attribute/iattributevector.h>
+#include <vespa/searchlib/common/rankedhit.h>
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <memory>
+#include <vector>
+
+namespace search::aggregation {
+
+class Group;
+class Grouping;
+class GroupingLevel;
+
+/**
+ * Aggregates blocks of hits for the common grouping shape of a single
+ * level grouping on a single value integer or enumerated string
+ * attribute, collecting count, sum and average of single value
+ * numeric attributes. Group keys and values are read into typed
+ * columns and reduced per group before being added to the group
+ * tree, instead of evaluating expression trees and hashing result
+ * nodes for each hit. Low cardinality keys are mapped to groups
+ * through a dense array, others through a hash map.
+ *
+ * Produces the same group tree as aggregating the hits one by one.
+ * Must be used between Grouping::preAggregate and Grouping::postProcess.
+ **/
+class ColumnarAggregator
+{
+public:
+    using IAttributeVector = attribute::IAttributeVector;
+
+    // Returns nullptr if the grouping does not have a supported shape
+    static std::unique_ptr<ColumnarAggregator> create(Grouping & grouping);
+
+    ColumnarAggregator(const ColumnarAggregator &) = delete;
+    ColumnarAggregator & operator=(const ColumnarAggregator &) = delete;
+    ~ColumnarAggregator();
+    void aggregate(const RankedHit * hits, size_t numHits);
+
+    enum class Op { COUNT, SUM, AVERAGE };
+
+private:
+    struct Column {
+        const IAttributeVector * attribute;
+        bool                     isFloat;
+        std::vector<uint64_t>    intSums;   // per slot, wraps like Int64ResultNode::add
+        std::vector<double>      floatSums; // per slot
+    };
+    struct Slot {
+        Group  * group;
+        HitRank  maxRank;
+        uint64_t count;
+    };
+    struct Result {
+        Op       op;
+        uint32_t column;
+    };
+
+    ColumnarAggregator(Group & root, const GroupingLevel & level, const IAttributeVector & keyAttribute, bool enumKey);
+    void readKeys(const RankedHit * hits, size_t numHits);
+    void assignSlots(const RankedHit * hits, size_t numHits);
+    uint32_t slotOf(int64_t key, HitRank rank);
+    void accumulate(const RankedHit * hits, size_t numHits);
+    void flush();
+
+    Group                              & _root;
+    const GroupingLevel                & _level;
+    const IAttributeVector             & _keyAttribute;
+    IAttributeVector::EnumRefs           _enumRefs;
+    bool                                 _enumKey;
+    std::vector<Result>                  _results;
+    std::vector<Column>                  _columns;
+    std::vector<int64_t>                 _keys;
+    std::vector<uint32_t>                _hitSlots;
+    std::vector<Slot>                    _slots;
+    int64_t                              _denseBase;
+    std::vector<uint32_t>                _denseSlots;
+    vespalib::hash_map<int64_t, uint32_t> _sparseSlots;
+};
+
+}
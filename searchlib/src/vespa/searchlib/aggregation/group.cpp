@@ -346,6 +346,15 @@ Group::Value::preAggregate()
     }
 }
 
+void
+Group::Value::reserveChildren(size_t expected)
+{
+    GroupHash * childMap = _childInfo._childMap;
+    if ((childMap != nullptr) && (expected * 2 > childMap->capacity())) {
+        childMap->resize(expected * 2);
+    }
+}
+
 void
 Group::Value::postAggregate()
 {
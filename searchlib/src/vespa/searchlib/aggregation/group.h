@@ -78,6 +78,7 @@ public:
         void addOrderBy(ExpressionNode::UP orderBy, bool ascending);
         void select(const vespalib::ObjectPredicate &predicate, vespalib::ObjectOperation &operation);
         void preAggregate();
+        void reserveChildren(size_t expected);
         void postAggregate();
         void executeOrderBy();
         void sortById();
@@ -263,6 +264,8 @@ public:
     void selectMembers(const vespalib::ObjectPredicate &predicate, vespalib::ObjectOperation &operation) override;
 
     void preAggregate() { return _aggr.preAggregate(); }
+    // Only valid between preAggregate and postAggregate
+    void reserveChildren(size_t expected) { _aggr.reserveChildren(expected); }
     template <typename Doc>
     VESPA_DLL_LOCAL void aggregate(const Grouping & grouping, uint32_t currentLevel, const Doc & docId, HitRank rank);
 
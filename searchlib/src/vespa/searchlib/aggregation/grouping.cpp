@@ -2,6 +2,7 @@
 
 #include "grouping.h"
 #include "hitsaggregationresult.h"
+#include <vespa/searchlib/attribute/attributevector.h>
 #include <vespa/searchlib/attribute/stringbase.h>
 #include <vespa/searchlib/common/idocumentmetastore.h>
 #include <vespa/searchlib/expression/attributenode.h>
@@ -51,6 +52,18 @@ Deserializer& operator >> (Deserializer &is, LevelListDeserializer helper) {
     return is;
 }
 
+// Number of unique values in the attribute classifying the level, or 0 if not known
+uint64_t
+uniqueValueCount(const GroupingLevel & level)
+{
+    const auto * attrNode = dynamic_cast<const AttributeNode *>(level.getExpression().getRoot());
+    if (attrNode == nullptr) {
+        return 0;
+    }
+    const auto * attr = dynamic_cast<const AttributeVector *>(attrNode->getAttribute());
+    return (attr != nullptr) ? attr->getUniqueValueCount() : 0;
+}
+
 void
 selectGroups(const vespalib::ObjectPredicate &p, vespalib::ObjectOperation &op,
              Group &group, uint32_t first, uint32_t last, uint32_t curr)
@@ -228,6 +241,32 @@ Grouping::preAggregate(bool isOrdered)
     _root.preAggregate();
 }
 
+size_t
+Grouping::reserveFirstLevelGroups(uint32_t groupsBefore, size_t sampledHits, size_t totalHits)
+{
+    uint32_t groups = _root.getChildrenSize();
+    if (_levels.empty() || (sampledHits == 0) || (totalHits <= sampledHits) || (groups <= groupsBefore)) {
+        return 0;
+    }
+    size_t expected = groups + (groups - groupsBefore) * (totalHits - sampledHits) / sampledHits;
+    const GroupingLevel & level = _levels[0];
+    if ((level.getPrecision() > 0) && !level.allowMoreGroups(expected)) {
+        // ordered levels stop adding groups when precision is reached
+        expected = level.getPrecision();
+    }
+    if (level.getMaxGroups() > 0) {
+        expected = std::min(expected, size_t(level.getMaxGroups()));
+    }
+    uint64_t uniqueValues = uniqueValueCount(level);
+    if (uniqueValues > 0) {
+        // one extra group for documents without a value
+        expected = std::min(expected, size_t(uniqueValues + 1));
+    }
+    expected = std::max(size_t(groups), std::min(expected, MAX_RESERVED_FIRST_LEVEL_GROUPS));
+    _root.reserveChildren(expected);
+    return expected;
+}
+
 void
 Grouping::aggregate(DocId from, DocId to)
 {
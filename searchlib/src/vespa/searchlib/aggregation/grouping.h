@@ -19,6 +19,7 @@ class Grouping : public vespalib::Identifiable
 public:
     using GroupingLevelList = std::vector<GroupingLevel>;
     using UP = std::unique_ptr<Grouping>;
+    static constexpr size_t MAX_RESERVED_FIRST_LEVEL_GROUPS = 1 << 16;
 
 private:
     uint32_t                 _id;         // client id for this grouping
@@ -72,6 +73,18 @@ public:
     void mergePartial(const Grouping & b);
     void postMerge();
     void preAggregate(bool isOrdered);
+    /**
+     * Presizes the first level group table after a sample of the hits
+     * has been aggregated, by extrapolating the number of new groups
+     * seen in the sample to the remaining hits. Avoids repeated
+     * rehashing of the group ids when there are many distinct groups.
+     * The estimate is capped by the precision and max groups of the
+     * level, the number of unique values in the attribute classifying
+     * the level (when known) and MAX_RESERVED_FIRST_LEVEL_GROUPS.
+     *
+     * @return the number of groups reserved for, 0 if nothing was reserved
+     **/
+    size_t reserveFirstLevelGroups(uint32_t groupsBefore, size_t sampledHits, size_t totalHits);
     void prune(const Grouping & b);
     void aggregate(DocId docId, HitRank rank);
     void aggregate(const document::Document & doc, HitRank rank);
@@ -133,6 +133,7 @@ public:
     int64_t getMaxGroups() const noexcept { return _maxGroups; }
     int64_t getPrecision() const noexcept { return _precision; }
     bool        isFrozen() const noexcept { return _frozen; }
+    bool       hasFilter() const noexcept { return _filter.get() != nullptr; }
     bool    allowMoreGroups(size_t sz) const noexcept { return (!_frozen && (!_isOrdered || (sz < (uint64_t)_precision))); }
     const ExpressionTree & getExpression() const { return _classify; }
     ExpressionTree & getExpression() { return _classify; }
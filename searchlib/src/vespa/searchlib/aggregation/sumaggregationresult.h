@@ -16,6 +16,8 @@ public:
     ~SumAggregationResult() override;
     void visitMembers(vespalib::ObjectVisitor &visitor) const override;
     const NumericResultNode & getSum() const { return *_sum; }
+    // Adds a sum computed outside aggregate(), as done by columnar aggregation
+    void addPartialSum(const ResultNode & sum) { _sum->add(sum); }
 private:
     const ResultNode & onGetRank() const override { return getSum(); }
     void onPrepare(const ResultNode & result, bool useForInit) override;
@@ -22,6 +22,7 @@
 #include <vespa/searchlib/util/file_settings.h>
 #include <vespa/vespalib/util/jsonwriter.h>
 #include <vespa/vespalib/util/exceptions.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
 #include <vespa/vespalib/util/mmap_file_allocator_factory.h>
 #include <vespa/vespalib/util/size_literals.h>
 #include <thread>
@@ -73,6 +74,9 @@ make_memory_allocator(const std::string& name, const search::attribute::Config&
     if (allow_paged(config)) {
         return vespalib::alloc::MmapFileAllocatorFactory::instance().make_memory_allocator(name);
     }
+    if (config.huge_pages()) {
+        return std::make_unique<vespalib::alloc::HugePageAllocator>();
+    }
     return {};
 }
 
@@ -32,6 +32,7 @@ private:
     using ConstArrayRef = std::span<const ElemT>;
 
     ArrayStore _store;
+    std::unique_ptr<vespalib::datastore::ICompactionContext> _compaction_context; // Ongoing incremental compaction
 public:
     MultiValueMapping(const MultiValueMapping &) = delete;
     MultiValueMapping & operator = (const MultiValueMapping &) = delete;
@@ -65,13 +66,24 @@ public:
     vespalib::MemoryUsage getArrayStoreMemoryUsage() const override;
     vespalib::MemoryUsage update_stat(const CompactionStrategy& compaction_strategy);
     bool consider_compact(const CompactionStrategy &compactionStrategy) {
+        if (_compaction_context) {
+            compact_step(compactionStrategy);
+            return true;
+        }
         if (_store.consider_compact()) {
             compact_worst(compactionStrategy);
             return true;
         }
         return false;
     }
+    /*
+     * Compact worst buffers. If the compaction strategy limits the number of
+     * entries moved per step then only the first step is performed here, and
+     * the remaining steps are performed by subsequent calls to consider_compact().
+     */
     void compact_worst(const CompactionStrategy& compaction_strategy);
+    void compact_step(const CompactionStrategy& compaction_strategy);
+    bool is_compacting() const noexcept { return static_cast<bool>(_compaction_context); }
     bool has_free_lists_enabled() const { return _store.has_free_lists_enabled(); }
     // Set compaction spec. Only used by unit tests.
     void set_compaction_spec(vespalib::datastore::CompactionSpec compaction_spec) noexcept { _store.set_compaction_spec(compaction_spec); }
@@ -4,6 +4,7 @@
 
 #include "multi_value_mapping.h"
 #include <vespa/vespalib/datastore/array_store.hpp>
+#include <limits>
 
 namespace search::attribute {
 
@@ -13,7 +14,8 @@ MultiValueMapping<ElemT,RefT>::MultiValueMapping(const vespalib::datastore::Arra
                                                   const vespalib::GrowStrategy &gs,
                                                   std::shared_ptr<vespalib::alloc::MemoryAllocator> memory_allocator)
   : MultiValueMappingBase(gs, ArrayStore::getGenerationHolderLocation(_store), memory_allocator),
-    _store(storeCfg, std::move(memory_allocator), ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size))
+    _store(storeCfg, std::move(memory_allocator), ArrayStoreTypeMapper(storeCfg.max_type_id(), array_store_grow_factor, max_buffer_size)),
+    _compaction_context()
 {
 }
 
@@ -45,9 +47,31 @@ template <typename ElemT, typename RefT>
 void
 MultiValueMapping<ElemT,RefT>::compact_worst(const CompactionStrategy& compaction_strategy)
 {
+    if (_compaction_context) {
+        _compaction_context->compact(std::span<AtomicEntryRef>(&_indices[0], _indices.size()));
+        _compaction_context.reset();
+    }
     vespalib::datastore::ICompactionContext::UP compactionContext(_store.compact_worst(compaction_strategy));
     if (compactionContext) {
-        compactionContext->compact(std::span<AtomicEntryRef>(&_indices[0], _indices.size()));
+        if (compaction_strategy.get_max_compact_step_entries() == 0) {
+            compactionContext->compact(std::span<AtomicEntryRef>(&_indices[0], _indices.size()));
+        } else {
+            _compaction_context = std::move(compactionContext);
+            compact_step(compaction_strategy);
+        }
+    }
+}
+
+template <typename ElemT, typename RefT>
+void
+MultiValueMapping<ElemT,RefT>::compact_step(const CompactionStrategy& compaction_strategy)
+{
+    size_t max_entries = compaction_strategy.get_max_compact_step_entries();
+    if (max_entries == 0) {
+        max_entries = std::numeric_limits<size_t>::max();
+    }
+    if (_compaction_context->compact_step(std::span<AtomicEntryRef>(&_indices[0], _indices.size()), max_entries)) {
+        _compaction_context.reset();
     }
 }
 
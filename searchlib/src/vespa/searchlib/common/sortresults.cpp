@@ -7,6 +7,7 @@
 #include <vespa/searchlib/attribute/make_sort_blob_writer.h>
 #include <vespa/vespalib/util/array.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
 
 using vespalib::Issue;
 
@@ -26,6 +27,19 @@ namespace {
 
 constexpr size_t MMAP_LIMIT = 0x2000000;
 
+// Select candidates on a sort data prefix before sorting when at most this fraction of the hits is needed in order
+constexpr uint32_t TOP_N_SELECT_RATIO = 4;
+
+uint64_t
+sortPrefix(const uint8_t * sortData, uint32_t len)
+{
+    uint64_t prefix = 0;
+    for (uint32_t i = 0; i < sizeof(uint64_t); ++i) {
+        prefix = (prefix << 8) | ((i < len) ? sortData[i] : 0u);
+    }
+    return prefix;
+}
+
 template<typename T>
 class RadixHelper
 {
@@ -446,9 +460,53 @@ public:
 };
 
 
+uint64_t
+FastS_SortSpec::getSortPrefix(const RankedHit & hit)
+{
+    uint32_t len = 0;
+    for (size_t i(0); (i < _vectors.size()) && (len < sizeof(uint64_t)); ++i) {
+        len += initSortData(_vectors[i], hit, len);
+    }
+    return sortPrefix(_binarySortData.data(), len);
+}
+
+uint32_t
+FastS_SortSpec::selectTopCandidates(RankedHit a[], uint32_t n, uint32_t topn)
+{
+    // A smaller prefix of the sort data means a smaller sort blob, and
+    // a prefix shorter than 8 bytes is zero padded, which keeps that
+    // order. All hits with a prefix not above the topn'th smallest
+    // prefix are therefore candidates for the topn best hits.
+    freeSortData();
+    _binarySortData.resize(64);
+    std::vector<uint64_t, vespalib::allocator_large<uint64_t>> prefixes(n, 0);
+    for (uint32_t i(0); (i < n) && !_doom.hard_doom(); ++i) {
+        prefixes[i] = getSortPrefix(a[i]);
+    }
+    std::vector<uint64_t, vespalib::allocator_large<uint64_t>> selected(prefixes);
+    std::nth_element(selected.begin(), selected.begin() + (topn - 1), selected.end());
+    uint64_t limit = selected[topn - 1];
+    std::vector<RankedHit, vespalib::allocator_large<RankedHit>> rest;
+    rest.reserve(n - topn);
+    uint32_t numCandidates(0);
+    for (uint32_t i(0); i < n; ++i) {
+        if (prefixes[i] <= limit) {
+            a[numCandidates++] = a[i];
+        } else {
+            rest.push_back(a[i]);
+        }
+    }
+    std::copy(rest.begin(), rest.end(), a + numCandidates);
+    return numCandidates;
+}
+
 void
 FastS_SortSpec::sortResults(RankedHit a[], uint32_t n, uint32_t topn)
 {
+    if ((topn > 0) && (uint64_t(topn) * TOP_N_SELECT_RATIO <= n)) {
+        // Only candidates get full sort data; the other hits are left after them
+        n = selectTopCandidates(a, n, topn);
+    }
     initSortData(a, n);
     {
         SortData * sortData = _sortDataArray.data();
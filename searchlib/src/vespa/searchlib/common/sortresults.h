@@ -108,6 +108,8 @@ private:
     bool Add(search::attribute::IAttributeContext & vecMan, const search::common::FieldSortSpec & field_sort_spec);
     void initSortData(const search::RankedHit *a, uint32_t n);
     int initSortData(const VectorRef & vec, const search::RankedHit & hit, size_t offset);
+    uint64_t getSortPrefix(const search::RankedHit & hit);
+    uint32_t selectTopCandidates(search::RankedHit a[], uint32_t n, uint32_t topn);
 
 public:
     FastS_SortSpec(const FastS_SortSpec &) = delete;
@@ -5,6 +5,7 @@
 #include "field_length_scanner.h"
 #include "fusion_input_index.h"
 #include "fusion_output_index.h"
+#include "fusion_progress.h"
 #include "dictionarywordreader.h"
 #include "wordnummapper.h"
 #include <vespa/fastos/file.h>
@@ -57,12 +58,14 @@ createTmpPath(const std::string & base, uint32_t index) {
 
 }
 
-FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token)
+FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token,
+                         FusionProgress* progress)
     : _id(id),
       _field_name(SchemaUtil::IndexIterator(fusion_out_index.get_schema(), id).getName()),
       _field_dir(fusion_out_index.get_path() + "/" + _field_name),
       _fusion_out_index(fusion_out_index),
       _flush_token(std::move(flush_token)),
+      _progress(progress),
       _word_readers(),
       _word_heap(),
       _word_aggregator(),
@@ -73,6 +76,7 @@ FieldMerger::FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index,
       _writer(),
       _field_length_scanner(),
       _open_reader_idx(std::numeric_limits<uint32_t>::max()),
+      _start_time(),
       _state(State::MERGE_START),
       _failed(false)
 {
@@ -207,6 +211,9 @@ FieldMerger::renumber_word_ids_finish()
     _word_heap.reset();
     _num_word_ids = _word_aggregator->getWordNum();
     _word_aggregator.reset();
+    if (_progress != nullptr) {
+        _progress->set_num_words(_id, _num_word_ids);
+    }
 
     // Close files
     for (auto &i : _word_readers) {
@@ -437,6 +444,9 @@ void
 FieldMerger::merge_postings_main()
 {
     _heap->merge(*_writer, *_flush_token);
+    if (_progress != nullptr) {
+        _progress->set_merged_words(_id, _writer->getSparseWordNum());
+    }
     if (_flush_token->stop_requested()) {
         _failed = true;
     } else if (_heap->empty()) {
@@ -487,6 +497,10 @@ FieldMerger::merge_field_start()
     std::filesystem::create_directory(std::filesystem::path(_field_dir));
 
     LOG(debug, "merge_field for field %s dir %s", _field_name.c_str(), _field_dir.c_str());
+    _start_time = vespalib::steady_clock::now();
+    if (_progress != nullptr) {
+        _progress->start_field(_id);
+    }
 
     make_tmp_dirs();
 
@@ -512,7 +526,10 @@ FieldMerger::merge_field_finish()
         return;
     }
 
-    LOG(debug, "Finished merge_field for field %s dir %s", _field_name.c_str(), _field_dir.c_str());
+    double elapsed = vespalib::to_s(vespalib::steady_clock::now() - _start_time);
+    LOG(debug, "Finished merge_field for field %s dir %s, %" PRIu64 " words in %.3f s (%.0f words/s)",
+        _field_name.c_str(), _field_dir.c_str(), _num_word_ids, elapsed,
+        (elapsed > 0.0) ? (_num_word_ids / elapsed) : 0.0);
 
     _state = State::MERGE_DONE;
 }
@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <vespa/vespalib/util/time.h>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -19,6 +20,7 @@ class FieldLengthScanner;
 class FieldReader;
 class FieldWriter;
 class FusionOutputIndex;
+class FusionProgress;
 class WordAggregator;
 class WordNumMapping;
 
@@ -46,6 +48,7 @@ class FieldMerger
     const std::string         _field_dir;
     const FusionOutputIndex      & _fusion_out_index;
     std::shared_ptr<IFlushToken>   _flush_token;
+    FusionProgress               * _progress;
     std::vector<std::unique_ptr<DictionaryWordReader>> _word_readers;
     std::unique_ptr<PostingPriorityQueueMerger<DictionaryWordReader, WordAggregator>> _word_heap;
     std::unique_ptr<WordAggregator> _word_aggregator;
@@ -56,6 +59,7 @@ class FieldMerger
     std::unique_ptr<FieldWriter> _writer;
     std::shared_ptr<FieldLengthScanner> _field_length_scanner;
     uint32_t _open_reader_idx;
+    vespalib::steady_time _start_time;
     State _state;
     bool _failed;
 
@@ -80,7 +84,8 @@ class FieldMerger
     bool merge_postings_finish();
     void merge_postings_failed();
 public:
-    FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token);
+    FieldMerger(uint32_t id, const FusionOutputIndex& fusion_out_index, std::shared_ptr<IFlushToken> flush_token,
+                FusionProgress* progress);
     ~FieldMerger();
     void merge_field_start();
     void merge_field_finish();
@@ -4,6 +4,7 @@
 #include "field_merger.h"
 #include "field_merger_task.h"
 #include "fusion_output_index.h"
+#include "fusion_progress.h"
 #include <vespa/searchcommon/common/schema.h>
 #include <vespa/vespalib/util/cpu_usage.h>
 #include <vespa/vespalib/util/executor.h>
@@ -13,10 +14,12 @@ using vespalib::CpuUsage;
 
 namespace search::diskindex {
 
-FieldMergersState::FieldMergersState(const FusionOutputIndex& fusion_out_index, vespalib::Executor& executor, std::shared_ptr<IFlushToken> flush_token)
+FieldMergersState::FieldMergersState(const FusionOutputIndex& fusion_out_index, vespalib::Executor& executor, std::shared_ptr<IFlushToken> flush_token,
+                                     FusionProgress* progress)
     : _fusion_out_index(fusion_out_index),
       _executor(executor),
       _flush_token(std::move(flush_token)),
+      _progress(progress),
       _done(_fusion_out_index.get_schema().getNumIndexFields()),
       _failed(0u),
       _field_mergers(_fusion_out_index.get_schema().getNumIndexFields())
@@ -32,7 +35,7 @@ FieldMerger&
 FieldMergersState::alloc_field_merger(uint32_t id)
 {
     assert(id < _field_mergers.size());
-    auto field_merger = std::make_unique<FieldMerger>(id, _fusion_out_index, _flush_token);
+    auto field_merger = std::make_unique<FieldMerger>(id, _fusion_out_index, _flush_token, _progress);
     auto& result = *field_merger;
     assert(!_field_mergers[id]);
     _field_mergers[id] = std::move(field_merger);
@@ -57,6 +60,9 @@ FieldMergersState::field_merger_done(FieldMerger& field_merger, bool failed)
     if (failed) {
         ++_failed;
     }
+    if (_progress != nullptr) {
+        _progress->finish_field(field_merger.get_id(), failed);
+    }
     destroy_field_merger(field_merger);
 }
 
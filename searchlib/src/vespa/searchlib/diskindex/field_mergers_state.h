@@ -13,6 +13,7 @@ namespace search::diskindex {
 
 class FieldMerger;
 class FusionOutputIndex;
+class FusionProgress;
 
 /*
  * This class has ownership of active field mergers until they are
@@ -22,13 +23,15 @@ class FieldMergersState {
     const FusionOutputIndex&                  _fusion_out_index;
     vespalib::Executor&                       _executor;
     std::shared_ptr<IFlushToken>              _flush_token;
+    FusionProgress*                           _progress;
     vespalib::CountDownLatch                  _done;
     std::atomic<uint32_t>                     _failed;
     std::vector<std::unique_ptr<FieldMerger>> _field_mergers;
 
     void destroy_field_merger(FieldMerger& field_merger);
 public:
-    FieldMergersState(const FusionOutputIndex& fusion_out_index, vespalib::Executor& executor, std::shared_ptr<IFlushToken> flush_token);
+    FieldMergersState(const FusionOutputIndex& fusion_out_index, vespalib::Executor& executor, std::shared_ptr<IFlushToken> flush_token,
+                      FusionProgress* progress);
     ~FieldMergersState();
     FieldMerger& alloc_field_merger(uint32_t id);
     void field_merger_done(FieldMerger& field_merger, bool failed);
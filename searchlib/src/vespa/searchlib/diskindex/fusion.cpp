@@ -2,6 +2,7 @@
 
 #include "fusion.h"
 #include "fusion_input_index.h"
+#include "fusion_progress.h"
 #include "field_merger.h"
 #include "field_mergers_state.h"
 #include <vespa/fastos/file.h>
@@ -56,6 +57,27 @@ uint32_t calc_trimmed_doc_id_limit(const SelectorArray& selector, const std::vec
     return trimmed_doc_id_limit;
 }
 
+/*
+ * Returns the size of the files for the given field in the input indexes.
+ */
+uint64_t
+field_input_size(const std::vector<FusionInputIndex>& old_indexes, const std::string& field_name)
+{
+    uint64_t size = 0;
+    for (const auto& old_index : old_indexes) {
+        std::error_code ec;
+        std::filesystem::directory_iterator it(std::filesystem::path(old_index.getPath()) / field_name, ec);
+        for (; !ec && it != std::filesystem::directory_iterator(); it.increment(ec)) {
+            std::error_code size_ec;
+            auto file_size = it->file_size(size_ec);
+            if (!size_ec) {
+                size += file_size;
+            }
+        }
+    }
+    return size;
+}
+
 }
 
 Fusion::Fusion(const Schema& schema, const std::string& dir,
@@ -63,17 +85,29 @@ Fusion::Fusion(const Schema& schema, const std::string& dir,
                const TuneFileIndexing& tuneFileIndexing,
                const FileHeaderContext& fileHeaderContext)
     : _old_indexes(createInputIndexes(sources, selector)),
-      _fusion_out_index(schema, dir, _old_indexes, calc_trimmed_doc_id_limit(selector, sources), tuneFileIndexing, fileHeaderContext)
+      _fusion_out_index(schema, dir, _old_indexes, calc_trimmed_doc_id_limit(selector, sources), tuneFileIndexing, fileHeaderContext),
+      _progress()
 {
 }
 
 Fusion::~Fusion() = default;
 
+void
+Fusion::set_progress(std::shared_ptr<FusionProgress> progress)
+{
+    _progress = std::move(progress);
+}
+
 bool
 Fusion::mergeFields(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken> flush_token)
 {
-    FieldMergersState field_mergers_state(_fusion_out_index, shared_executor, flush_token);
+    FieldMergersState field_mergers_state(_fusion_out_index, shared_executor, flush_token, _progress.get());
     const Schema &schema = getSchema();
+    if (_progress) {
+        for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
+            _progress->add_field(iter.getIndex(), iter.getName(), field_input_size(_old_indexes, iter.getName()));
+        }
+    }
     for (SchemaUtil::IndexIterator iter(schema); iter.isValid(); ++iter) {
         auto& field_merger = field_mergers_state.alloc_field_merger(iter.getIndex());
         field_mergers_state.schedule_task(field_merger);
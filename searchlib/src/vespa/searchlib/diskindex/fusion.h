@@ -15,6 +15,8 @@ namespace vespalib { template <typename T> class Array; }
 
 namespace search::diskindex {
 
+class FusionProgress;
+
 using SelectorArray = vespalib::Array<uint8_t>;
 
 /*
@@ -34,6 +36,7 @@ private:
 
     std::vector<FusionInputIndex> _old_indexes;
     FusionOutputIndex _fusion_out_index;
+    std::shared_ptr<FusionProgress> _progress;
 public:
     Fusion(const Fusion &) = delete;
     Fusion& operator=(const Fusion &) = delete;
@@ -44,6 +47,8 @@ public:
     ~Fusion();
     void set_dynamic_k_pos_index_format(bool dynamic_k_pos_index_format) { _fusion_out_index.set_dynamic_k_pos_index_format(dynamic_k_pos_index_format); }
     void set_force_small_merge_chunk(bool force_small_merge_chunk) { _fusion_out_index.set_force_small_merge_chunk(force_small_merge_chunk); }
+    // Per field progress is reported to the given object while merging
+    void set_progress(std::shared_ptr<FusionProgress> progress);
     bool merge(vespalib::Executor& shared_executor, std::shared_ptr<IFlushToken> flush_token);
 };
 
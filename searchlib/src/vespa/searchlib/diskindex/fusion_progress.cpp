@@ -0,0 +1,130 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "fusion_progress.h"
+#include <cassert>
+
+using vespalib::steady_clock;
+using vespalib::steady_time;
+
+namespace search::diskindex {
+
+FusionProgress::Field::Field() noexcept
+    : Field(std::string(), 0)
+{
+}
+
+FusionProgress::Field::Field(std::string name_in, uint64_t input_size_in) noexcept
+    : name(std::move(name_in)),
+      input_size(input_size_in),
+      num_words(0),
+      merged_words(0),
+      start_time(),
+      end_time(),
+      state(State::PENDING)
+{
+}
+
+FusionProgress::Field::Field(const Field&) = default;
+FusionProgress::Field::Field(Field&&) noexcept = default;
+FusionProgress::Field::~Field() = default;
+FusionProgress::Field& FusionProgress::Field::operator=(const Field&) = default;
+FusionProgress::Field& FusionProgress::Field::operator=(Field&&) noexcept = default;
+
+vespalib::duration
+FusionProgress::Field::elapsed(steady_time now) const noexcept
+{
+    switch (state) {
+    case State::PENDING:
+        return vespalib::duration::zero();
+    case State::MERGING:
+        return now - start_time;
+    default:
+        return end_time - start_time;
+    }
+}
+
+FusionProgress::FusionProgress()
+    : _lock(),
+      _start_time(steady_clock::now()),
+      _fields()
+{
+}
+
+FusionProgress::~FusionProgress() = default;
+
+void
+FusionProgress::add_field(uint32_t id, std::string name, uint64_t input_size)
+{
+    std::lock_guard guard(_lock);
+    if (id >= _fields.size()) {
+        _fields.resize(id + 1);
+    }
+    _fields[id] = Field(std::move(name), input_size);
+}
+
+void
+FusionProgress::start_field(uint32_t id)
+{
+    std::lock_guard guard(_lock);
+    assert(id < _fields.size());
+    auto& field = _fields[id];
+    field.start_time = steady_clock::now();
+    field.state = State::MERGING;
+}
+
+void
+FusionProgress::set_num_words(uint32_t id, uint64_t num_words)
+{
+    std::lock_guard guard(_lock);
+    assert(id < _fields.size());
+    _fields[id].num_words = num_words;
+}
+
+void
+FusionProgress::set_merged_words(uint32_t id, uint64_t merged_words)
+{
+    std::lock_guard guard(_lock);
+    assert(id < _fields.size());
+    _fields[id].merged_words = merged_words;
+}
+
+void
+FusionProgress::finish_field(uint32_t id, bool failed)
+{
+    std::lock_guard guard(_lock);
+    assert(id < _fields.size());
+    auto& field = _fields[id];
+    field.end_time = steady_clock::now();
+    if (field.state == State::PENDING) {
+        field.start_time = field.end_time;
+    }
+    field.state = failed ? State::FAILED : State::DONE;
+    if (!failed) {
+        field.merged_words = field.num_words;
+    }
+}
+
+std::vector<FusionProgress::Field>
+FusionProgress::get_fields() const
+{
+    std::lock_guard guard(_lock);
+    return _fields;
+}
+
+const char*
+FusionProgress::state_name(State state) noexcept
+{
+    switch (state) {
+    case State::PENDING:
+        return "pending";
+    case State::MERGING:
+        return "merging";
+    case State::DONE:
+        return "done";
+    case State::FAILED:
+        return "failed";
+    }
+    return "unknown";
+}
+
+}
@@ -0,0 +1,58 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include <vespa/vespalib/util/time.h>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace search::diskindex {
+
+/*
+ * Progress of the field mergers in a fusion, used to explore a running
+ * fusion or the last completed one. Thread safe.
+ */
+class FusionProgress {
+public:
+    enum class State { PENDING, MERGING, DONE, FAILED };
+
+    struct Field {
+        std::string           name;
+        uint64_t              input_size;
+        uint64_t              num_words;    // Known after word numbers have been assigned
+        uint64_t              merged_words;
+        vespalib::steady_time start_time;
+        vespalib::steady_time end_time;
+        State                 state;
+
+        Field() noexcept;
+        Field(std::string name_in, uint64_t input_size_in) noexcept;
+        Field(const Field&);
+        Field(Field&&) noexcept;
+        ~Field();
+        Field& operator=(const Field&);
+        Field& operator=(Field&&) noexcept;
+        vespalib::duration elapsed(vespalib::steady_time now) const noexcept;
+    };
+
+private:
+    mutable std::mutex          _lock;
+    const vespalib::steady_time _start_time;
+    std::vector<Field>          _fields; // Indexed by field id
+
+public:
+    FusionProgress();
+    ~FusionProgress();
+    void add_field(uint32_t id, std::string name, uint64_t input_size);
+    void start_field(uint32_t id);
+    void set_num_words(uint32_t id, uint64_t num_words);
+    void set_merged_words(uint32_t id, uint64_t merged_words);
+    void finish_field(uint32_t id, bool failed);
+    vespalib::steady_time get_start_time() const noexcept { return _start_time; }
+    std::vector<Field> get_fields() const;
+    static const char* state_name(State state) noexcept;
+};
+
+}
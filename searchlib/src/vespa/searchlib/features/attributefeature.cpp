@@ -113,6 +113,15 @@ public:
      * @param attribute The attribute vector to use.
      */
     explicit SingleAttributeExecutor(const T & attribute) : _attribute(attribute) { }
+    static feature_t get_value(const T & attribute, uint32_t docId) {
+        typename T::LoadedValueType v = attribute.getFast(docId);
+        return __builtin_expect(attribute::isUndefined(v), false)
+               ? attribute::getUndefined<feature_t>()
+               : util::getAsFeature(v);
+    }
+    static feature_t get_direct_value(const void *ctx, uint32_t docId) {
+        return get_value(*static_cast<const T *>(ctx), docId);
+    }
     void handle_bind_outputs(std::span<fef::NumberOrObject> outputs_in) override {
         fef::FeatureExecutor::handle_bind_outputs(outputs_in);
         auto o = outputs().get_bound();
@@ -121,6 +130,10 @@ public:
         o[3].as_number = 1;  // count
     }
     void execute(uint32_t docId) override;
+    void execute_batch(std::span<const uint32_t> docids, size_t output_idx, std::span<feature_t> numbers) override;
+    fef::DirectNumber get_direct_number(size_t output_idx) const override {
+        return (output_idx == 0) ? fef::DirectNumber(&get_direct_value, &_attribute) : fef::DirectNumber();
+    }
 };
 
 class BoolAttributeExecutor final : public fef::FeatureExecutor {
@@ -228,12 +241,22 @@ template <typename T>
 void
 SingleAttributeExecutor<T>::execute(uint32_t docId)
 {
-    typename T::LoadedValueType v = _attribute.getFast(docId);
     // value
     auto o = outputs().get_bound();
-    o[0].as_number = __builtin_expect(attribute::isUndefined(v), false)
-                     ? attribute::getUndefined<feature_t>()
-                     : util::getAsFeature(v);
+    o[0].as_number = get_value(_attribute, docId);
+}
+
+template <typename T>
+void
+SingleAttributeExecutor<T>::execute_batch(std::span<const uint32_t> docids, size_t output_idx, std::span<feature_t> numbers)
+{
+    if (output_idx != 0) {
+        fef::FeatureExecutor::execute_batch(docids, output_idx, numbers);
+        return;
+    }
+    for (size_t i = 0; i < docids.size(); ++i) {
+        numbers[i] = get_value(_attribute, docids[i]);
+    }
 }
 
 template <typename BaseType>
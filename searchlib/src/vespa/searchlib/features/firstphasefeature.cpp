@@ -17,6 +17,12 @@ FirstPhaseExecutor::execute(uint32_t)
     outputs().set_number(0, inputs().get_number(0));
 }
 
+void
+FirstPhaseExecutor::execute_batch(std::span<const uint32_t> docids, size_t, std::span<feature_t> numbers)
+{
+    inputs().get_numbers(0, docids, numbers);
+}
+
 
 FirstPhaseBlueprint::FirstPhaseBlueprint() :
     Blueprint("firstPhase")
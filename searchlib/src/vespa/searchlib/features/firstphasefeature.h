@@ -13,6 +13,7 @@ class FirstPhaseExecutor : public fef::FeatureExecutor {
 public:
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    void execute_batch(std::span<const uint32_t> docids, size_t output_idx, std::span<feature_t> numbers) override;
 };
 
 /**
@@ -2,16 +2,20 @@
 
 #include "onnx_feature.h"
 #include <vespa/searchlib/fef/properties.h>
+#include <vespa/searchlib/fef/indexproperties.h>
 #include <vespa/searchlib/fef/onnx_model.h>
 #include <vespa/searchlib/fef/featureexecutor.h>
 #include <vespa/eval/eval/value.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/fast_value.h>
 #include <vespa/eval/eval/value_codec.h>
+#include <vespa/eval/eval/cell_type.h>
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/stash.h>
 #include <vespa/vespalib/util/issue.h>
+#include <algorithm>
 #include <cctype>
+#include <cstring>
 
 #include <vespa/log/log.h>
 LOG_SETUP(".features.onnx_feature");
@@ -23,6 +27,9 @@ using search::fef::IIndexEnvironment;
 using search::fef::IQueryEnvironment;
 using search::fef::ParameterList;
 using vespalib::Stash;
+using vespalib::eval::CellTypeUtils;
+using vespalib::eval::DenseValueView;
+using vespalib::eval::TypedCells;
 using vespalib::eval::Value;
 using vespalib::eval::ValueType;
 using vespalib::eval::TensorSpec;
@@ -70,8 +77,118 @@ std::string my_dry_run(const Onnx &model, const Onnx::WireInfo &wire) {
     return error_msg;
 }
 
+size_t dense_bytes(const ValueType &type) {
+    return CellTypeUtils::mem_size(type.cell_type(), type.dense_subspace_size());
+}
+
 } // <unnamed>
 
+/**
+ * Evaluates an onnx model for a batch of documents with a single
+ * model invocation by stacking the inputs of the documents along the
+ * outermost dimension. Incomplete batches are padded by repeating the
+ * inputs of the last document. The result cells of all prepared
+ * documents are kept until the next call to prepare.
+ *
+ * load() copies the results of one prepared document into buffers
+ * owned by the evaluator. The values returned by result() view these
+ * buffers and stay valid (with the same content) until the next call
+ * to load(), independent of later calls to prepare().
+ */
+class OnnxBatchEvaluator
+{
+private:
+    const Onnx::WireInfo          &_wire_info;
+    const Onnx::WireInfo          &_batch_wire_info;
+    size_t                         _batch_size;
+    Onnx::EvalContext              _eval_context;
+    std::vector<std::vector<char>> _params;
+    std::vector<uint32_t>          _docids;
+    std::vector<std::vector<char>> _results;
+    std::vector<std::vector<char>> _current;
+    std::vector<DenseValueView>    _current_values;
+
+    bool eval(std::span<const uint32_t> docids, const FeatureExecutor::Inputs &inputs) {
+        size_t num_params = _eval_context.num_params();
+        for (size_t j = 0; j < _batch_size; ++j) {
+            for (size_t i = 0; i < num_params; ++i) {
+                size_t bytes = dense_bytes(_wire_info.vespa_inputs[i]);
+                char *dst = _params[i].data() + (j * bytes);
+                if (j < docids.size()) {
+                    TypedCells cells = inputs.get_object(i, docids[j]).get().cells();
+                    assert(CellTypeUtils::mem_size(cells.type, cells.size) == bytes);
+                    memcpy(dst, cells.data, bytes);
+                } else {
+                    memcpy(dst, dst - bytes, bytes);
+                }
+            }
+        }
+        for (size_t i = 0; i < num_params; ++i) {
+            const auto &type = _batch_wire_info.vespa_inputs[i];
+            _eval_context.bind_param(i, DenseValueView(type, TypedCells(_params[i].data(), type.cell_type(), type.dense_subspace_size())));
+        }
+        try {
+            _eval_context.eval();
+        } catch (const Ort::Exception &ex) {
+            Issue::report("batched onnx model evaluation failed: %s", ex.what());
+            return false;
+        }
+        for (size_t r = 0; r < _eval_context.num_results(); ++r) {
+            const auto &cells = _eval_context.get_result(r).cells();
+            const char *src = static_cast<const char *>(cells.data);
+            _results[r].insert(_results[r].end(), src, src + (docids.size() * _current[r].size()));
+        }
+        _docids.insert(_docids.end(), docids.begin(), docids.end());
+        return true;
+    }
+
+public:
+    OnnxBatchEvaluator(const Onnx &model, const Onnx::WireInfo &wire_info, const Onnx::WireInfo &batch_wire_info, size_t batch_size)
+        : _wire_info(wire_info),
+          _batch_wire_info(batch_wire_info),
+          _batch_size(batch_size),
+          _eval_context(model, batch_wire_info),
+          _params(),
+          _docids(),
+          _results(wire_info.vespa_outputs.size()),
+          _current(),
+          _current_values()
+    {
+        for (const auto &type: batch_wire_info.vespa_inputs) {
+            _params.emplace_back(dense_bytes(type));
+        }
+        _current.reserve(wire_info.vespa_outputs.size());
+        _current_values.reserve(wire_info.vespa_outputs.size());
+        for (const auto &type: wire_info.vespa_outputs) {
+            _current.emplace_back(dense_bytes(type));
+            _current_values.emplace_back(type, TypedCells(_current.back().data(), type.cell_type(), type.dense_subspace_size()));
+        }
+    }
+    void prepare(std::span<const uint32_t> docids, const FeatureExecutor::Inputs &inputs) {
+        _docids.clear();
+        for (auto &results: _results) {
+            results.clear();
+        }
+        for (size_t pos = 0; pos < docids.size(); pos += _batch_size) {
+            eval(docids.subspan(pos, std::min(_batch_size, docids.size() - pos)), inputs);
+        }
+    }
+    // copy results for a prepared document into the current results, false if not prepared
+    bool load(uint32_t docid) {
+        auto pos = std::lower_bound(_docids.begin(), _docids.end(), docid);
+        if ((pos == _docids.end()) || (*pos != docid)) {
+            return false;
+        }
+        size_t idx = pos - _docids.begin();
+        for (size_t r = 0; r < _current.size(); ++r) {
+            size_t bytes = _current[r].size();
+            memcpy(_current[r].data(), _results[r].data() + (idx * bytes), bytes);
+        }
+        return true;
+    }
+    const Value &result(size_t idx) const { return _current_values[idx]; }
+};
+
 /**
  * Feature executor that evaluates an onnx model
  */
@@ -79,16 +196,35 @@ class OnnxFeatureExecutor : public FeatureExecutor
 {
 private:
     Onnx::EvalContext _eval_context;
+    std::unique_ptr<OnnxBatchEvaluator> _batch;
+    void use_own_results() {
+        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
+            outputs().set_object(i, _eval_context.get_result(i));
+        }
+    }
 public:
-    OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info)
-        : _eval_context(model, wire_info) {}
+    OnnxFeatureExecutor(const Onnx &model, const Onnx::WireInfo &wire_info, std::unique_ptr<OnnxBatchEvaluator> batch)
+        : _eval_context(model, wire_info), _batch(std::move(batch)) {}
     bool isPure() override { return true; }
     void handle_bind_outputs(std::span<fef::NumberOrObject>) override {
-        for (size_t i = 0; i < _eval_context.num_results(); ++i) {
-            outputs().set_object(i, _eval_context.get_result(i));
+        use_own_results();
+    }
+    void handle_prepare_batch(std::span<const uint32_t> docids) override {
+        if (_batch) {
+            _batch->prepare(docids, inputs());
         }
     }
-    void execute(uint32_t) override {
+    void execute(uint32_t docid) override {
+        if (_batch) {
+            // outputs view buffers owned by the batch evaluator, overwritten by the next load
+            if (_batch->load(docid)) {
+                for (size_t i = 0; i < _eval_context.num_results(); ++i) {
+                    outputs().set_object(i, _batch->result(i));
+                }
+                return;
+            }
+            use_own_results();
+        }
         for (size_t i = 0; i < _eval_context.num_params(); ++i) {
             _eval_context.bind_param(i, inputs().get_object(i).get());
         }
@@ -106,7 +242,9 @@ OnnxBlueprint::OnnxBlueprint(std::string_view baseName)
       _cache_token(),
       _debug_model(),
       _model(nullptr),
-      _wire_info()
+      _wire_info(),
+      _batch_wire_info(),
+      _batch_size(0)
 {
     assert((baseName == "onnx") || (baseName == "onnxModel"));
 }
@@ -173,6 +311,19 @@ OnnxBlueprint::setup(const IIndexEnvironment &env,
     } else {
         LOG(warning, "dry-run disabled for onnx model '%s'", model_cfg->name().c_str());
     }
+    size_t batch_size = fef::indexproperties::eval::OnnxBatchSize::lookup(env.getProperties());
+    if ((batch_size > 1) && (env.getFeatureMotivation() != env.FeatureMotivation::VERIFY_SETUP)) {
+        try {
+            _batch_wire_info = Onnx::WirePlanner::make_batched_wire_info(*_model, _wire_info, batch_size);
+        } catch (const Ort::Exception &ex) {
+            LOG(warning, "planning batched evaluation of onnx model '%s' failed: %s", model_cfg->name().c_str(), ex.what());
+        }
+        if (_batch_wire_info) {
+            _batch_size = batch_size;
+        } else {
+            LOG(info, "onnx model '%s' cannot be evaluated in batches of %zu", model_cfg->name().c_str(), batch_size);
+        }
+    }
     return true;
 }
 
@@ -180,7 +331,11 @@ FeatureExecutor &
 OnnxBlueprint::createExecutor(const IQueryEnvironment &, Stash &stash) const
 {
     assert(_model != nullptr);
-    return stash.create<OnnxFeatureExecutor>(*_model, _wire_info);
+    std::unique_ptr<OnnxBatchEvaluator> batch;
+    if (_batch_wire_info) {
+        batch = std::make_unique<OnnxBatchEvaluator>(*_model, _wire_info, *_batch_wire_info, _batch_size);
+    }
+    return stash.create<OnnxFeatureExecutor>(*_model, _wire_info, std::move(batch));
 }
 
 }
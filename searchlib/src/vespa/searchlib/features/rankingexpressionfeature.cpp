@@ -61,19 +61,32 @@ public:
 //-----------------------------------------------------------------------------
 
 /**
- * Implements the executor for compiled ranking expressions
+ * Implements the executor for compiled ranking expressions. Constant
+ * inputs are resolved once when binding inputs, and inputs offering
+ * direct access (like single value attributes) are read directly
+ * instead of through their executors. Remaining inputs are calculated
+ * lazily.
  **/
 class CompiledRankingExpressionExecutor : public fef::FeatureExecutor
 {
 private:
     typedef double (*arr_function)(const double *);
+    struct DirectInput {
+        uint32_t          idx;
+        fef::DirectNumber number;
+    };
     arr_function _ranking_function;
     std::vector<double> _params;
+    std::vector<double> _batch_params;
+    std::vector<uint32_t> _lazy_inputs;
+    std::vector<DirectInput> _direct_inputs;
 
+    void handle_bind_inputs(std::span<const fef::LazyValue> inputs) override;
 public:
     CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function);
     bool isPure() override { return true; }
     void execute(uint32_t docId) override;
+    void execute_batch(std::span<const uint32_t> docids, size_t output_idx, std::span<feature_t> numbers) override;
 };
 
 //-----------------------------------------------------------------------------
@@ -173,26 +186,61 @@ FastForestExecutor::execute(uint32_t)
 
 CompiledRankingExpressionExecutor::CompiledRankingExpressionExecutor(const CompiledFunction &compiled_function)
     : _ranking_function(compiled_function.get_function()),
-      _params(compiled_function.num_params(), 0.0)
+      _params(compiled_function.num_params(), 0.0),
+      _batch_params(),
+      _lazy_inputs(),
+      _direct_inputs()
 {
 }
 
 void
-CompiledRankingExpressionExecutor::execute(uint32_t)
+CompiledRankingExpressionExecutor::handle_bind_inputs(std::span<const fef::LazyValue> inputs_in)
 {
-    size_t i(0);
-    for (; (i + 4) < _params.size(); i += 4) {
-        _params[i+0] = inputs().get_number(i+0);
-        _params[i+1] = inputs().get_number(i+1);
-        _params[i+2] = inputs().get_number(i+2);
-        _params[i+3] = inputs().get_number(i+3);
+    _lazy_inputs.clear();
+    _direct_inputs.clear();
+    for (uint32_t i = 0; i < inputs_in.size(); ++i) {
+        const auto &input = inputs_in[i];
+        if (input.is_const()) {
+            _params[i] = input.as_number(0);
+        } else if (auto number = input.direct_number(); number.valid()) {
+            _direct_inputs.push_back({i, number});
+        } else {
+            _lazy_inputs.push_back(i);
+        }
     }
-    for (; i < _params.size(); ++i) {
-        _params[i] = inputs().get_number(i);
+    LOG(spam, "compiled expression with %zu inputs: %zu const, %zu direct, %zu lazy", inputs_in.size(),
+        inputs_in.size() - _direct_inputs.size() - _lazy_inputs.size(), _direct_inputs.size(), _lazy_inputs.size());
+}
+
+void
+CompiledRankingExpressionExecutor::execute(uint32_t docId)
+{
+    for (uint32_t idx: _lazy_inputs) {
+        _params[idx] = inputs().get_number(idx);
+    }
+    for (const auto &input: _direct_inputs) {
+        _params[input.idx] = input.number.get(docId);
     }
     outputs().set_number(0, _ranking_function(_params.data()));
 }
 
+void
+CompiledRankingExpressionExecutor::execute_batch(std::span<const uint32_t> docids, size_t, std::span<feature_t> numbers)
+{
+    // Calculate each input for all documents before evaluating the expression per document
+    size_t num_docs = docids.size();
+    _batch_params.resize(_params.size() * num_docs);
+    for (size_t i = 0; i < _params.size(); ++i) {
+        inputs().get_numbers(i, docids, std::span<feature_t>(_batch_params.data() + i * num_docs, num_docs));
+    }
+    for (size_t doc = 0; doc < num_docs; ++doc) {
+        for (size_t i = 0; i < _params.size(); ++i) {
+            _params[i] = _batch_params[i * num_docs + doc];
+        }
+        numbers[doc] = _ranking_function(_params.data());
+    }
+}
+
 //-----------------------------------------------------------------------------
 
 namespace {
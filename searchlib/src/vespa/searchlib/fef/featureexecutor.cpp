@@ -20,6 +20,33 @@ FeatureExecutor::isPure()
     return false;
 }
 
+void
+FeatureExecutor::execute_batch(std::span<const uint32_t> docids, size_t output_idx, std::span<feature_t> numbers)
+{
+    for (size_t i = 0; i < docids.size(); ++i) {
+        lazy_execute(docids[i]);
+        numbers[i] = _outputs.get_number(output_idx);
+    }
+}
+
+void
+FeatureExecutor::lazy_execute_batch(std::span<const uint32_t> docids, const NumberOrObject *output, std::span<feature_t> numbers)
+{
+    execute_batch(docids, output - _outputs.get_bound().data(), numbers);
+    _inputs.set_docid(-1);
+}
+
+DirectNumber
+FeatureExecutor::get_direct_number(size_t) const
+{
+    return {};
+}
+
+void
+FeatureExecutor::handle_prepare_batch(std::span<const uint32_t>)
+{
+}
+
 void
 FeatureExecutor::handle_bind_inputs(std::span<const LazyValue>)
 {
@@ -4,12 +4,32 @@
 
 #include "matchdata.h"
 #include "number_or_object.h"
+#include <algorithm>
 #include <span>
 
 namespace search::fef {
 
 class FeatureExecutor;
 
+/**
+ * Direct access to a number value calculated by a FeatureExecutor,
+ * bypassing lazy execution. Executors performing trivial lookups
+ * (like reading a single value attribute) may offer this to let
+ * consuming executors fuse the lookup into their own calculation.
+ **/
+class DirectNumber {
+public:
+    using function_type = feature_t (*)(const void *ctx, uint32_t docid);
+private:
+    function_type _fun;
+    const void   *_ctx;
+public:
+    DirectNumber() noexcept : _fun(nullptr), _ctx(nullptr) {}
+    DirectNumber(function_type fun, const void *ctx) noexcept : _fun(fun), _ctx(ctx) {}
+    bool valid() const noexcept { return (_fun != nullptr); }
+    feature_t get(uint32_t docid) const { return _fun(_ctx, docid); }
+};
+
 /**
  * A LazyValue is a reference to a value that can be calculated by a
  * FeatureExecutor when needed. Actual Values and FeatureExecutors are
@@ -32,6 +52,8 @@ public:
     }
     inline double as_number(uint32_t docid) const;
     inline vespalib::eval::Value::CREF as_object(uint32_t docid) const;
+    inline void as_numbers(std::span<const uint32_t> docids, std::span<feature_t> numbers) const;
+    inline DirectNumber direct_number() const;
 };
 
 /**
@@ -53,6 +75,12 @@ public:
         void bind(std::span<const LazyValue> inputs) { _inputs = inputs; }
         inline feature_t get_number(size_t idx) const;
         inline vespalib::eval::Value::CREF get_object(size_t idx) const;
+        vespalib::eval::Value::CREF get_object(size_t idx, uint32_t docid) const {
+            return _inputs[idx].as_object(docid);
+        }
+        void get_numbers(size_t idx, std::span<const uint32_t> docids, std::span<feature_t> numbers) const {
+            _inputs[idx].as_numbers(docids, numbers);
+        }
         size_t size() const { return _inputs.size(); }
     };
 
@@ -106,6 +134,39 @@ protected:
      **/
     virtual void execute(uint32_t docId) = 0;
 
+    /**
+     * Calculate the number value of an output for a batch of
+     * documents. The default implementation executes the documents
+     * one at a time. Executors overriding this method must not depend
+     * on match data, since batches are only used when no match data
+     * is unpacked for ranking.
+     *
+     * @param docids the local document ids being evaluated, in increasing order
+     * @param output_idx which output to calculate
+     * @param numbers where to store the calculated values
+     **/
+    virtual void execute_batch(std::span<const uint32_t> docids, size_t output_idx, std::span<feature_t> numbers);
+
+    /**
+     * Obtain direct access to the number value of an output. Only
+     * executors whose output depends on nothing but the document id
+     * (no inputs, no match data) may offer this. The default
+     * implementation returns an invalid DirectNumber.
+     *
+     * @param output_idx which output to access
+     **/
+    virtual DirectNumber get_direct_number(size_t output_idx) const;
+
+    /**
+     * Prepare for upcoming execution of the given documents. Used by
+     * executors that benefit from calculating many documents at once.
+     * Like execute_batch, this is only called when no match data is
+     * needed for ranking. The default implementation does nothing.
+     *
+     * @param docids the local document ids to be evaluated, in increasing order
+     **/
+    virtual void handle_prepare_batch(std::span<const uint32_t> docids);
+
 public:
     /**
      * Create a feature executor that has not yet been bound to neither
@@ -126,6 +187,7 @@ public:
     void bind_inputs(std::span<const LazyValue> inputs);
     void bind_outputs(std::span<NumberOrObject> outputs);
     void bind_match_data(const MatchData &md);
+    void prepare_batch(std::span<const uint32_t> docids) { handle_prepare_batch(docids); }
 
     const Inputs &inputs() const { return _inputs; }
     const Outputs &outputs() const { return _outputs; }
@@ -161,6 +223,16 @@ public:
         }
     }
 
+    /**
+     * Calculate the number value of the given output for a batch of
+     * documents. Outputs are not valid for any document afterwards.
+     **/
+    void lazy_execute_batch(std::span<const uint32_t> docids, const NumberOrObject *output, std::span<feature_t> numbers);
+
+    DirectNumber direct_number(const NumberOrObject *output) const {
+        return get_direct_number(output - _outputs.get_bound().data());
+    }
+
     /**
      * Virtual destructor to allow subclassing.
      **/
@@ -181,6 +253,18 @@ vespalib::eval::Value::CREF LazyValue::as_object(uint32_t docid) const {
     return _value->as_object;
 }
 
+void LazyValue::as_numbers(std::span<const uint32_t> docids, std::span<feature_t> numbers) const {
+    if (_executor != nullptr) {
+        _executor->lazy_execute_batch(docids, _value, numbers);
+    } else {
+        std::fill(numbers.begin(), numbers.begin() + docids.size(), _value->as_number);
+    }
+}
+
+DirectNumber LazyValue::direct_number() const {
+    return (_executor != nullptr) ? _executor->direct_number(_value) : DirectNumber();
+}
+
 feature_t FeatureExecutor::Inputs::get_number(size_t idx) const {
     return _inputs[idx].as_number(_docid);
 }
@@ -16,6 +16,12 @@ FeatureOverrider::handle_bind_outputs(std::span<NumberOrObject> outputs)
     _executor.bind_outputs(outputs);
 }
 
+void
+FeatureOverrider::handle_prepare_batch(std::span<const uint32_t> docids)
+{
+    _executor.prepare_batch(docids);
+}
+
 FeatureOverrider::FeatureOverrider(FeatureExecutor &executor, uint32_t outputIdx, feature_t number, Value::UP object)
     : _executor(executor),
       _outputIdx(outputIdx),
@@ -26,6 +26,7 @@ private:
     void handle_bind_match_data(const MatchData &md) override;
     void handle_bind_inputs(std::span<const LazyValue> inputs) override;
     void handle_bind_outputs(std::span<NumberOrObject> outputs) override;
+    void handle_prepare_batch(std::span<const uint32_t> docids) override;
 
 public:
     FeatureOverrider(const FeatureOverrider &) = delete;
@@ -100,6 +100,10 @@ const std::string UseFastForest::NAME("vespa.eval.use_fast_forest");
 const bool UseFastForest::DEFAULT_VALUE(false);
 bool UseFastForest::check(const Properties &props) { return lookupBool(props, NAME, DEFAULT_VALUE); }
 
+const std::string OnnxBatchSize::NAME("vespa.eval.onnx_batch_size");
+const uint32_t OnnxBatchSize::DEFAULT_VALUE(0);
+uint32_t OnnxBatchSize::lookup(const Properties &props) { return lookupUint32(props, NAME, DEFAULT_VALUE); }
+
 } // namespace eval
 
 namespace rank {
@@ -382,6 +386,51 @@ NumSearchPartitions::lookup(const Properties &props, uint32_t defaultValue)
     return lookupUint32(props, NAME, defaultValue);
 }
 
+const std::string ResultCacheMaxBytes::NAME("vespa.matching.result_cache.max_bytes");
+const uint32_t ResultCacheMaxBytes::DEFAULT_VALUE(0);
+
+uint32_t
+ResultCacheMaxBytes::lookup(const Properties &props)
+{
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
+const std::string ProfileSampleInterval::NAME("vespa.matching.profile.sample_interval");
+const uint32_t ProfileSampleInterval::DEFAULT_VALUE(0);
+
+uint32_t
+ProfileSampleInterval::lookup(const Properties &props)
+{
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
+const std::string ProfileSampleDepth::NAME("vespa.matching.profile.sample_depth");
+const uint32_t ProfileSampleDepth::DEFAULT_VALUE(64);
+
+uint32_t
+ProfileSampleDepth::lookup(const Properties &props)
+{
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
+const std::string GlobalFilterCacheMaxBytes::NAME("vespa.matching.global_filter.cache_max_bytes");
+const uint32_t GlobalFilterCacheMaxBytes::DEFAULT_VALUE(0);
+
+uint32_t
+GlobalFilterCacheMaxBytes::lookup(const Properties &props)
+{
+    return lookupUint32(props, NAME, DEFAULT_VALUE);
+}
+
+const std::string GlobalFilterCacheMaxAge::NAME("vespa.matching.global_filter.cache_max_age");
+const double GlobalFilterCacheMaxAge::DEFAULT_VALUE(1.0);
+
+double
+GlobalFilterCacheMaxAge::lookup(const Properties &props)
+{
+    return lookupDouble(props, NAME, DEFAULT_VALUE);
+}
+
 const std::string MinHitsPerThread::NAME("vespa.matching.minhitsperthread");
 const uint32_t MinHitsPerThread::DEFAULT_VALUE(0);
 
@@ -37,6 +37,13 @@ struct UseFastForest {
     static bool check(const Properties &props);
 };
 
+// evaluate onnx models for this many documents at a time when possible (0 or 1 disables). affects rank
+struct OnnxBatchSize {
+    static const std::string NAME;
+    static const uint32_t DEFAULT_VALUE;
+    static uint32_t lookup(const Properties &props);
+};
+
 } // namespace eval
 
 namespace rank {
@@ -288,6 +295,62 @@ namespace matching {
         static uint32_t lookup(const Properties &props, uint32_t defaultValue);
     };
 
+    /**
+     * Property for the maximum number of bytes used to cache search
+     * replies on the content node. Repeated identical queries against
+     * unchanged data are answered from the cache. The default value
+     * is 0 (no caching).
+     **/
+    struct ResultCacheMaxBytes {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
+    /**
+     * Property for profiling one in every N queries using this rank
+     * profile. The profiles are merged per rank profile and exposed
+     * as folded stacks through the state explorer. The default value
+     * is 0 (no sampling).
+     **/
+    struct ProfileSampleInterval {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
+    /**
+     * Property for the maximum depth of the call tree profiled for
+     * sampled queries.
+     **/
+    struct ProfileSampleDepth {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
+    /**
+     * Property for the maximum number of bytes used to cache global
+     * filters on the content node, letting queries with the same
+     * query tree against unchanged data share the same global
+     * filter. The default value is 0 (no caching).
+     **/
+    struct GlobalFilterCacheMaxBytes {
+        static const std::string NAME;
+        static const uint32_t DEFAULT_VALUE;
+        static uint32_t lookup(const Properties &props);
+    };
+
+    /**
+     * Property for the maximum age (in seconds) of a cached global
+     * filter before it is calculated again.
+     **/
+    struct GlobalFilterCacheMaxAge {
+        static const std::string NAME;
+        static const double DEFAULT_VALUE;
+        static double lookup(const Properties &props);
+    };
+
     /**
      * Property to control fallback to not building a global filter
      * for a query with a blueprint that wants a global filter. If the
@@ -123,6 +123,11 @@ struct ProfiledExecutor : FeatureExecutor {
     bool isPure() override {
         return executor.isPure();
     }
+    void handle_prepare_batch(std::span<const uint32_t> docids) override {
+        profiler.start(self);
+        executor.prepare_batch(docids);
+        profiler.complete();
+    }
     void execute(uint32_t docId) override {
         profiler.start(self);
         executor.lazy_execute(docId);
@@ -222,6 +227,7 @@ RankProgram::RankProgram(BlueprintResolver::SP resolver)
       _hot_stash(32_Ki),
       _cold_stash(),
       _executors(),
+      _batch_executors(),
       _unboxed_seeds(),
       _is_const()
 {
@@ -279,6 +285,8 @@ RankProgram::setup(const MatchData &md,
         _executors.push_back(executor);
         if (is_const) {
             run_const(executor);
+        } else {
+            _batch_executors.push_back(executor);
         }
     }
     for (const auto &seed_entry: _resolver->getSeedMap()) {
@@ -306,6 +314,14 @@ RankProgram::setup(const MatchData &md,
     }
 }
 
+void
+RankProgram::prepare_batch(std::span<const uint32_t> docids)
+{
+    for (FeatureExecutor *executor: _batch_executors) {
+        executor->prepare_batch(docids);
+    }
+}
+
 FeatureResolver
 RankProgram::get_seeds(bool unbox_seeds) const
 {
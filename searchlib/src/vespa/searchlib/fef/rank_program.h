@@ -38,6 +38,7 @@ private:
     vespalib::Stash                  _hot_stash;
     vespalib::Stash                  _cold_stash;
     std::vector<FeatureExecutor *>   _executors;
+    std::vector<FeatureExecutor *>   _batch_executors; // non-const executors, see prepare_batch
     MappedValues                     _unboxed_seeds;
     ValueSet                         _is_const;
 
@@ -73,6 +74,16 @@ public:
                const Properties &featureOverrides = Properties(),
                vespalib::ExecutionProfiler *profiler = nullptr);
 
+    /**
+     * Let all non-const feature executors prepare for calculating
+     * features for the given documents. Const features are already
+     * calculated by setup. Must only be used when the features do not
+     * depend on match data.
+     *
+     * @param docids the local document ids to be evaluated, in increasing order
+     **/
+    void prepare_batch(std::span<const uint32_t> docids);
+
     /**
      * Obtain the names and storage locations of all seed features for
      * this rank program. Programs for ranking phases will only have a
@@ -29,26 +29,33 @@ DocumentInverter::DocumentInverter(DocumentInverterContext& context)
 {
     auto& schema = context.get_schema();
     auto& field_indexes = context.get_field_indexes();
-    for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
+    auto make_inverter = [&schema, &field_indexes](uint32_t fieldId) {
         auto &remover(field_indexes.get_remover(fieldId));
         auto &inserter(field_indexes.get_inserter(fieldId));
         auto &calculator(field_indexes.get_calculator(fieldId));
-        _inverters.push_back(std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator));
-    }
+        return std::make_unique<FieldInverter>(schema, fieldId, remover, inserter, calculator);
+    };
     auto& schema_index_fields = context.get_schema_index_fields();
-    for (auto &urlField : schema_index_fields._uriFields) {
-        Schema::CollectionType collectionType =
-            schema.getIndexField(urlField._all).getCollectionType();
-        _urlInverters.push_back(std::make_unique<UrlFieldInverter>
-                                (collectionType,
-                                 _inverters[urlField._all].get(),
-                                 _inverters[urlField._scheme].get(),
-                                 _inverters[urlField._host].get(),
-                                 _inverters[urlField._port].get(),
-                                 _inverters[urlField._path].get(),
-                                 _inverters[urlField._query].get(),
-                                 _inverters[urlField._fragment].get(),
-                                 _inverters[urlField._hostname].get()));
+    for (uint32_t shard = 0; shard < context.get_invert_shards(); ++shard) {
+        auto& inverters = _inverters.emplace_back();
+        for (uint32_t fieldId = 0; fieldId < schema.getNumIndexFields(); ++fieldId) {
+            inverters.push_back(make_inverter(fieldId));
+        }
+        auto& url_inverters = _urlInverters.emplace_back();
+        for (auto &urlField : schema_index_fields._uriFields) {
+            Schema::CollectionType collectionType =
+                schema.getIndexField(urlField._all).getCollectionType();
+            url_inverters.push_back(std::make_unique<UrlFieldInverter>
+                                    (collectionType,
+                                     inverters[urlField._all].get(),
+                                     inverters[urlField._scheme].get(),
+                                     inverters[urlField._host].get(),
+                                     inverters[urlField._port].get(),
+                                     inverters[urlField._path].get(),
+                                     inverters[urlField._query].get(),
+                                     inverters[urlField._fragment].get(),
+                                     inverters[urlField._hostname].get()));
+        }
     }
 }
 
@@ -62,9 +69,13 @@ DocumentInverter::invertDocument(uint32_t docId, const Document &doc, const OnWr
 {
     auto& invert_threads = _context.get_invert_threads();
     auto& invert_contexts = _context.get_invert_contexts();
+    uint32_t shard = docId % _inverters.size();
     for (auto& invert_context : invert_contexts) {
+        if (invert_context.get_shard() != shard) {
+            continue;
+        }
         auto id = invert_context.get_id();
-        auto task = std::make_unique<InvertTask>(_context, invert_context, _inverters, _urlInverters, docId, doc, on_write_done);
+        auto task = std::make_unique<InvertTask>(_context, invert_context, _inverters[shard], _urlInverters[shard], docId, doc, on_write_done);
         invert_threads.executeTask(id, std::move(task));
     }
 }
@@ -80,9 +91,21 @@ DocumentInverter::removeDocuments(LidVector lids)
 {
     auto& invert_threads = _context.get_invert_threads();
     auto& invert_contexts = _context.get_invert_contexts();
+    std::vector<LidVector> shard_lids;
+    if (_inverters.size() > 1) {
+        shard_lids.resize(_inverters.size());
+        for (auto lid : lids) {
+            shard_lids[lid % _inverters.size()].push_back(lid);
+        }
+    }
     for (auto& invert_context : invert_contexts) {
+        auto shard = invert_context.get_shard();
+        const auto& context_lids = shard_lids.empty() ? lids : shard_lids[shard];
+        if (context_lids.empty()) {
+            continue;
+        }
         auto id = invert_context.get_id();
-        auto task = std::make_unique<RemoveTask>(invert_context, _inverters, _urlInverters, lids);
+        auto task = std::make_unique<RemoveTask>(invert_context, _inverters[shard], _urlInverters[shard], context_lids);
         invert_threads.executeTask(id, std::move(task));
     }
 }
@@ -39,10 +39,13 @@ private:
 
     using LidVector = std::vector<uint32_t>;
     using OnWriteDoneType = std::shared_ptr<vespalib::IDestructorCallback>;
+    using FieldInverters = std::vector<std::unique_ptr<FieldInverter>>;
+    using UrlFieldInverters = std::vector<std::unique_ptr<UrlFieldInverter>>;
 
-    std::vector<std::unique_ptr<FieldInverter>> _inverters;
-    std::vector<std::unique_ptr<UrlFieldInverter>> _urlInverters;
-    vespalib::MonitoredRefCount                    _ref_count;
+    // Field inverters per invert shard
+    std::vector<FieldInverters>    _inverters;
+    std::vector<UrlFieldInverters> _urlInverters;
+    vespalib::MonitoredRefCount    _ref_count;
 
 public:
     /**
@@ -88,10 +91,10 @@ public:
     void removeDocuments(LidVector lids);
 
     FieldInverter *getInverter(uint32_t fieldId) const {
-        return _inverters[fieldId].get();
+        return _inverters[0][fieldId].get();
     }
 
-    uint32_t getNumFields() const { return _inverters.size(); }
+    uint32_t getNumFields() const { return _inverters[0].size(); }
     void wait_for_zero_ref_count() { _ref_count.waitForZeroRefCount(); }
     bool has_zero_ref_count() { return _ref_count.has_zero_ref_count(); }
     vespalib::MonitoredRefCount& get_ref_count() noexcept { return _ref_count; }
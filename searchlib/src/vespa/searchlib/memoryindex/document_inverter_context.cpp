@@ -1,8 +1,10 @@
 // Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
 
 #include "document_inverter_context.h"
+#include <algorithm>
 #include <cassert>
 #include <optional>
+#include <type_traits>
 
 namespace search::memoryindex {
 
@@ -12,36 +14,47 @@ using index::SchemaIndexFields;
 namespace {
 
 template <typename Context>
-void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, std::vector<Context>& contexts)
+void make_contexts(const index::Schema& schema, const SchemaIndexFields& schema_index_fields, ISequencedTaskExecutor& executor, uint32_t shards, std::vector<Context>& contexts)
 {
     using ExecutorId = ISequencedTaskExecutor::ExecutorId;
-    using IdMapping = std::vector<std::tuple<ExecutorId, bool, uint32_t, uint32_t>>;
+    using IdMapping = std::vector<std::tuple<uint32_t, ExecutorId, bool, uint32_t, uint32_t>>;
     IdMapping map;
     for (uint32_t field_id : schema_index_fields._textFields) {
         // TODO: Add bias when sharing sequenced task executor between document types
         auto& name = schema.getIndexField(field_id).getName();
         auto id = executor.getExecutorIdFromName(name);
-        map.emplace_back(id, false, field_id, 0);
+        map.emplace_back(0, id, false, field_id, 0);
+        for (uint32_t shard = 1; shard < shards; ++shard) {
+            map.emplace_back(shard, executor.get_alternate_executor_id(id, shard), false, field_id, 0);
+        }
     }
     uint32_t uri_field_id = 0;
     for (auto& uri_field : schema_index_fields._uriFields) {
         // TODO: Add bias when sharing sequenced task executor between document types
         auto& name = schema.getIndexField(uri_field._all).getName();
         auto id = executor.getExecutorIdFromName(name);
-        map.emplace_back(id, true, uri_field_id, uri_field._all);
+        map.emplace_back(0, id, true, uri_field_id, uri_field._all);
+        for (uint32_t shard = 1; shard < shards; ++shard) {
+            map.emplace_back(shard, executor.get_alternate_executor_id(id, shard), true, uri_field_id, uri_field._all);
+        }
         ++uri_field_id;
     }
     std::sort(map.begin(), map.end());
-    std::optional<ExecutorId> prev_id;
+    std::optional<std::pair<uint32_t, ExecutorId>> prev_id;
     for (auto& entry : map) {
-        if (!prev_id.has_value() || prev_id.value() != std::get<0>(entry)) {
-            contexts.emplace_back(std::get<0>(entry));
-            prev_id = std::get<0>(entry);
+        std::pair<uint32_t, ExecutorId> id(std::get<0>(entry), std::get<1>(entry));
+        if (!prev_id.has_value() || prev_id.value() != id) {
+            if constexpr (std::is_same_v<Context, InvertContext>) {
+                contexts.emplace_back(id.second, id.first);
+            } else {
+                contexts.emplace_back(id.second);
+            }
+            prev_id = id;
         }
-        if (std::get<1>(entry)) {
-            contexts.back().add_uri_field(std::get<2>(entry), std::get<3>(entry));
+        if (std::get<2>(entry)) {
+            contexts.back().add_uri_field(std::get<3>(entry), std::get<4>(entry));
         } else {
-            contexts.back().add_field(std::get<2>(entry));
+            contexts.back().add_field(std::get<3>(entry));
         }
     }
 }
@@ -127,11 +140,21 @@ DocumentInverterContext::DocumentInverterContext(const index::Schema& schema,
                                                  ISequencedTaskExecutor &invert_threads,
                                                  ISequencedTaskExecutor &push_threads,
                                                  IFieldIndexCollection& field_indexes)
+    : DocumentInverterContext(schema, invert_threads, push_threads, field_indexes, 1)
+{
+}
+
+DocumentInverterContext::DocumentInverterContext(const index::Schema& schema,
+                                                 ISequencedTaskExecutor &invert_threads,
+                                                 ISequencedTaskExecutor &push_threads,
+                                                 IFieldIndexCollection& field_indexes,
+                                                 uint32_t invert_shards)
     : _schema(schema),
       _schema_index_fields(),
       _invert_threads(invert_threads),
       _push_threads(push_threads),
       _field_indexes(field_indexes),
+      _invert_shards(std::clamp(invert_shards, 1u, invert_threads.getNumExecutors())),
       _invert_contexts(),
       _push_contexts()
 {
@@ -144,8 +167,8 @@ DocumentInverterContext::~DocumentInverterContext() = default;
 void
 DocumentInverterContext::setup_contexts()
 {
-    make_contexts(_schema, _schema_index_fields, _invert_threads, _invert_contexts);
-    make_contexts(_schema, _schema_index_fields, _push_threads, _push_contexts);
+    make_contexts(_schema, _schema_index_fields, _invert_threads, _invert_shards, _invert_contexts);
+    make_contexts(_schema, _schema_index_fields, _push_threads, 1, _push_contexts);
     if (&_invert_threads == &_push_threads) {
         uint32_t bias = _schema_index_fields._textFields.size() + _schema_index_fields._uriFields.size();
         switch_to_alternate_ids(_push_threads, _push_contexts, bias);
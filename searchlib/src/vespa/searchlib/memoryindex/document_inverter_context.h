@@ -22,6 +22,7 @@ class DocumentInverterContext {
     vespalib::ISequencedTaskExecutor& _invert_threads;
     vespalib::ISequencedTaskExecutor& _push_threads;
     IFieldIndexCollection&            _field_indexes;
+    uint32_t                          _invert_shards;
     std::vector<InvertContext>        _invert_contexts;
     std::vector<PushContext>          _push_contexts;
     void setup_contexts();
@@ -30,12 +31,25 @@ public:
                             vespalib::ISequencedTaskExecutor &invert_threads,
                             vespalib::ISequencedTaskExecutor &push_threads,
                             IFieldIndexCollection& field_indexes);
+    /*
+     * Each text and uri field is inverted by invert_shards field inverters
+     * using different invert threads, each handling the documents
+     * where lid modulo invert_shards matches its shard. The shards are
+     * pushed to the field index one after another by the push thread
+     * for the field.
+     */
+    DocumentInverterContext(const index::Schema &schema,
+                            vespalib::ISequencedTaskExecutor &invert_threads,
+                            vespalib::ISequencedTaskExecutor &push_threads,
+                            IFieldIndexCollection& field_indexes,
+                            uint32_t invert_shards);
     ~DocumentInverterContext();
     const index::Schema& get_schema() const noexcept { return _schema; }
     const index::SchemaIndexFields& get_schema_index_fields() const noexcept { return _schema_index_fields; }
     vespalib::ISequencedTaskExecutor& get_invert_threads() noexcept { return _invert_threads; }
     vespalib::ISequencedTaskExecutor& get_push_threads() noexcept { return _push_threads; }
     IFieldIndexCollection& get_field_indexes() noexcept { return _field_indexes; }
+    uint32_t get_invert_shards() const noexcept { return _invert_shards; }
     const std::vector<InvertContext>& get_invert_contexts() const noexcept { return _invert_contexts; }
     const std::vector<PushContext>& get_push_contexts() const noexcept { return _push_contexts; }
 };
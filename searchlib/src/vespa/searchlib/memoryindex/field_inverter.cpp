@@ -182,7 +182,7 @@ FieldInverter::endDoc()
             ++itr;
         }
     }
-    _calculator.add_field_length(field_length, _elem);
+    _fieldLengths.emplace_back(field_length, _elem);
     uint32_t newPosSize = static_cast<uint32_t>(_positions.size());
     _pendingDocs.insert({ _docId, { _oldPosSize, newPosSize - _oldPosSize } });
     _docId = 0;
@@ -259,6 +259,7 @@ FieldInverter::FieldInverter(const Schema &schema, uint32_t fieldId,
       _abortedDocs(),
       _pendingDocs(),
       _removeDocs(),
+      _fieldLengths(),
       _remover(remover),
       _inserter(inserter),
       _calculator(calculator)
@@ -403,6 +404,10 @@ FieldInverter::applyRemoves()
 void
 FieldInverter::push_documents_internal()
 {
+    for (const auto& field_length : _fieldLengths) {
+        _calculator.add_field_length(field_length.first, field_length.second);
+    }
+    _fieldLengths.clear();
     trimAbortedDocs();
 
     if (_positions.empty()) {
@@ -189,6 +189,10 @@ private:
     vespalib::hash_map<uint32_t, PositionRange> _pendingDocs;
     UInt32Vector                                _removeDocs;
 
+    // {field length, elements} for inverted documents, added to the calculator when pushing.
+    // This keeps the calculator single threaded when a field is inverted by several shards.
+    std::vector<std::pair<uint32_t, uint32_t>>  _fieldLengths;
+
     FieldIndexRemover                &_remover;
     IOrderedFieldIndexInserter       &_inserter;
     index::FieldLengthCalculator     &_calculator;
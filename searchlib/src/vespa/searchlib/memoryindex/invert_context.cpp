@@ -37,7 +37,13 @@ get_field(const DocumentType& doc_type, const std::string& name)
 
 
 InvertContext::InvertContext(vespalib::ISequencedTaskExecutor::ExecutorId id)
+    : InvertContext(id, 0)
+{
+}
+
+InvertContext::InvertContext(vespalib::ISequencedTaskExecutor::ExecutorId id, uint32_t shard)
     : BundledFieldsContext(id),
+      _shard(shard),
       _pushers(),
       _document_fields(),
       _document_uri_fields(),
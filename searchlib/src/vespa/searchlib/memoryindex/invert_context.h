@@ -27,10 +27,14 @@ class DocumentInverterContext;
  * It is also used by DocumentInverter::pushDocuments() to execute
  * PushTask at the proper time (i.e. when all related InvertTask /
  * RemoveTask operations have completed).
+ *
+ * When fields are inverted by multiple shards, the context only
+ * handles documents where lid modulo number of shards matches its shard.
  */
 class InvertContext : public BundledFieldsContext
 {
     using IndexedFields = std::vector<std::unique_ptr<const document::Field>>;
+    uint32_t              _shard;
     std::vector<uint32_t> _pushers;
     std::string      _document_field_names;
     mutable IndexedFields _document_fields;
@@ -39,8 +43,10 @@ class InvertContext : public BundledFieldsContext
 public:
     void add_pusher(uint32_t pusher_id);
     InvertContext(vespalib::ISequencedTaskExecutor::ExecutorId id);
+    InvertContext(vespalib::ISequencedTaskExecutor::ExecutorId id, uint32_t shard);
     ~InvertContext();
     InvertContext(InvertContext&&);
+    uint32_t get_shard() const noexcept { return _shard; }
     const std::vector<uint32_t>& get_pushers() const noexcept { return _pushers; }
     void set_data_type(const DocumentInverterContext& doc_inv_context, const document::Document& doc) const;
     const IndexedFields& get_document_fields() const noexcept { return _document_fields; }
@@ -96,6 +96,17 @@ public:
                 ISequencedTaskExecutor& invertThreads,
                 ISequencedTaskExecutor& pushThreads);
 
+    /**
+     * Create a new memory index where each text and uri field is inverted by
+     * invertShards invert threads, each handling a disjoint set of documents.
+     * This lets a schema with a few large text fields use more invert threads.
+     */
+    MemoryIndex(const index::Schema& schema,
+                const index::IFieldLengthInspector& inspector,
+                ISequencedTaskExecutor& invertThreads,
+                ISequencedTaskExecutor& pushThreads,
+                uint32_t invertShards);
+
     MemoryIndex(const MemoryIndex &) = delete;
     MemoryIndex(MemoryIndex &&) = delete;
     MemoryIndex &operator=(const MemoryIndex &) = delete;
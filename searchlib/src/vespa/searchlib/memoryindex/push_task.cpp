@@ -19,7 +19,7 @@ void push_inverter(Inverter& inverter)
 }
 
 
-PushTask::PushTask(const PushContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters, const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const OnWriteDoneType& on_write_done, std::shared_ptr<vespalib::RetainGuard> retain)
+PushTask::PushTask(const PushContext& context, const std::vector<FieldInverters>& inverters, const std::vector<UrlFieldInverters>& uri_inverters, const OnWriteDoneType& on_write_done, std::shared_ptr<vespalib::RetainGuard> retain)
     : _context(context),
       _inverters(inverters),
       _uri_inverters(uri_inverters),
@@ -34,10 +34,14 @@ void
 PushTask::run()
 {
     for (auto field_id : _context.get_fields()) {
-        push_inverter(*_inverters[field_id]);
+        for (auto& shard_inverters : _inverters) {
+            push_inverter(*shard_inverters[field_id]);
+        }
     }
     for (auto uri_field_id : _context.get_uri_fields()) {
-        push_inverter(*_uri_inverters[uri_field_id]);
+        for (auto& shard_uri_inverters : _uri_inverters) {
+            push_inverter(*shard_uri_inverters[uri_field_id]);
+        }
     }
 }
 
@@ -18,18 +18,21 @@ class UrlFieldInverter;
 
 /*
  * Task to push inverted data from a set of field inverters and uri
- * field inverters to to memory index structure.
+ * field inverters to to memory index structure. Field inverters for
+ * all shards of a field are pushed one after another.
  */
 class PushTask : public vespalib::Executor::Task
 {
     using OnWriteDoneType = std::shared_ptr<vespalib::IDestructorCallback>;
-    const PushContext&                                    _context;
-    const std::vector<std::unique_ptr<FieldInverter>>&    _inverters;
-    const std::vector<std::unique_ptr<UrlFieldInverter>>& _uri_inverters;
+    using FieldInverters = std::vector<std::unique_ptr<FieldInverter>>;
+    using UrlFieldInverters = std::vector<std::unique_ptr<UrlFieldInverter>>;
+    const PushContext&                    _context;
+    const std::vector<FieldInverters>&    _inverters;
+    const std::vector<UrlFieldInverters>& _uri_inverters;
     const OnWriteDoneType                                 _on_write_done;
     std::shared_ptr<vespalib::RetainGuard>                _retain;
 public:
-    PushTask(const PushContext& context, const std::vector<std::unique_ptr<FieldInverter>>& inverters, const std::vector<std::unique_ptr<UrlFieldInverter>>& uri_inverters, const OnWriteDoneType& on_write_done, std::shared_ptr<vespalib::RetainGuard> retain);
+    PushTask(const PushContext& context, const std::vector<FieldInverters>& inverters, const std::vector<UrlFieldInverters>& uri_inverters, const OnWriteDoneType& on_write_done, std::shared_ptr<vespalib::RetainGuard> retain);
     ~PushTask() override;
     void run() override;
 };
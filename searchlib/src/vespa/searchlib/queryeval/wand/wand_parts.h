@@ -58,6 +58,8 @@ public:
     }
     [[nodiscard]] bool keep_all() const noexcept { return _drop_limit == uint32_t(-1); }
     [[nodiscard]] bool allow_drop_all() const noexcept { return _allow_drop_all; }
+    [[nodiscard]] uint32_t adjust_limit() const noexcept { return _adjust_limit; }
+    [[nodiscard]] uint32_t drop_limit() const noexcept { return _drop_limit; }
     [[nodiscard]] bool should_drop(uint32_t hits) const noexcept { return hits > _drop_limit; }
     [[nodiscard]] static StopWordStrategy none() noexcept { return {1.0, 1.0, 0, false}; }
 };
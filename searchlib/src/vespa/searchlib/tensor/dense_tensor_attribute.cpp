@@ -2,6 +2,7 @@
 
 #include "dense_tensor_attribute.h"
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/datastore/i_compaction_context.h>
 
 namespace search::tensor {
 
@@ -15,6 +16,7 @@ DenseTensorAttribute::DenseTensorAttribute(std::string_view baseFileName, const
 
 DenseTensorAttribute::~DenseTensorAttribute()
 {
+    _compaction_context.reset();
     getGenerationHolder().reclaim_all();
     _tensorStore.reclaim_all_memory();
 }
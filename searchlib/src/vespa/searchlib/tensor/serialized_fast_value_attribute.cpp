@@ -4,6 +4,7 @@
 #include "serialized_tensor_ref.h"
 #include <vespa/eval/eval/value.h>
 #include <vespa/searchcommon/attribute/config.h>
+#include <vespa/vespalib/datastore/i_compaction_context.h>
 
 #include <vespa/log/log.h>
 
@@ -24,6 +25,7 @@ SerializedFastValueAttribute::SerializedFastValueAttribute(string_view name, con
 
 SerializedFastValueAttribute::~SerializedFastValueAttribute()
 {
+    _compaction_context.reset();
     getGenerationHolder().reclaim_all();
     _tensorStore.reclaim_all_memory();
 }
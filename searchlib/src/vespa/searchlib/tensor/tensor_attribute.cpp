@@ -19,6 +19,7 @@
 #include <vespa/eval/eval/value_codec.h>
 #include <vespa/eval/eval/tensor_spec.h>
 #include <vespa/eval/eval/value.h>
+#include <limits>
 
 using document::TensorDataType;
 using document::TensorUpdate;
@@ -59,6 +60,7 @@ TensorAttribute::TensorAttribute(std::string_view name, const Config &cfg, Tenso
       _is_dense(cfg.tensorType().is_dense()),
       _emptyTensor(createEmptyTensor(cfg.tensorType())),
       _compactGeneration(0),
+      _compaction_context(),
       _subspace_type(cfg.tensorType()),
       _comp(cfg.tensorType())
 {
@@ -96,10 +98,19 @@ void
 TensorAttribute::onCommit()
 {
     incGeneration();
-    if (_tensorStore.consider_compact()) {
+    if (_compaction_context) {
+        compact_step();
+        incGeneration();
+        updateStat(true);
+    } else if (_tensorStore.consider_compact()) {
         auto context = _tensorStore.start_compact(getConfig().getCompactionStrategy());
         if (context) {
-            context->compact(std::span<AtomicEntryRef>(&_refVector[0], _refVector.size()));
+            if (getConfig().getCompactionStrategy().get_max_compact_step_entries() == 0) {
+                context->compact(std::span<AtomicEntryRef>(&_refVector[0], _refVector.size()));
+            } else {
+                _compaction_context = std::move(context);
+                compact_step();
+            }
         }
         _compactGeneration = getCurrentGeneration();
         incGeneration();
@@ -113,6 +124,19 @@ TensorAttribute::onCommit()
     }
 }
 
+void
+TensorAttribute::compact_step()
+{
+    size_t max_entries = getConfig().getCompactionStrategy().get_max_compact_step_entries();
+    if (max_entries == 0) {
+        max_entries = std::numeric_limits<size_t>::max();
+    }
+    if (_compaction_context->compact_step(std::span<AtomicEntryRef>(&_refVector[0], _refVector.size()), max_entries)) {
+        _compaction_context.reset();
+        _compactGeneration = getCurrentGeneration();
+    }
+}
+
 void
 TensorAttribute::onUpdateStat()
 {
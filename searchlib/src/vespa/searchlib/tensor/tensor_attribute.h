@@ -33,6 +33,7 @@ protected:
     bool _is_dense;
     std::unique_ptr<vespalib::eval::Value> _emptyTensor;
     uint64_t    _compactGeneration; // Generation when last compact occurred
+    std::unique_ptr<vespalib::datastore::ICompactionContext> _compaction_context; // Ongoing incremental compaction
     SubspaceType         _subspace_type;
     TypedCellsComparator _comp;
 
@@ -46,6 +47,7 @@ protected:
     bool onLoad(vespalib::Executor *executor) override;
     std::unique_ptr<AttributeSaver> onInitSave(std::string_view fileName) override;
     bool tensor_cells_are_unchanged(DocId docid, VectorBundle vectors) const;
+    void compact_step();
 
 public:
     TensorAttribute(std::string_view name, const Config &cfg, TensorStore &tensorStore, const NearestNeighborIndexFactory& index_factory);
@@ -3,6 +3,7 @@
 #include "chunks.h"
 #include <vespa/vespalib/util/stringfmt.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <vespa/vespalib/data/databuffer.h>
 #include <stdexcept>
 
@@ -133,4 +134,52 @@ XXH64CompressedChunk::onDecode(IChunk::nbostream &is) {
     decompress(is, uncompressedLen);
 }
 
+XXH64ZStdDictionaryChunk::XXH64ZStdDictionaryChunk(DictionarySP dictionary)
+    : _dictionary(std::move(dictionary)),
+      _backing()
+{ }
+
+XXH64ZStdDictionaryChunk::~XXH64ZStdDictionaryChunk() = default;
+
+Encoding
+XXH64ZStdDictionaryChunk::onEncode(nbostream &os) const {
+    nbostream org;
+    serializeEntries(org);
+    std::vector<char> compressed(vespalib::compression::ZStdDictionary::compressBound(org.size()));
+    size_t compressedLen = _dictionary->compress(org.data(), org.size(), compressed.data(), compressed.size());
+    os << uint32_t(org.size());
+    size_t start = os.wp();
+    Encoding::Compression actual = Encoding::Compression::zstd_dict;
+    if ((compressedLen > 0) && (compressedLen + sizeof(uint32_t) < org.size())) {
+        os << _dictionary->id();
+        os.write(compressed.data(), compressedLen);
+    } else {
+        os.write(org.data(), org.size());
+        actual = Encoding::Compression::none_multi;
+    }
+    os << int32_t(Encoding::calcCrc(Encoding::Crc::xxh64, os.data()+start, os.size() - start));
+    return Encoding(Encoding::Crc::xxh64, actual);
+}
+
+void
+XXH64ZStdDictionaryChunk::onDecode(nbostream &is) {
+    uint32_t uncompressedLen;
+    is >> uncompressedLen;
+    verifyCrc(is, Encoding::Crc::xxh64);
+    uint32_t dictionaryId;
+    is >> dictionaryId;
+    if (dictionaryId != _dictionary->id()) {
+        throw runtime_error(fmt("Chunk is compressed with dictionary %u, but dictionary %u is given",
+                                dictionaryId, _dictionary->id()));
+    }
+    auto uncompressed = vespalib::alloc::Alloc::alloc(uncompressedLen);
+    if ( ! _dictionary->decompress(is.peek(), is.size() - sizeof(int32_t), uncompressed.get(), uncompressedLen)) {
+        throw runtime_error(fmt("Failed decompressing chunk of %u bytes with dictionary %u", uncompressedLen, dictionaryId));
+    }
+    nbostream data(uncompressed.get(), uncompressedLen);
+    deserializeEntries(data);
+    _backing = std::move(uncompressed);
+    is.adjustReadPos(is.size());
+}
+
 }
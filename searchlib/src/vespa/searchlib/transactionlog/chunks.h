@@ -40,4 +40,21 @@ private:
     vespalib::alloc::Alloc  _backing;
 };
 
+/**
+ * Chunk compressed with a zstd dictionary trained on earlier operations in the domain.
+ * The dictionary is stored in the header of the domain part file.
+ * Falls back to writing an uncompressed none_multi chunk when compression does not help.
+ */
+class XXH64ZStdDictionaryChunk : public IChunk {
+public:
+    explicit XXH64ZStdDictionaryChunk(DictionarySP dictionary);
+    ~XXH64ZStdDictionaryChunk() override;
+protected:
+    Encoding onEncode(nbostream &os) const override;
+    void onDecode(nbostream &is) override;
+private:
+    DictionarySP            _dictionary;
+    vespalib::alloc::Alloc  _backing;
+};
+
 }
@@ -10,6 +10,7 @@
 #include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/retain_guard.h>
 #include <vespa/vespalib/util/cpu_usage.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <vespa/fastos/file.h>
 #include <algorithm>
 #include <thread>
@@ -26,6 +27,7 @@ using std::string;
 using vespalib::make_string_short::fmt;
 using vespalib::makeLambdaTask;
 using vespalib::CpuUsage;
+using vespalib::compression::ZStdDictionary;
 using std::runtime_error;
 using std::make_shared;
 
@@ -40,6 +42,12 @@ createCommitChunk(const DomainConfig &cfg) {
 }
 
 VESPA_THREAD_STACK_TAG(tls_domain_commit);
+
+// A dictionary is trained from samples of this many times its size
+constexpr size_t DICTIONARY_SAMPLE_FACTOR = 100;
+// A new dictionary is trained after this many part size limits of feed
+constexpr size_t DICTIONARY_RETRAIN_PARTS = 4;
+
 }
 
 Domain::Domain(const string &domainName, const string & baseDir, vespalib::Executor & executor,
@@ -47,6 +55,17 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
     : _config(cfg),
       _currentChunk(createCommitChunk(cfg)),
       _lastSerial(0),
+      _pendingCommits(0),
+      _unsyncedCommits(),
+      _unsyncedBytes(0),
+      _firstUnsyncedTime(),
+      _numSyncs(0),
+      _dictionary(),
+      _dictionarySamples(),
+      _dictionarySampleSizes(),
+      _bytesSinceDictionaryTraining(std::numeric_limits<size_t>::max()),
+      _dictionaryTrainingPending(false),
+      _pendingDictionaryTraining(),
       _singleCommitter(std::make_unique<vespalib::ThreadStackExecutor>(1, CpuUsage::wrap(tls_domain_commit, CpuCategory::WRITE))),
       _executor(executor),
       _sessionId(1),
@@ -87,15 +106,34 @@ Domain::Domain(const string &domainName, const string & baseDir, vespalib::Execu
         vespalib::File::sync(dir());
     }
     _lastSerial = end();
+    if (useDictionary()) {
+        // The active part may be a new empty one, continue with the dictionary of the last part written to.
+        // The empty part is replaced by one carrying the dictionary when the first chunk is committed.
+        for (auto it = _parts.rbegin(); it != _parts.rend(); ++it) {
+            if (it->second->size() > 0) {
+                _dictionary = it->second->dictionary();
+                break;
+            }
+        }
+    }
 }
 
 Domain &
 Domain::setConfig(const DomainConfig & cfg) {
+    std::lock_guard guard(_currentChunkMutex);
     _config = cfg;
     assert(_config.getEncoding().getCompression() != Encoding::Compression::none);
+    if ( ! useDictionary()) {
+        _dictionary.reset();
+    }
     return *this;
 }
 
+bool
+Domain::useDictionary() const {
+    return (_config.getDictionarySize() > 0) && (_config.getEncoding().getCompression() == Encoding::Compression::zstd);
+}
+
 void
 Domain::addPart(SerialNum partId, bool isLastPart) {
     auto dp = std::make_shared<DomainPart>(_name, dir(), partId, _fileHeaderContext, isLastPart);
@@ -116,6 +154,7 @@ Domain::addPart(SerialNum partId, bool isLastPart) {
 }
 
 Domain::~Domain() {
+    _pendingDictionaryTraining.waitForZeroRefCount();
     {
         std::unique_lock guard(_currentChunkMutex);
         commitChunk(grabCurrentChunk(guard), guard);
@@ -222,7 +261,7 @@ Domain::triggerSyncNow(std::unique_ptr<vespalib::IDestructorCallback> after_sync
     }
     _singleCommitter->execute(makeLambdaTask([this, after_sync=std::move(after_sync)]() {
         (void) after_sync;
-        getActivePart()->sync();
+        syncAndReleaseChunks(*getActivePart());
     }));
 }
 
@@ -301,12 +340,23 @@ Domain::cleanSessions()
 }
 
 DomainPart::SP
-Domain::optionallyRotateFile(SerialNum serialNum) {
+Domain::optionallyRotateFile(SerialNum serialNum, const IChunk::DictionarySP & dictionary) {
     DomainPart::SP dp = getActivePart();
-    if (dp->byteSize() > _config.getPartSizeLimit()) {
-        dp->sync();
-        dp->close();
-        dp = std::make_shared<DomainPart>(_name, dir(), serialNum, _fileHeaderContext, false);
+    // Chunks must be written to a part with the dictionary they were compressed with
+    bool newDictionary = (dp->dictionary() != dictionary);
+    if ((dp->byteSize() > _config.getPartSizeLimit()) || newDictionary) {
+        if (dp->size() == 0) {
+            // Nothing written to the part yet, replace it instead of leaving an empty part behind
+            {
+                std::lock_guard guard(_partsMutex);
+                _parts.erase(std::prev(_parts.end()));
+            }
+            dp->erase(dp->range().to() + 1);
+        } else {
+            dp->sync();
+            dp->close();
+        }
+        dp = std::make_shared<DomainPart>(_name, dir(), serialNum, _fileHeaderContext, false, dictionary);
         {
             std::lock_guard guard(_partsMutex);
             _parts[serialNum] = dp;
@@ -370,33 +420,111 @@ Domain::commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunk
     assert(chunkOrderGuard.mutex() == &_currentChunkMutex && chunkOrderGuard.owns_lock());
     if (chunk->getPacket().empty()) return;
     chunk->shrinkPayloadToFit();
+    if (useDictionary()) {
+        sampleForDictionary(chunk->getPacket(), chunkOrderGuard);
+    }
     std::promise<SerializedChunk> promise;
     std::future<SerializedChunk> future = promise.get_future();
     _executor.execute(makeLambdaTask([promise=std::move(promise), chunk = std::move(chunk),
-                                      encoding=_config.getEncoding(), compressionLevel=_config.getCompressionlevel()]() mutable {
-        promise.set_value(SerializedChunk(std::move(chunk), encoding, compressionLevel));
+                                      encoding=_config.getEncoding(), compressionLevel=_config.getCompressionlevel(),
+                                      dictionary=_dictionary]() mutable {
+        promise.set_value(SerializedChunk(std::move(chunk), encoding, compressionLevel, std::move(dictionary)));
     }));
+    _pendingCommits.fetch_add(1, std::memory_order_relaxed);
     _singleCommitter->execute( makeLambdaTask([this, future = std::move(future)]() mutable {
+        _pendingCommits.fetch_sub(1, std::memory_order_relaxed);
         doCommit(future.get());
     }));
 }
 
-
+void
+Domain::sampleForDictionary(const Packet & packet, const UniqueLock & guard) {
+    assert(guard.mutex() == &_currentChunkMutex && guard.owns_lock());
+    if (_dictionaryTrainingPending) {
+        return;
+    }
+    if (_bytesSinceDictionaryTraining < _config.getPartSizeLimit() * DICTIONARY_RETRAIN_PARTS) {
+        _bytesSinceDictionaryTraining += packet.sizeBytes();
+        return;
+    }
+    vespalib::nbostream_longlivedbuf is(packet.getHandle().data(), packet.getHandle().size());
+    while ( ! is.empty()) {
+        const char * start = is.peek();
+        size_t before = is.size();
+        Packet::Entry entry;
+        entry.deserialize(is);
+        _dictionarySamples.append(start, before - is.size());
+        _dictionarySampleSizes.push_back(before - is.size());
+    }
+    size_t dictionarySize = _config.getDictionarySize();
+    if (_dictionarySamples.size() < dictionarySize * DICTIONARY_SAMPLE_FACTOR) {
+        return;
+    }
+    _dictionaryTrainingPending = true;
+    _executor.execute(makeLambdaTask([this, samples = std::move(_dictionarySamples), sizes = std::move(_dictionarySampleSizes),
+                                      dictionarySize, compressionLevel = _config.getCompressionlevel(),
+                                      refGuard = vespalib::RetainGuard(_pendingDictionaryTraining)]() {
+        (void) refGuard;
+        std::shared_ptr<const ZStdDictionary> dictionary = ZStdDictionary::train(samples, sizes, dictionarySize, compressionLevel);
+        std::lock_guard chunkGuard(_currentChunkMutex);
+        if (dictionary && useDictionary()) {
+            LOG(debug, "Domain %s: Trained dictionary %u of %zu bytes from %zu samples",
+                _name.c_str(), dictionary->id(), dictionary->content().size(), sizes.size());
+            _dictionary = std::move(dictionary);
+        }
+        _dictionaryTrainingPending = false;
+        _bytesSinceDictionaryTraining = 0;
+    }));
+    _dictionarySamples.clear();
+    _dictionarySampleSizes.clear();
+}
 
 void
-Domain::doCommit(const SerializedChunk & serialized) {
+Domain::doCommit(SerializedChunk serialized) {
 
     SerialNumRange range = serialized.range();
-    DomainPart::SP dp = optionallyRotateFile(range.from());
+    DomainPart::SP dp = optionallyRotateFile(range.from(), serialized.dictionary());
     dp->commit(serialized);
+    cleanSessions();
     if (_config.getFSyncOnCommit()) {
-        dp->sync();
+        /*
+         * Group commit: while more chunks are queued behind this one the
+         * sync is deferred, and a single sync by the last of them makes all
+         * written chunks durable. Acks are held until then. The group is
+         * bounded so a steady stream of commits still gets synced.
+         */
+        if (_unsyncedCommits.empty()) {
+            _firstUnsyncedTime = vespalib::steady_clock::now();
+        }
+        _unsyncedBytes += serialized.getData().size();
+        _unsyncedCommits.push_back(serialized.stealCommitChunk());
+        if ((_pendingCommits.load(std::memory_order_relaxed) > 0) &&
+            (_unsyncedCommits.size() < MAX_GROUPED_COMMITS) &&
+            (_unsyncedBytes < MAX_GROUPED_BYTES) &&
+            (vespalib::steady_clock::now() - _firstUnsyncedTime < MAX_GROUPED_DELAY))
+        {
+            return;
+        }
+        syncAndReleaseChunks(*dp);
+        return;
+    }
+    if ( ! _unsyncedCommits.empty()) {
+        // fsync on commit was turned off while acks were held
+        syncAndReleaseChunks(*dp);
     }
-    cleanSessions();
     LOG(debug, "Releasing %zu acks and %zu entries and %zu bytes.",
         serialized.getNumCallBacks(), serialized.getNumEntries(), serialized.getData().size());
 }
 
+void
+Domain::syncAndReleaseChunks(DomainPart & dp) {
+    dp.sync();
+    _numSyncs.fetch_add(1, std::memory_order_relaxed);
+    LOG(debug, "Releasing %zu chunks after sync.", _unsyncedCommits.size());
+    _unsyncedCommits.clear();
+    _unsyncedBytes = 0;
+}
+
 bool
 Domain::erase(SerialNum to)
 {
@@ -2,6 +2,8 @@
 #pragma once
 
 #include "domainconfig.h"
+#include <vespa/vespalib/util/monitored_refcount.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <vespa/vespalib/util/threadexecutor.h>
 #include <atomic>
 #include <mutex>
@@ -19,6 +21,10 @@ public:
     using SP = std::shared_ptr<Domain>;
     using DomainPartSP = std::shared_ptr<DomainPart>;
     using FileHeaderContext = common::FileHeaderContext;
+    // Bounds on how many written commits, and how much data, may wait for a shared sync
+    static constexpr size_t MAX_GROUPED_COMMITS = 64;
+    static constexpr size_t MAX_GROUPED_BYTES = 16_Mi;
+    static constexpr vespalib::duration MAX_GROUPED_DELAY = 100ms;
     Domain(const std::string &name, const std::string &baseDir, vespalib::Executor & executor,
            const DomainConfig & cfg, const FileHeaderContext &fileHeaderContext);
 
@@ -35,6 +41,8 @@ public:
     SerialNum begin() const;
     SerialNum end() const;
     SerialNum getSynced() const;
+    // Number of syncs done to make committed chunks durable
+    uint64_t getNumSyncs() const { return _numSyncs.load(std::memory_order_relaxed); }
     void triggerSyncNow(std::unique_ptr<vespalib::IDestructorCallback> after_sync);
     bool getMarkedDeleted() const { return _markedDeleted; }
     void markDeleted() { _markedDeleted = true; }
@@ -63,7 +71,8 @@ private:
 
     std::unique_ptr<CommitChunk> grabCurrentChunk(const UniqueLock & guard);
     void commitChunk(std::unique_ptr<CommitChunk> chunk, const UniqueLock & chunkOrderGuard);
-    void doCommit(const SerializedChunk & serialized);
+    void doCommit(SerializedChunk serialized);
+    void syncAndReleaseChunks(DomainPart & dp);
     SerialNum begin(const UniqueLock & guard) const;
     SerialNum end(const UniqueLock & guard) const;
     size_t byteSize(const UniqueLock & guard) const;
@@ -71,7 +80,9 @@ private:
     void cleanSessions();
     std::string dir() const { return getDir(_baseDir, _name); }
     void addPart(SerialNum partId, bool isLastPart);
-    DomainPartSP optionallyRotateFile(SerialNum serialNum);
+    DomainPartSP optionallyRotateFile(SerialNum serialNum, const IChunk::DictionarySP & dictionary);
+    bool useDictionary() const;
+    void sampleForDictionary(const Packet & packet, const UniqueLock & guard);
 
     using SerialNumList = std::vector<SerialNum>;
 
@@ -85,6 +96,19 @@ private:
     DomainConfig                 _config;
     std::unique_ptr<CommitChunk> _currentChunk;
     SerialNum                    _lastSerial;
+    std::atomic<size_t>          _pendingCommits;
+    // Acks of written but not yet synced chunks, only accessed by the single committer
+    std::vector<std::unique_ptr<CommitChunk>> _unsyncedCommits;
+    size_t                       _unsyncedBytes;
+    vespalib::steady_time        _firstUnsyncedTime;
+    std::atomic<uint64_t>        _numSyncs;
+    // Dictionary state is protected by _currentChunkMutex
+    IChunk::DictionarySP         _dictionary;
+    std::string                  _dictionarySamples;
+    std::vector<size_t>          _dictionarySampleSizes;
+    size_t                       _bytesSinceDictionaryTraining;
+    bool                         _dictionaryTrainingPending;
+    vespalib::MonitoredRefCount  _pendingDictionaryTraining;
     std::unique_ptr<Executor>    _singleCommitter;
     Executor                    &_executor;
     std::atomic<int>             _sessionId;
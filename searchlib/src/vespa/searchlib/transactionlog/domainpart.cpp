@@ -2,7 +2,9 @@
 
 #include "domainpart.h"
 #include <vespa/vespalib/util/stringfmt.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <vespa/vespalib/data/fileheader.h>
+#include <vespa/vespalib/encoding/base64.h>
 #include <vespa/searchlib/common/fileheadercontext.h>
 #include <vespa/fastlib/io/bufferedfile.h>
 #include <cassert>
@@ -19,6 +21,7 @@ using vespalib::IllegalHeaderException;
 using vespalib::nbostream;
 using vespalib::nbostream_longlivedbuf;
 using vespalib::alloc::Alloc;
+using vespalib::compression::ZStdDictionary;
 using search::common::FileHeaderContext;
 using std::runtime_error;
 
@@ -27,6 +30,8 @@ namespace search::transactionlog {
 namespace {
 
 constexpr size_t TARGET_PACKET_SIZE = 0x3f000;
+const std::string DICTIONARY_TAG = "zstdDictionary";
+const std::string DICTIONARY_LEVEL_TAG = "zstdDictionaryLevel";
 
 string
 handleWriteError(const char *text, FastOS_FileInterface &file, int64_t lastKnownGoodPos,
@@ -162,14 +167,15 @@ handleReadError(const char *text, FastOS_FileInterface &file, ssize_t len, ssize
 }
 
 Packet
-DomainPart::readPacket(FastOS_FileInterface & transLog, SerialNumRange wanted, size_t targetSize, bool allowTruncate) {
+DomainPart::readPacket(FastOS_FileInterface & transLog, SerialNumRange wanted, size_t targetSize,
+                       const DictionarySP & dictionary, bool allowTruncate) {
     Alloc buf;
     Packet packet(targetSize);
     int64_t fSize(transLog.getSize());
     int64_t currPos(transLog.getPosition());
     while ((packet.sizeBytes() < targetSize) && (currPos < fSize) && (packet.range().to() < wanted.to())) {
         IChunk::UP chunk;
-        if (read(transLog, chunk, buf, allowTruncate)) {
+        if (read(transLog, chunk, buf, dictionary, allowTruncate)) {
             if (chunk) {
                 try {
                     for (const Packet::Entry & e : chunk->getEntries()) {
@@ -211,6 +217,7 @@ DomainPart::buildPacketMapping(bool allowTruncate)
     try {
         FileHeader header;
         _headerLen = header.readFile(transLog);
+        readDictionary(header);
         transLog.SetPosition(_headerLen);
         currPos = _headerLen;
     } catch (const IllegalHeaderException &e) {
@@ -231,7 +238,7 @@ DomainPart::buildPacketMapping(bool allowTruncate)
     const SerialNumRange all(0, std::numeric_limits<SerialNum>::max());
     while ((currPos < fSize)) {
         const int64_t firstPos(currPos);
-        Packet packet = readPacket(transLog, all, TARGET_PACKET_SIZE, allowTruncate);
+        Packet packet = readPacket(transLog, all, TARGET_PACKET_SIZE, _dictionary, allowTruncate);
         if (!packet.empty()) {
             set_size(size() + packet.size());
             const SerialNum firstSerial = packet.range().from();
@@ -251,6 +258,12 @@ DomainPart::buildPacketMapping(bool allowTruncate)
 
 DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
                        const FileHeaderContext &fileHeaderContext, bool allowTruncate)
+    : DomainPart(name, baseDir, s, fileHeaderContext, allowTruncate, DictionarySP())
+{
+}
+
+DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
+                       const FileHeaderContext &fileHeaderContext, bool allowTruncate, DictionarySP dictionary)
     : _lock(),
       _fileLock(),
       _range_from(s),
@@ -260,6 +273,7 @@ DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
       _fileName(fmt("%s/%s-%016" PRIu64, baseDir.c_str(), name.c_str(), s)),
       _transLog(std::make_unique<FastOS_File>(_fileName.c_str())),
       _skipList(),
+      _dictionary(),
       _headerLen(0),
       _writeLock(),
       _writtenSerial(0),
@@ -289,6 +303,7 @@ DomainPart::DomainPart(const string & name, const string & baseDir, SerialNum s,
             LOG(error, "%s", e.c_str());
             throw runtime_error(e);
         }
+        _dictionary = std::move(dictionary);
         writeHeader(fileHeaderContext);
         _byteSize = _headerLen;
     }
@@ -318,9 +333,23 @@ DomainPart::writeHeader(const FileHeaderContext &fileHeaderContext)
     assert(_transLog->getPosition() == 0);
     fileHeaderContext.addTags(header, _transLog->GetFileName());
     header.putTag(Tag("desc", "Transaction log domain part file"));
+    if (_dictionary) {
+        header.putTag(Tag(DICTIONARY_TAG, vespalib::Base64::encode(_dictionary->content())));
+        header.putTag(Tag(DICTIONARY_LEVEL_TAG, int64_t(_dictionary->compressionLevel())));
+    }
     _headerLen = header.writeFile(*_transLog);
 }
 
+void
+DomainPart::readDictionary(const vespalib::GenericHeader & header)
+{
+    if (header.hasTag(DICTIONARY_TAG)) {
+        int compressionLevel = header.hasTag(DICTIONARY_LEVEL_TAG) ? header.getTag(DICTIONARY_LEVEL_TAG).asInteger() : 3;
+        _dictionary = std::make_shared<const ZStdDictionary>(vespalib::Base64::decode(header.getTag(DICTIONARY_TAG).asString()),
+                                                             compressionLevel);
+    }
+}
+
 bool
 DomainPart::close()
 {
@@ -423,7 +452,7 @@ DomainPart::visit(FastOS_FileInterface &file, SerialNumRange &r, Packet &packet)
         return false;
     }
 
-    packet = readPacket(file, r, TARGET_PACKET_SIZE, false);
+    packet = readPacket(file, r, TARGET_PACKET_SIZE, _dictionary, false);
     if (!packet.empty()) {
         r.from(packet.range().to());
     }
@@ -445,7 +474,8 @@ DomainPart::write(FastOS_FileInterface &file, SerialNumRange range, vespalib::Co
 }
 
 bool
-DomainPart::read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc & buf, bool allowTruncate)
+DomainPart::read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc & buf,
+                 const DictionarySP & dictionary, bool allowTruncate)
 {
     char tmp[5];
     int64_t lastKnownGoodPos(file.getPosition());
@@ -461,7 +491,7 @@ DomainPart::read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc & buf, bo
     }
 
     try {
-        chunk = IChunk::create(encoding);
+        chunk = IChunk::create(Encoding(encoding), 9, dictionary);
     } catch (const std::exception & e) {
         string msg(fmt("Version mismatch. Expected 'ccitt_crc32=1' or 'xxh64=2', got %d from '%s' at position %" PRId64,
                        encoding, file.GetFileName(), lastKnownGoodPos));
@@ -11,16 +11,25 @@
 
 class FastOS_FileInterface;
 
+namespace vespalib { class GenericHeader; }
+
 namespace search::common { class FileHeaderContext; }
 namespace search::transactionlog {
 
 class DomainPart {
 public:
     using SP = std::shared_ptr<DomainPart>;
+    using DictionarySP = IChunk::DictionarySP;
     DomainPart(const DomainPart &) = delete;
     DomainPart& operator=(const DomainPart &) = delete;
     DomainPart(const std::string &name, const std::string &baseDir, SerialNum s,
                const common::FileHeaderContext &FileHeaderContext, bool allowTruncate);
+    /**
+     * The dictionary is written to the header of a new part file. An existing
+     * part file keeps the dictionary from its header.
+     **/
+    DomainPart(const std::string &name, const std::string &baseDir, SerialNum s,
+               const common::FileHeaderContext &FileHeaderContext, bool allowTruncate, DictionarySP dictionary);
 
     ~DomainPart();
 
@@ -42,12 +51,17 @@ public:
         return _byteSize.load(std::memory_order_acquire);
     }
     bool        isClosed() const;
+    // The zstd dictionary chunks in this part are compressed with, if any
+    const DictionarySP & dictionary() const noexcept { return _dictionary; }
 private:
     using Alloc = vespalib::alloc::Alloc;
     bool openAndFind(FastOS_FileInterface &file, const SerialNum &from);
     int64_t buildPacketMapping(bool allowTruncate);
-    static Packet readPacket(FastOS_FileInterface & file, SerialNumRange wanted, size_t targetSize, bool allowTruncate);
-    static bool read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc &buf, bool allowTruncate);
+    static Packet readPacket(FastOS_FileInterface & file, SerialNumRange wanted, size_t targetSize,
+                             const DictionarySP & dictionary, bool allowTruncate);
+    static bool read(FastOS_FileInterface &file, IChunk::UP & chunk, Alloc &buf,
+                     const DictionarySP & dictionary, bool allowTruncate);
+    void readDictionary(const vespalib::GenericHeader & header);
 
     void write(FastOS_FileInterface &file, SerialNumRange range, vespalib::ConstBufferRef buf);
     void writeHeader(const common::FileHeaderContext &fileHeaderContext);
@@ -83,6 +97,7 @@ private:
     std::string      _fileName;
     std::unique_ptr<FastOS_FileInterface> _transLog;
     std::vector<SkipInfo> _skipList;
+    DictionarySP          _dictionary;
     uint32_t              _headerLen;
     mutable std::mutex    _writeLock;
     // Protected by _writeLock
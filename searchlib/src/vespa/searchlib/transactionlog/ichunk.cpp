@@ -23,7 +23,7 @@ Encoding::Encoding(Crc crc, Compression compression)
     : _raw(crc | (compression << 4u))
 {
     assert(crc <= Crc::xxh64);
-    assert(compression <= Compression::zstd);
+    assert(compression <= Compression::zstd_dict);
 }
 
 IChunk::~IChunk() = default;
@@ -72,6 +72,11 @@ IChunk::create(uint8_t chunkType) {
 }
 IChunk::UP
 IChunk::create(Encoding encoding, uint8_t compressionLevel) {
+    return create(encoding, compressionLevel, DictionarySP());
+}
+
+IChunk::UP
+IChunk::create(Encoding encoding, uint8_t compressionLevel, const DictionarySP & dictionary) {
     switch (encoding.getCrc()) {
         case Encoding::Crc::xxh64:
             switch (encoding.getCompression()) {
@@ -82,7 +87,15 @@ IChunk::create(Encoding encoding, uint8_t compressionLevel) {
                 case Encoding::Compression::lz4:
                     return make_unique<XXH64CompressedChunk>(CompressionConfig::LZ4, compressionLevel);
                 case Encoding::Compression::zstd:
+                    if (dictionary) {
+                        return make_unique<XXH64ZStdDictionaryChunk>(dictionary);
+                    }
                     return make_unique<XXH64CompressedChunk>(CompressionConfig::ZSTD, compressionLevel);
+                case Encoding::Compression::zstd_dict:
+                    if ( ! dictionary) {
+                        throw IllegalArgumentException("Compression type zstd_dict requires a dictionary");
+                    }
+                    return make_unique<XXH64ZStdDictionaryChunk>(dictionary);
                 default:
                     throw IllegalArgumentException(fmt("Unhandled compression type '%d' for xxh64, compression=",
                                                        encoding.getCompression()));
@@ -136,15 +149,21 @@ encode(vespalib::nbostream & os, const IChunk & chunk, Encoding encoding) {
 }
 
 SerializedChunk::SerializedChunk(std::unique_ptr<CommitChunk> commitChunk, Encoding encoding, uint8_t compressionLevel)
+    : SerializedChunk(std::move(commitChunk), encoding, compressionLevel, DictionarySP())
+{ }
+
+SerializedChunk::SerializedChunk(std::unique_ptr<CommitChunk> commitChunk, Encoding encoding, uint8_t compressionLevel,
+                                 DictionarySP dictionary)
    : _commitChunk(std::move(commitChunk)),
      _os(),
      _range(_commitChunk->getPacket().range()),
-     _numEntries(_commitChunk->getPacket().size())
+     _numEntries(_commitChunk->getPacket().size()),
+     _dictionary(std::move(dictionary))
 {
     Packet packet = _commitChunk->stealPacket();
     nbostream_longlivedbuf h(packet.getHandle().data(), packet.getHandle().size());
 
-    IChunk::UP chunk = IChunk::create(encoding, compressionLevel);
+    IChunk::UP chunk = IChunk::create(encoding, compressionLevel, _dictionary);
     SerialNum prev = 0;
     while (h.size() > 0) {
         //LOG(spam,
@@ -4,6 +4,8 @@
 
 #include "common.h"
 
+namespace vespalib::compression { class ZStdDictionary; }
+
 namespace search::transactionlog {
 
 class Encoding {
@@ -17,7 +19,8 @@ public:
         none = 0,
         none_multi = 1,
         lz4 = 2,
-        zstd = 3
+        zstd = 3,
+        zstd_dict = 4
     };
     explicit Encoding(uint8_t raw) : _raw(raw) { }
     Encoding(Crc crc, Compression compression);
@@ -38,7 +41,9 @@ std::ostream & operator << (std::ostream & os, Encoding e);
  */
 class SerializedChunk {
 public:
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     SerializedChunk(std::unique_ptr<CommitChunk> chunk, Encoding encoding, uint8_t compressionLevel);
+    SerializedChunk(std::unique_ptr<CommitChunk> chunk, Encoding encoding, uint8_t compressionLevel, DictionarySP dictionary);
     SerializedChunk(SerializedChunk &&) = default;
     SerializedChunk & operator=(SerializedChunk &&) = default;
     SerializedChunk(const SerializedChunk &) = delete;
@@ -48,12 +53,17 @@ public:
     SerialNumRange range() const { return _range; }
     size_t getNumEntries() const { return _numEntries; }
     size_t getNumCallBacks() const { return _commitChunk->getNumCallBacks(); }
+    // The zstd dictionary the chunk was encoded with, must match the dictionary of the part it is written to
+    const DictionarySP & dictionary() const { return _dictionary; }
+    // Holds the acks of the chunk, the serialized data is not needed once written
+    std::unique_ptr<CommitChunk> stealCommitChunk() { return std::move(_commitChunk); }
 private:
     // CommitChunk is required to ensure we do not reply until committed to the TLS.
     std::unique_ptr<CommitChunk> _commitChunk;
     vespalib::nbostream _os;
     SerialNumRange      _range;
     size_t              _numEntries;
+    DictionarySP        _dictionary;
 };
 
 /**
@@ -66,6 +76,7 @@ public:
     using Entries = std::vector<Packet::Entry>;
     using nbostream = vespalib::nbostream;
     using ConstBufferRef = vespalib::ConstBufferRef;
+    using DictionarySP = std::shared_ptr<const vespalib::compression::ZStdDictionary>;
     virtual ~IChunk();
     const Entries & getEntries() const { return _entries; }
     void add(const Packet::Entry & entry);
@@ -73,6 +84,8 @@ public:
     void decode(nbostream & buf);
     static UP create(uint8_t chunkType);
     static UP create(Encoding chunkType, uint8_t compressionLevel);
+    // zstd chunks are compressed with the dictionary if given, and zstd_dict chunks require it
+    static UP create(Encoding chunkType, uint8_t compressionLevel, const DictionarySP & dictionary);
     SerialNumRange range() const;
 protected:
     virtual Encoding onEncode(nbostream & os) const = 0;
@@ -0,0 +1,121 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/btree/btreeroot.h>
+#include <vespa/vespalib/btree/btreebuilder.h>
+#include <vespa/vespalib/btree/btreenodeallocator.h>
+#include <vespa/vespalib/btree/btree.h>
+#include <vespa/vespalib/btree/btreenodeallocator.hpp>
+#include <vespa/vespalib/btree/btreenode.hpp>
+#include <vespa/vespalib/btree/btreenodestore.hpp>
+#include <vespa/vespalib/btree/btreeiterator.hpp>
+#include <vespa/vespalib/btree/btreeroot.hpp>
+#include <vespa/vespalib/btree/btreebuilder.hpp>
+#include <vespa/vespalib/btree/btree.hpp>
+#include <vespa/vespalib/datastore/buffer_type.hpp>
+#include <vespa/vespalib/util/time.h>
+#include <cassert>
+#include <random>
+#include <vector>
+
+using vespalib::btree::BTree;
+using vespalib::btree::BTreeNode;
+using vespalib::btree::BTreeTraits;
+
+namespace {
+
+/*
+ * Comparator equivalent to std::less<uint32_t> that is not recognized
+ * by BTreeNodeT, forcing the binary search used for other key types.
+ */
+struct BinarySearchLess {
+    bool operator()(uint32_t lhs, uint32_t rhs) const noexcept { return lhs < rhs; }
+};
+
+template <typename CompareT>
+const char *search_name()
+{
+    return std::is_same_v<CompareT, std::less<uint32_t>> ? "counting" : "binary";
+}
+
+}
+
+class LookupSpeed
+{
+    std::vector<uint32_t> _probes;
+    template <typename Traits, typename CompareT>
+    void work_loop();
+public:
+    LookupSpeed();
+    int main();
+};
+
+LookupSpeed::LookupSpeed()
+    : _probes()
+{
+}
+
+template <typename Traits, typename CompareT>
+void
+LookupSpeed::work_loop()
+{
+    using Tree = BTree<uint32_t, uint32_t, vespalib::btree::NoAggregated, CompareT, Traits>;
+    using Builder = typename Tree::Builder;
+    using ConstIterator = typename Tree::ConstIterator;
+    Tree tree;
+    Builder builder(tree.getAllocator());
+    uint32_t numEntries = 1000000;
+    size_t numOuterLoops = 10;
+    for (uint32_t i = 0; i < numEntries; ++i) {
+        builder.insert(i * 2, i);
+    }
+    tree.assign(builder);
+    assert(numEntries == tree.size());
+    assert(tree.isValid());
+    size_t found = 0;
+    vespalib::Timer timer;
+    for (size_t outerl = 0; outerl < numOuterLoops; ++outerl) {
+        for (uint32_t probe : _probes) {
+            ConstIterator itr(BTreeNode::Ref(), tree.getAllocator());
+            itr.lower_bound(tree.getRoot(), probe);
+            if (itr.valid() && itr.getKey() == probe) {
+                ++found;
+            }
+        }
+    }
+    double used = vespalib::to_s(timer.elapsed());
+    assert(found == numOuterLoops * _probes.size() / 2);
+    printf("Elapsed time for %zu lookups is %8.5f, search=%s, fanout=%u,%u\n",
+           numOuterLoops * _probes.size(),
+           used,
+           search_name<CompareT>(),
+           static_cast<int>(Traits::LEAF_SLOTS),
+           static_cast<int>(Traits::INTERNAL_SLOTS));
+    fflush(stdout);
+}
+
+int
+LookupSpeed::main()
+{
+    std::mt19937 rnd(42);
+    uint32_t numEntries = 1000000;
+    _probes.reserve(numEntries);
+    for (uint32_t i = 0; i < numEntries * 2; i += 2) {
+        _probes.push_back(i + ((i / 2) & 1));
+    }
+    std::shuffle(_probes.begin(), _probes.end(), rnd);
+    using DefTraits = vespalib::btree::BTreeDefaultTraits;
+    using LargeTraits = BTreeTraits<32, 16, 10, true>;
+    using HugeTraits = BTreeTraits<64, 32, 10, true>;
+    work_loop<DefTraits, BinarySearchLess>();
+    work_loop<DefTraits, std::less<uint32_t>>();
+    work_loop<LargeTraits, BinarySearchLess>();
+    work_loop<LargeTraits, std::less<uint32_t>>();
+    work_loop<HugeTraits, BinarySearchLess>();
+    work_loop<HugeTraits, std::less<uint32_t>>();
+    return 0;
+}
+
+int main(int, char **) {
+    LookupSpeed app;
+    return app.main();
+}
@@ -711,6 +711,24 @@ TEST_F(BTreeTest, require_that_node_lower_bound_works)
     cleanup(g, m, nPair.ref, n);
 }
 
+TEST_F(BTreeTest, require_that_node_upper_bound_works)
+{
+    GenerationHandler g;
+    MyNodeAllocator m;
+    MyLeafNode::RefPair nPair = getLeafNode(m);
+    MyLeafNode *n = nPair.data;
+    EXPECT_EQ(2u, n->upper_bound(0, 3, MyComp()));
+    EXPECT_EQ(0u, n->upper_bound(0, 0, MyComp()));
+    EXPECT_EQ(1u, n->upper_bound(0, 2, MyComp()));
+    EXPECT_EQ(4u, n->upper_bound(0, 7, MyComp()));
+    EXPECT_EQ(4u, n->upper_bound(0, 8, MyComp()));
+    EXPECT_EQ(2u, n->upper_bound(2, 3, MyComp()));
+    EXPECT_EQ(3u, n->upper_bound(2, 5, MyComp()));
+    EXPECT_EQ(2u, n->lower_bound(2, 1, MyComp()));
+    EXPECT_EQ(3u, n->lower_bound(2, 6, MyComp()));
+    cleanup(g, m, nPair.ref, n);
+}
+
 void
 generateData(std::vector<LeafPair> & data, size_t numEntries)
 {
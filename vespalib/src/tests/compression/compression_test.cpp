@@ -2,7 +2,9 @@
 
 #include <vespa/vespalib/gtest/gtest.h>
 #include <vespa/vespalib/util/compressor.h>
+#include <vespa/vespalib/util/zstd_dictionary.h>
 #include <vespa/vespalib/data/databuffer.h>
+#include <vespa/vespalib/util/size_literals.h>
 #include <atomic>
 #include <string>
 
@@ -73,4 +75,48 @@ TEST(CompressionTest, require_that_CompressionConfig_is_Atomic) {
     EXPECT_TRUE(std::atomic<CompressionConfig>::is_always_lock_free);
 }
 
+TEST(CompressionTest, require_that_zstd_dictionary_improves_compression_of_small_similar_inputs) {
+    std::string samples;
+    std::vector<size_t> sample_sizes;
+    auto make_doc = [](size_t i) {
+        return "{\"id\":\"id:ns:music::" + std::to_string(i * 7919) + "\",\"fields\":{\"title\":\"Title number " +
+               std::to_string(i) + "\",\"artist\":\"Artist " + std::to_string(i % 97) + "\",\"year\":" +
+               std::to_string(1950 + i % 70) + ",\"genre\":\"" + ((i % 3 == 0) ? "rock" : "jazz") + "\"}}";
+    };
+    for (size_t i = 0; i < 2000; ++i) {
+        std::string doc = make_doc(i);
+        samples += doc;
+        sample_sizes.push_back(doc.size());
+    }
+    auto dictionary = ZStdDictionary::train(samples, sample_sizes, 4_Ki, 3);
+    ASSERT_TRUE(dictionary);
+    EXPECT_NE(0u, dictionary->id());
+    EXPECT_GE(4_Ki, dictionary->content().size());
+
+    std::string doc = make_doc(100000);
+    std::vector<char> compressed(ZStdDictionary::compressBound(doc.size()));
+    size_t with_dictionary = dictionary->compress(doc.data(), doc.size(), compressed.data(), compressed.size());
+    ASSERT_LT(0u, with_dictionary);
+    CompressionConfig cfg(CompressionConfig::Type::ZSTD, 3, 100);
+    DataBuffer plain;
+    compress(cfg, ConstBufferRef(doc.data(), doc.size()), plain, false);
+    EXPECT_LT(with_dictionary, plain.getDataLen());
+    EXPECT_LT(with_dictionary, doc.size() / 2);
+
+    std::string decompressed(doc.size(), '\0');
+    EXPECT_TRUE(dictionary->decompress(compressed.data(), with_dictionary, decompressed.data(), decompressed.size()));
+    EXPECT_EQ(doc, decompressed);
+
+    ZStdDictionary reloaded(dictionary->content(), 3);
+    EXPECT_EQ(dictionary->id(), reloaded.id());
+    std::string decompressed2(doc.size(), '\0');
+    EXPECT_TRUE(reloaded.decompress(compressed.data(), with_dictionary, decompressed2.data(), decompressed2.size()));
+    EXPECT_EQ(doc, decompressed2);
+}
+
+TEST(CompressionTest, require_that_zstd_dictionary_training_fails_without_enough_samples) {
+    std::vector<size_t> sample_sizes = {5};
+    EXPECT_FALSE(ZStdDictionary::train("hello", sample_sizes, 4_Ki, 3));
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
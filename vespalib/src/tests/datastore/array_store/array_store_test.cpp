@@ -440,6 +440,43 @@ TEST_F(NumberStoreTwoSmallBufferTypesTest, buffer_with_most_dead_space_is_compac
     test_compaction(*this);
 }
 
+TEST_F(NumberStoreTwoSmallBufferTypesTest, compaction_can_be_performed_in_steps)
+{
+    std::vector<AtomicEntryRef> refs;
+    for (uint32_t i = 0; i < 10; ++i) {
+        refs.emplace_back(add({i, i}));
+    }
+    ASSERT_NO_FATAL_FAILURE(remove(add({20, 20})));
+    reclaim_memory();
+    EntryRef old_ref = refs[0].load_relaxed();
+    uint32_t old_buffer_id = getBufferId(old_ref);
+    store.set_compaction_spec(CompactionSpec(true, false));
+    auto ctx = store.compact_worst(CompactionStrategy());
+    auto count_moved = [&]() {
+        uint32_t moved = 0;
+        for (auto& ref : refs) {
+            if (getBufferId(ref.load_relaxed()) != old_buffer_id) {
+                ++moved;
+            }
+        }
+        return moved;
+    };
+    EXPECT_FALSE(ctx->compact_step(std::span<AtomicEntryRef>(refs), 4));
+    EXPECT_EQ(4u, count_moved());
+    EXPECT_FALSE(ctx->compact_step(std::span<AtomicEntryRef>(refs), 4));
+    EXPECT_EQ(8u, count_moved());
+    EXPECT_TRUE(ctx->compact_step(std::span<AtomicEntryRef>(refs), 4));
+    EXPECT_EQ(10u, count_moved());
+    for (uint32_t i = 0; i < 10; ++i) {
+        assertGet(refs[i].load_relaxed(), {i, i});
+    }
+    EXPECT_FALSE(store.bufferState(old_ref).isOnHold());
+    ctx.reset();
+    EXPECT_TRUE(store.bufferState(old_ref).isOnHold());
+    reclaim_memory();
+    EXPECT_TRUE(store.bufferState(old_ref).isFree());
+}
+
 namespace {
 
 template <typename Fixture>
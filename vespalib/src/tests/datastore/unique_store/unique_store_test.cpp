@@ -10,6 +10,7 @@
 #include <vespa/vespalib/test/datastore/buffer_stats.h>
 #include <vespa/vespalib/test/memory_allocator_observer.h>
 #include <vespa/vespalib/util/traits.h>
+#include <thread>
 #include <vector>
 
 #include <vespa/log/log.h>
@@ -290,6 +291,70 @@ using StringTest = TestBase<BTreeStringUniqueStore>;
 using CStringTest = TestBase<BTreeCStringUniqueStore>;
 using DoubleTest = TestBase<BTreeDoubleUniqueStore>;
 using SmallOffsetNumberTest = TestBase<BTreeSmallOffsetNumberUniqueStore>;
+using HybridNumberTest = TestBase<HybridNumberUniqueStore>;
+using HashNumberTest = TestBase<HashNumberUniqueStore>;
+
+namespace {
+
+template <typename TestType>
+void
+add_concurrently(TestType& test, uint32_t num_threads, uint32_t num_values)
+{
+    std::vector<std::thread> threads;
+    for (uint32_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back([&test, num_values]() {
+            for (uint32_t value = 0; value < num_values; ++value) {
+                test.store.add_concurrent(value);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(num_values, test.store.get_dictionary().get_num_uniques());
+    for (uint32_t value = 0; value < num_values; ++value) {
+        auto ref = test.store.find(value);
+        ASSERT_TRUE(ref.valid());
+        EXPECT_EQ(value, test.store.get(ref));
+        EXPECT_EQ(num_threads, test.store.get_allocator().get_wrapped(ref).get_ref_count());
+    }
+    test.reclaim_memory();
+}
+
+/*
+ * Each thread adds both values shared with the other threads and values of
+ * its own, so that reference counts of existing entries are updated while
+ * other threads allocate entries and grow the primary buffer.
+ */
+template <typename TestType>
+void
+add_concurrently_while_growing_buffer(TestType& test, uint32_t num_threads, uint32_t num_values)
+{
+    auto alloc_cnt_before = test.stats.alloc_cnt;
+    std::vector<std::thread> threads;
+    for (uint32_t thread_id = 0; thread_id < num_threads; ++thread_id) {
+        threads.emplace_back([&test, thread_id, num_values]() {
+            for (uint32_t value = 0; value < num_values; ++value) {
+                test.store.add_concurrent(value);
+                test.store.add_concurrent((thread_id + 1) * num_values + value);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_LT(alloc_cnt_before + 1, test.stats.alloc_cnt);
+    EXPECT_EQ((num_threads + 1) * num_values, test.store.get_dictionary().get_num_uniques());
+    for (uint32_t value = 0; value < (num_threads + 1) * num_values; ++value) {
+        auto ref = test.store.find(value);
+        ASSERT_TRUE(ref.valid());
+        EXPECT_EQ(value, test.store.get(ref));
+        EXPECT_EQ((value < num_values) ? num_threads : 1u, test.store.get_allocator().get_wrapped(ref).get_ref_count());
+    }
+    test.reclaim_memory();
+}
+
+}
 
 TEST(UniqueStoreTest, trivial_and_non_trivial_types_are_tested)
 {
@@ -427,6 +492,21 @@ TYPED_TEST(TestBase, provided_memory_allocator_is_used)
     }
 }
 
+TEST_F(HashNumberTest, values_can_be_added_concurrently)
+{
+    add_concurrently(*this, 4, 20000);
+}
+
+TEST_F(HybridNumberTest, values_can_be_added_concurrently)
+{
+    add_concurrently(*this, 4, 20000);
+}
+
+TEST_F(HashNumberTest, reference_counts_are_kept_when_buffer_grows_during_concurrent_adds)
+{
+    add_concurrently_while_growing_buffer(*this, 8, 20000);
+}
+
 TEST_F(DoubleTest, nan_is_handled)
 {
     std::vector<double> myvalues = {
@@ -462,7 +542,7 @@ TEST_F(DoubleTest, nan_is_handled)
 
 TEST_F(DoubleTest, control_memory_usage) {
     static constexpr size_t sizeof_deque = vespalib::datastore::DataStoreBase::sizeof_entry_ref_hold_list_deque;
-    EXPECT_EQ(400u + sizeof_deque, sizeof(store));
+    EXPECT_EQ(440u + sizeof_deque, sizeof(store));
     EXPECT_EQ(112u, sizeof(BufferState));
     EXPECT_EQ(28740u, store.get_values_memory_usage().allocatedBytes());
     EXPECT_EQ(24772u, store.get_values_memory_usage().usedBytes());
@@ -3,6 +3,7 @@
 #include <vespa/vespalib/util/execution_profiler.h>
 #include <vespa/vespalib/data/slime/slime.h>
 #include <vespa/vespalib/gtest/gtest.h>
+#include <map>
 #include <thread>
 
 using Profiler = vespalib::ExecutionProfiler;
@@ -232,4 +233,54 @@ TEST(ExecutionProfilerTest, flat_profiling_does_not_report_tasks_with_count_0) {
     EXPECT_EQ(slime["roots"][0]["count"].asLong(), 1);
 }
 
+using Stacks = std::map<std::string,std::pair<size_t,vespalib::duration>>;
+
+Stacks collect_stacks(const Profiler &profiler) {
+    Stacks stacks;
+    profiler.visit_stacks([&stacks](const std::vector<std::string> &stack, size_t count, vespalib::duration self_time)
+                          {
+                              std::string name;
+                              for (const auto &frame: stack) {
+                                  name += name.empty() ? frame : (";" + frame);
+                              }
+                              EXPECT_TRUE(stacks.emplace(name, std::make_pair(count, self_time)).second);
+                          });
+    return stacks;
+}
+
+TEST(ExecutionProfilerTest, visit_tree_stacks) {
+    Profiler profiler(64);
+    for (int i = 0; i < 3; ++i) {
+        foo(profiler);
+        fox(profiler);
+    }
+    auto stacks = collect_stacks(profiler);
+    EXPECT_EQ(stacks.size(), 9u);
+    EXPECT_EQ(stacks["foo"].first, 3u);
+    EXPECT_EQ(stacks["foo;bar"].first, 3u);
+    EXPECT_EQ(stacks["foo;bar;baz"].first, 6u);
+    EXPECT_EQ(stacks["foo;bar;baz;fox"].first, 18u);
+    EXPECT_EQ(stacks["foo;bar;fox"].first, 6u);
+    EXPECT_EQ(stacks["foo;baz"].first, 3u);
+    EXPECT_EQ(stacks["foo;baz;fox"].first, 9u);
+    EXPECT_EQ(stacks["foo;fox"].first, 3u);
+    EXPECT_EQ(stacks["fox"].first, 3u);
+    EXPECT_GE(stacks["foo;bar;baz;fox"].second, 18ms);
+    EXPECT_LT(stacks["foo;bar;baz"].second, stacks["foo;bar;baz;fox"].second);
+}
+
+TEST(ExecutionProfilerTest, visit_flat_stacks) {
+    Profiler profiler(-64);
+    for (int i = 0; i < 3; ++i) {
+        foo(profiler);
+    }
+    auto stacks = collect_stacks(profiler);
+    EXPECT_EQ(stacks.size(), 4u);
+    EXPECT_EQ(stacks["foo"].first, 3u);
+    EXPECT_EQ(stacks["bar"].first, 3u);
+    EXPECT_EQ(stacks["baz"].first, 9u);
+    EXPECT_EQ(stacks["fox"].first, 36u);
+    EXPECT_GE(stacks["fox"].second, 36ms);
+}
+
 GTEST_MAIN_RUN_ALL_TESTS()
@@ -0,0 +1,72 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include <vespa/vespalib/util/huge_page_allocator.h>
+#include <vespa/vespalib/util/alloc.h>
+#include <vespa/vespalib/util/size_literals.h>
+#include <vespa/vespalib/gtest/gtest.h>
+#include <cstring>
+
+using vespalib::alloc::Alloc;
+using vespalib::alloc::HugePageAllocator;
+using vespalib::alloc::MemoryAllocator;
+
+TEST(HugePageAllocatorTest, empty_allocation_is_null)
+{
+    HugePageAllocator allocator;
+    auto buf = allocator.alloc(0);
+    EXPECT_EQ(nullptr, buf.get());
+    EXPECT_EQ(0u, buf.size());
+    allocator.free(buf);
+}
+
+TEST(HugePageAllocatorTest, small_allocation_uses_heap)
+{
+    HugePageAllocator allocator;
+    auto buf = allocator.alloc(4_Ki);
+    EXPECT_NE(nullptr, buf.get());
+    EXPECT_EQ(4_Ki, buf.size());
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(4_Ki, stats.heap_bytes());
+    EXPECT_EQ(0u, stats.explicit_bytes() + stats.transparent_bytes());
+    allocator.free(buf);
+    EXPECT_EQ(0u, allocator.get_stats().heap_bytes());
+}
+
+TEST(HugePageAllocatorTest, large_allocation_is_rounded_up_to_huge_pages)
+{
+    HugePageAllocator allocator;
+    auto buf = allocator.alloc(3_Mi);
+    EXPECT_NE(nullptr, buf.get());
+    EXPECT_EQ(4_Mi, buf.size());
+    memset(buf.get(), 1, buf.size());
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(4_Mi, stats.explicit_bytes() + stats.transparent_bytes());
+    EXPECT_EQ(0u, stats.heap_bytes());
+    allocator.free(buf);
+    stats = allocator.get_stats();
+    EXPECT_EQ(0u, stats.explicit_bytes() + stats.transparent_bytes());
+}
+
+TEST(HugePageAllocatorTest, transparent_fallback_is_used_when_explicit_is_disabled)
+{
+    HugePageAllocator allocator(HugePageAllocator::default_small_limit, false);
+    auto buf = allocator.alloc(2_Mi);
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(0u, stats.explicit_bytes());
+    EXPECT_EQ(2_Mi, stats.transparent_bytes());
+    EXPECT_EQ(0u, stats.fallbacks());
+    static_cast<const MemoryAllocator&>(allocator).free(buf.get(), 2_Mi);
+    EXPECT_EQ(0u, allocator.get_stats().transparent_bytes());
+}
+
+TEST(HugePageAllocatorTest, can_be_used_through_alloc)
+{
+    HugePageAllocator allocator;
+    {
+        auto buf = Alloc::alloc_with_allocator(&allocator).create(MemoryAllocator::HUGEPAGE_SIZE);
+        EXPECT_EQ(MemoryAllocator::HUGEPAGE_SIZE, buf.size());
+        EXPECT_FALSE(buf.resize_inplace(2 * MemoryAllocator::HUGEPAGE_SIZE));
+    }
+    auto stats = allocator.get_stats();
+    EXPECT_EQ(0u, stats.explicit_bytes() + stats.transparent_bytes() + stats.heap_bytes());
+}
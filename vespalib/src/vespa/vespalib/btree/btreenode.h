@@ -8,6 +8,7 @@
 #include <vespa/vespalib/datastore/atomic_entry_ref.h>
 #include <vespa/vespalib/datastore/handle.h>
 #include <cassert>
+#include <functional>
 #include <type_traits>
 #include <utility>
 #include <cstddef>
@@ -174,6 +175,19 @@ template <typename KeyT, uint32_t NumSlots>
 class BTreeNodeT : public BTreeNode {
 protected:
     KeyT _keys[NumSlots];
+    /*
+     * Plain 32-bit integer keys compared with std::less are searched by
+     * counting keys less than (or not greater than) the wanted key. The
+     * loop is branch free and is vectorized by the compiler, which is
+     * faster than a binary search for the node sizes we use.
+     */
+    template <typename CompareT>
+    static constexpr bool use_counting_search() noexcept {
+        return (std::is_same_v<KeyT, uint32_t> || std::is_same_v<KeyT, int32_t>) &&
+            std::is_same_v<CompareT, std::less<KeyT>>;
+    }
+    uint32_t count_less(uint32_t sidx, KeyT key) const noexcept;
+    uint32_t count_less_equal(uint32_t sidx, KeyT key) const noexcept;
     explicit BTreeNodeT(uint8_t level) noexcept
         : BTreeNode(level),
           _keys()
@@ -38,15 +38,44 @@ public:
 
 }
 
+template <typename KeyT, uint32_t NumSlots>
+uint32_t
+BTreeNodeT<KeyT, NumSlots>::count_less(uint32_t sidx, KeyT key) const noexcept
+{
+    uint32_t result = sidx;
+    const uint32_t valid_slots = validSlots();
+    for (uint32_t i = sidx; i < valid_slots; ++i) {
+        result += (_keys[i] < key) ? 1 : 0;
+    }
+    return result;
+}
+
+template <typename KeyT, uint32_t NumSlots>
+uint32_t
+BTreeNodeT<KeyT, NumSlots>::count_less_equal(uint32_t sidx, KeyT key) const noexcept
+{
+    uint32_t result = sidx;
+    const uint32_t valid_slots = validSlots();
+    for (uint32_t i = sidx; i < valid_slots; ++i) {
+        result += (key < _keys[i]) ? 0 : 1;
+    }
+    return result;
+}
+
 template <typename KeyT, uint32_t NumSlots>
 template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 lower_bound(uint32_t sidx, const KeyT & key, CompareT comp) const noexcept
 {
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_counting_search<CompareT>()) {
+        (void) comp;
+        return count_less(sidx, key);
+    } else {
+        const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
+            (_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 template <typename KeyT, uint32_t NumSlots>
@@ -54,9 +83,14 @@ template <typename CompareT>
 uint32_t
 BTreeNodeT<KeyT, NumSlots>::lower_bound(const KeyT & key, CompareT comp) const noexcept
 {
-    const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
-        (_keys, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_counting_search<CompareT>()) {
+        (void) comp;
+        return count_less(0, key);
+    } else {
+        const KeyT * itr = std::lower_bound<const KeyT *, KeyT, CompareT>
+            (_keys, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 
@@ -66,9 +100,14 @@ uint32_t
 BTreeNodeT<KeyT, NumSlots>::
 upper_bound(uint32_t sidx, const KeyT & key, CompareT comp) const noexcept
 {
-    const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
-        (_keys + sidx, _keys + validSlots(), key, comp);
-    return itr - _keys;
+    if constexpr (use_counting_search<CompareT>()) {
+        (void) comp;
+        return count_less_equal(sidx, key);
+    } else {
+        const KeyT * itr = std::upper_bound<const KeyT *, KeyT, CompareT>
+            (_keys + sidx, _keys + validSlots(), key, comp);
+        return itr - _keys;
+    }
 }
 
 
@@ -3,6 +3,7 @@
 #include "compaction_context.h"
 #include "compacting_buffers.h"
 #include "i_compactable.h"
+#include <algorithm>
 
 namespace vespalib::datastore {
 
@@ -10,7 +11,8 @@ CompactionContext::CompactionContext(ICompactable& store,
                                      std::unique_ptr<CompactingBuffers> compacting_buffers)
     : _store(store),
       _compacting_buffers(std::move(compacting_buffers)),
-      _filter(_compacting_buffers->make_entry_ref_filter())
+      _filter(_compacting_buffers->make_entry_ref_filter()),
+      _pos(0)
 {
 }
 
@@ -31,4 +33,22 @@ CompactionContext::compact(std::span<AtomicEntryRef> refs)
     }
 }
 
+bool
+CompactionContext::compact_step(std::span<AtomicEntryRef> refs, size_t max_entries)
+{
+    size_t moved = 0;
+    size_t pos = std::min(_pos, refs.size());
+    for (; pos < refs.size() && moved < max_entries; ++pos) {
+        auto &atomic_entry_ref = refs[pos];
+        auto ref = atomic_entry_ref.load_relaxed();
+        if (ref.valid() && _filter.has(ref)) {
+            EntryRef newRef = _store.move_on_compact(ref);
+            atomic_entry_ref.store_release(newRef);
+            ++moved;
+        }
+    }
+    _pos = pos;
+    return pos >= refs.size();
+}
+
 }
@@ -18,11 +18,13 @@ private:
     ICompactable& _store;
     std::unique_ptr<vespalib::datastore::CompactingBuffers> _compacting_buffers;
     EntryRefFilter _filter;
+    size_t _pos;
 
 public:
     CompactionContext(ICompactable& store, std::unique_ptr<CompactingBuffers> compacting_buffers);
     ~CompactionContext() override;
     void compact(std::span<AtomicEntryRef> refs) override;
+    bool compact_step(std::span<AtomicEntryRef> refs, size_t max_entries) override;
 };
 
 }
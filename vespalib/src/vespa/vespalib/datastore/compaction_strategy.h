@@ -30,6 +30,7 @@ private:
     float _maxDeadAddressSpaceRatio; // Max ratio of dead address space before compaction
     float _active_buffers_ratio; // Ratio of active buffers to compact for each reason (memory usage, address space usage)
     uint32_t _max_buffers; // Max number of buffers to compact for each reason (memory usage, address space usage)
+    uint32_t _max_compact_step_entries; // Max number of entries to move in each compaction step, 0 means no limit
     bool should_compact_memory(size_t used_bytes, size_t dead_bytes) const noexcept {
         return ((dead_bytes >= DEAD_BYTES_SLACK) &&
                 (dead_bytes > used_bytes * getMaxDeadBytesRatio()));
@@ -43,29 +44,41 @@ public:
         : _maxDeadBytesRatio(0.05),
           _maxDeadAddressSpaceRatio(0.2),
           _active_buffers_ratio(0.1),
-          _max_buffers(1)
+          _max_buffers(1),
+          _max_compact_step_entries(0)
     { }
     CompactionStrategy(float maxDeadBytesRatio, float maxDeadAddressSpaceRatio) noexcept
         : _maxDeadBytesRatio(maxDeadBytesRatio),
           _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
           _active_buffers_ratio(0.1),
-          _max_buffers(1)
+          _max_buffers(1),
+          _max_compact_step_entries(0)
     { }
     CompactionStrategy(float maxDeadBytesRatio, float maxDeadAddressSpaceRatio, uint32_t max_buffers, float active_buffers_ratio) noexcept
         : _maxDeadBytesRatio(maxDeadBytesRatio),
           _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
           _active_buffers_ratio(active_buffers_ratio),
-          _max_buffers(max_buffers)
+          _max_buffers(max_buffers),
+          _max_compact_step_entries(0)
+    { }
+    CompactionStrategy(float maxDeadBytesRatio, float maxDeadAddressSpaceRatio, uint32_t max_buffers, float active_buffers_ratio, uint32_t max_compact_step_entries) noexcept
+        : _maxDeadBytesRatio(maxDeadBytesRatio),
+          _maxDeadAddressSpaceRatio(maxDeadAddressSpaceRatio),
+          _active_buffers_ratio(active_buffers_ratio),
+          _max_buffers(max_buffers),
+          _max_compact_step_entries(max_compact_step_entries)
     { }
     double getMaxDeadBytesRatio() const noexcept { return _maxDeadBytesRatio; }
     double getMaxDeadAddressSpaceRatio() const noexcept { return _maxDeadAddressSpaceRatio; }
     uint32_t get_max_buffers() const noexcept { return _max_buffers; }
     double get_active_buffers_ratio() const noexcept { return _active_buffers_ratio; }
+    uint32_t get_max_compact_step_entries() const noexcept { return _max_compact_step_entries; }
     bool operator==(const CompactionStrategy & rhs) const noexcept {
         return (_maxDeadBytesRatio == rhs._maxDeadBytesRatio) &&
             (_maxDeadAddressSpaceRatio == rhs._maxDeadAddressSpaceRatio) &&
             (_max_buffers == rhs._max_buffers) &&
-            (_active_buffers_ratio == rhs._active_buffers_ratio);
+            (_active_buffers_ratio == rhs._active_buffers_ratio) &&
+            (_max_compact_step_entries == rhs._max_compact_step_entries);
     }
     bool operator!=(const CompactionStrategy & rhs) const noexcept { return !(operator==(rhs)); }
 
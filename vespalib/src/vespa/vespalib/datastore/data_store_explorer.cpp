@@ -3,10 +3,12 @@
 #include "data_store_explorer.h"
 #include "datastorebase.h"
 #include <vespa/vespalib/data/slime/cursor.h>
+#include <vespa/vespalib/util/huge_page_allocator.h>
 #include <vespa/vespalib/util/memoryusage.h>
 #include <vespa/vespalib/util/state_explorer_utils.h>
 #include <algorithm>
 
+using vespalib::alloc::HugePageAllocator;
 using vespalib::slime::ArrayInserter;
 using vespalib::slime::Cursor;
 using vespalib::slime::Inserter;
@@ -185,7 +187,9 @@ class Stats {
     uint32_t _active_buffers;
     uint32_t _free_buffers;
     uint32_t _hold_buffers;
+    const HugePageAllocator* _huge_page_allocator;
     std::vector<BufferTypeStats> _buffer_type_stats;
+    void scan_memory_allocator(const BufferState& state) noexcept;
 public:
     Stats();
     ~Stats();
@@ -197,6 +201,7 @@ public:
     uint32_t bufferid_limit() const noexcept { return _bufferid_limit; }
     uint32_t max_num_buffers() const noexcept { return _max_num_buffers; }
     uint32_t max_entries() const noexcept { return _max_entries; }
+    const HugePageAllocator* huge_page_allocator() const noexcept { return _huge_page_allocator; }
 };
 
 Stats::Stats()
@@ -207,12 +212,24 @@ Stats::Stats()
       _active_buffers(0),
       _free_buffers(0),
       _hold_buffers(0),
+      _huge_page_allocator(nullptr),
       _buffer_type_stats()
 {
 }
 
 Stats::~Stats() = default;
 
+void
+Stats::scan_memory_allocator(const BufferState& state) noexcept
+{
+    if (_huge_page_allocator == nullptr) {
+        auto type_handler = state.getTypeHandler();
+        if (type_handler != nullptr) {
+            _huge_page_allocator = dynamic_cast<const HugePageAllocator*>(type_handler->get_memory_allocator());
+        }
+    }
+}
+
 void
 Stats::buffer_stats_scan(const DataStoreBase& store)
 {
@@ -230,10 +247,12 @@ Stats::buffer_stats_scan(const DataStoreBase& store)
             case BufferState::State::ACTIVE:
                 ++_active_buffers;
                 _type_id_limit = std::max(_type_id_limit, buffer_meta.getTypeId() + 1);
+                scan_memory_allocator(state);
             break;
             case BufferState::State::HOLD:
                 ++_hold_buffers;
                 _type_id_limit = std::max(_type_id_limit, buffer_meta.getTypeId() + 1);
+                scan_memory_allocator(state);
             break;
             case BufferState::State::FREE:
                 ++_free_buffers;
@@ -305,6 +324,9 @@ DataStoreExplorer::get_state(const Inserter& inserter, bool full) const
     object.setLong("typeid_limit", stats.type_id_limit());
     object.setLong("max_entries", stats.max_entries());
     stats.buffer_stats_to_slime(object.setObject("buffer_stats"));
+    if (stats.huge_page_allocator() != nullptr) {
+        StateExplorerUtils::huge_page_stats_to_slime(stats.huge_page_allocator()->get_stats(), object.setObject("huge_pages"));
+    }
     if (full) {
         stats.buffer_type_scan(_store);
         auto skipped = stats.buffer_type_stats_to_slime(object.setArray("buffer_types"));
@@ -18,6 +18,14 @@ struct ICompactionContext {
     using UP = std::unique_ptr<ICompactionContext>;
     virtual ~ICompactionContext() = default;
     virtual void compact(std::span<AtomicEntryRef> refs) = 0;
+    /*
+     * Compact part of refs, moving at most max_entries entries. The
+     * position in refs is tracked by the context, allowing compaction to
+     * be spread over multiple steps, e.g. one per commit. Entries added or
+     * changed between steps do not refer to the buffers being compacted.
+     * Returns true when all refs have been considered.
+     */
+    virtual bool compact_step(std::span<AtomicEntryRef> refs, size_t max_entries) = 0;
 };
 
 }
@@ -28,6 +28,14 @@ public:
     virtual void assign_generation(generation_t current_gen) = 0;
     virtual void reclaim_memory(generation_t oldest_used_gen) = 0;
     virtual UniqueStoreAddResult add(const EntryComparator& comp, std::function<EntryRef()> insertEntry) = 0;
+    /*
+     * Add that can be called from multiple writer threads at the same
+     * time. on_add is called with the resulting entry ref while the
+     * dictionary still serializes writers for that entry. Writers are
+     * only run in parallel for hash-only dictionaries.
+     */
+    virtual UniqueStoreAddResult add_concurrent(const EntryComparator& comp, std::function<EntryRef()> insertEntry,
+                                                const std::function<void(EntryRef)>& on_add) = 0;
     virtual EntryRef find(const EntryComparator& comp) = 0;
     virtual void remove(const EntryComparator& comp, EntryRef ref) = 0;
     virtual void move_keys_on_compact(ICompactable& compactable, const EntryRefFilter& compacting_buffers) = 0;
@@ -24,7 +24,8 @@ ShardedHashMapShardHeld::ShardedHashMapShardHeld(size_t size, std::unique_ptr<co
 ShardedHashMapShardHeld::~ShardedHashMapShardHeld() = default;
 
 ShardedHashMap::ShardedHashMap(std::unique_ptr<const EntryComparator> comp)
-    : _gen_holder(),
+    : _gen_holders(),
+      _writer_locks(),
       _maps(),
       _comp(std::move(comp))
 {
@@ -32,7 +33,9 @@ ShardedHashMap::ShardedHashMap(std::unique_ptr<const EntryComparator> comp)
 
 ShardedHashMap::~ShardedHashMap()
 {
-    _gen_holder.reclaim_all();
+    for (auto& gen_holder : _gen_holders) {
+        gen_holder.reclaim_all();
+    }
     for (size_t i = 0; i < num_shards; ++i) {
         auto map = _maps[i].load(std::memory_order_relaxed);
         delete map;
@@ -49,16 +52,16 @@ ShardedHashMap::alloc_shard(size_t shard_idx)
     } else {
         auto umap = std::make_unique<FixedSizeHashMap>(map->size() * 2 + 2, map->size() * 3 + 3, num_shards, *map, *_comp);
         _maps[shard_idx].store(umap.release(), std::memory_order_release);
-        hold_shard(std::unique_ptr<const FixedSizeHashMap>(map));
+        hold_shard(shard_idx, std::unique_ptr<const FixedSizeHashMap>(map));
     }
 }
 
 void
-ShardedHashMap::hold_shard(std::unique_ptr<const FixedSizeHashMap> map)
+ShardedHashMap::hold_shard(size_t shard_idx, std::unique_ptr<const FixedSizeHashMap> map)
 {
     auto usage = map->get_memory_usage();
     auto hold = std::make_unique<ShardedHashMapShardHeld>(usage.allocatedBytes(), std::move(map));
-    _gen_holder.insert(std::move(hold));
+    _gen_holders[shard_idx].insert(std::move(hold));
 }
 
 ShardedHashMap::KvType&
@@ -73,6 +76,20 @@ ShardedHashMap::add(const EntryComparator& comp, EntryRef key_ref, std::function
     return map->add(shardedComp, insert_entry);
 }
 
+void
+ShardedHashMap::add_concurrent(const EntryComparator& comp, EntryRef key_ref, std::function<EntryRef()>& insert_entry,
+                               const std::function<void(KvType&)>& on_entry)
+{
+    ShardedHashComparator shardedComp(comp, key_ref, num_shards);
+    std::lock_guard guard(_writer_locks[shardedComp.shard_idx()]);
+    auto map = _maps[shardedComp.shard_idx()].load(std::memory_order_relaxed);
+    if (map == nullptr || map->full()) {
+        alloc_shard(shardedComp.shard_idx());
+        map = _maps[shardedComp.shard_idx()].load(std::memory_order_relaxed);
+    }
+    on_entry(map->add(shardedComp, insert_entry));
+}
+
 ShardedHashMap::KvType*
 ShardedHashMap::remove(const EntryComparator& comp, EntryRef key_ref)
 {
@@ -114,8 +131,8 @@ ShardedHashMap::assign_generation(generation_t current_gen)
         if (map != nullptr) {
             map->assign_generation(current_gen);
         }
+        _gen_holders[i].assign_generation(current_gen);
     }
-    _gen_holder.assign_generation(current_gen);
 }
 
 void
@@ -126,8 +143,8 @@ ShardedHashMap::reclaim_memory(generation_t oldest_used_gen)
         if (map != nullptr) {
             map->reclaim_memory(oldest_used_gen);
         }
+        _gen_holders[i].reclaim(oldest_used_gen);
     }
-    _gen_holder.reclaim(oldest_used_gen);
 }
 
 size_t
@@ -153,9 +170,11 @@ ShardedHashMap::get_memory_usage() const
             memory_usage.merge(map->get_memory_usage());
         }
     }
-    size_t gen_holder_held_bytes = _gen_holder.get_held_bytes();
-    memory_usage.incAllocatedBytes(gen_holder_held_bytes);
-    memory_usage.incAllocatedBytesOnHold(gen_holder_held_bytes);
+    for (auto& gen_holder : _gen_holders) {
+        size_t gen_holder_held_bytes = gen_holder.get_held_bytes();
+        memory_usage.incAllocatedBytes(gen_holder_held_bytes);
+        memory_usage.incAllocatedBytesOnHold(gen_holder_held_bytes);
+    }
     return memory_usage;
 }
 
@@ -222,7 +241,12 @@ ShardedHashMap::foreach_value(std::function<void(const std::vector<EntryRef>&)>
 bool
 ShardedHashMap::has_held_buffers() const
 {
-    return _gen_holder.get_held_bytes() != 0;
+    for (auto& gen_holder : _gen_holders) {
+        if (gen_holder.get_held_bytes() != 0) {
+            return true;
+        }
+    }
+    return false;
 }
 
 void
@@ -6,6 +6,7 @@
 #include <atomic>
 #include <vespa/vespalib/util/generationholder.h>
 #include <functional>
+#include <mutex>
 
 namespace vespalib { class MemoryUsage; }
 namespace vespalib::datastore {
@@ -23,7 +24,11 @@ struct ICompactable;
  * in a UniqueStore and value references a posting list
  * (cf. search::attribute::PostingStore).
  *
- * This structure supports one writer and many readers.
+ * This structure supports one writer and many readers. In addition,
+ * add_concurrent() can be called from multiple writer threads at the
+ * same time. Each shard has its own writer lock and its own hold list
+ * for replaced shard maps. Other mutating member functions must not be
+ * called while concurrent adds are in progress.
  *
  * A reader must own an appropriate GenerationHandler::Guard to ensure
  * that memory is held while it can be accessed by reader.
@@ -38,17 +43,25 @@ public:
     using generation_t = GenerationHandler::generation_t;
     using sgeneration_t = GenerationHandler::sgeneration_t;
 private:
-    GenerationHolder _gen_holder;
     static constexpr size_t num_shards = 3;
+    GenerationHolder _gen_holders[num_shards];
+    std::mutex _writer_locks[num_shards];
     std::atomic<FixedSizeHashMap *> _maps[num_shards];
     std::unique_ptr<const EntryComparator> _comp;
 
     void alloc_shard(size_t shard_idx);
-    void hold_shard(std::unique_ptr<const FixedSizeHashMap> map);
+    void hold_shard(size_t shard_idx, std::unique_ptr<const FixedSizeHashMap> map);
 public:
     ShardedHashMap(std::unique_ptr<const EntryComparator> comp);
     ~ShardedHashMap();
     KvType& add(const EntryComparator& comp, EntryRef key_ref, std::function<EntryRef()> &insert_entry);
+    /*
+     * Add while holding the writer lock for the shard, allowing
+     * multiple writer threads. on_entry is called with the (possibly
+     * new) entry before the lock is released.
+     */
+    void add_concurrent(const EntryComparator& comp, EntryRef key_ref, std::function<EntryRef()> &insert_entry,
+                        const std::function<void(KvType&)> &on_entry);
     KvType* remove(const EntryComparator& comp, EntryRef key_ref);
     KvType* find(const EntryComparator& comp, EntryRef key_ref);
     const KvType* find(const EntryComparator& comp, EntryRef key_ref) const;
@@ -13,6 +13,7 @@
 #include "unique_store_comparator.h"
 #include "unique_store_entry.h"
 #include <functional>
+#include <mutex>
 
 namespace vespalib::alloc { class MemoryAllocator; }
 
@@ -48,6 +49,7 @@ private:
     DataStoreType &_store;
     ComparatorType _comparator;
     std::unique_ptr<IUniqueStoreDictionary> _dict;
+    std::mutex _allocate_lock;
     using generation_t = vespalib::GenerationHandler::generation_t;
 
 public:
@@ -56,6 +58,15 @@ public:
     ~UniqueStore();
     void set_dictionary(std::unique_ptr<IUniqueStoreDictionary> dict);
     UniqueStoreAddResult add(EntryConstRefType value);
+    /*
+     * Add that can be called from multiple writer threads at the same
+     * time. Dictionary lookups for different shards run in parallel,
+     * while allocation of new entries and reference count updates are
+     * serialized, as growing a buffer can move its entries. No other
+     * modifications (remove, compaction, generation handling) can be
+     * performed while concurrent adds are in progress.
+     */
+    UniqueStoreAddResult add_concurrent(EntryConstRefType value);
     EntryRef find(EntryConstRefType value);
     EntryConstRefType get(EntryRef ref) const { return _allocator.get(ref); }
     void remove(EntryRef ref);
@@ -61,6 +61,26 @@ UniqueStore<EntryT, RefT, Comparator, Allocator>::add(EntryConstRefType value)
     return result;
 }
 
+template <typename EntryT, typename RefT, typename Comparator, typename Allocator>
+UniqueStoreAddResult
+UniqueStore<EntryT, RefT, Comparator, Allocator>::add_concurrent(EntryConstRefType value)
+{
+    auto comp = _comparator.make_for_lookup(value);
+    /*
+     * Reference counts are updated under the same lock as allocation, since
+     * growing the primary buffer copies live entries to a new buffer.
+     */
+    return _dict->add_concurrent(comp,
+                                 [this, &value]() -> EntryRef {
+                                     std::lock_guard guard(_allocate_lock);
+                                     return _allocator.allocate(value);
+                                 },
+                                 [this](EntryRef ref) {
+                                     std::lock_guard guard(_allocate_lock);
+                                     _allocator.get_wrapped(ref).inc_ref_count();
+                                 });
+}
+
 template <typename EntryT, typename RefT, typename Comparator, typename Allocator>
 EntryRef
 UniqueStore<EntryT, RefT, Comparator, Allocator>::find(EntryConstRefType value)
@@ -2,6 +2,7 @@
 
 #include <vespa/vespalib/btree/btree.h>
 #include "i_unique_store_dictionary.h"
+#include <mutex>
 
 #pragma once
 
@@ -67,6 +68,7 @@ class UniqueStoreDictionary : public ParentT, public UniqueStoreBTreeDictionaryB
 protected:
     using BTreeDictionaryType = BTreeDictionaryT;
     using generation_t = typename ParentT::generation_t;
+    std::mutex _concurrent_add_lock; // Serializes add_concurrent() when btree dictionary is present
 
 public:
     using UniqueStoreBTreeDictionaryBase<BTreeDictionaryT>::has_btree_dictionary;
@@ -77,6 +79,8 @@ public:
     void assign_generation(generation_t current_gen) override;
     void reclaim_memory(generation_t oldest_used_gen) override;
     UniqueStoreAddResult add(const EntryComparator& comp, std::function<EntryRef()> insertEntry) override;
+    UniqueStoreAddResult add_concurrent(const EntryComparator& comp, std::function<EntryRef()> insertEntry,
+                                        const std::function<void(EntryRef)>& on_add) override;
     EntryRef find(const EntryComparator& comp) override;
     void remove(const EntryComparator& comp, EntryRef ref) override;
     void move_keys_on_compact(ICompactable& compactable, const EntryRefFilter& compacting_buffers) override;
@@ -97,6 +97,31 @@ UniqueStoreDictionary<BTreeDictionaryT, ParentT, HashDictionaryT>::add(const Ent
     }
 }
 
+template <typename BTreeDictionaryT, typename ParentT, typename HashDictionaryT>
+UniqueStoreAddResult
+UniqueStoreDictionary<BTreeDictionaryT, ParentT, HashDictionaryT>::add_concurrent(const EntryComparator &comp,
+                                                                                  std::function<EntryRef()> insertEntry,
+                                                                                  const std::function<void(EntryRef)>& on_add)
+{
+    if constexpr (has_btree_dictionary) {
+        std::lock_guard guard(_concurrent_add_lock);
+        auto result = add(comp, std::move(insertEntry));
+        on_add(result.ref());
+        return result;
+    } else {
+        bool inserted = false;
+        EntryRef newRef;
+        std::function<EntryRef()> insert_hash_entry([&inserted,&insertEntry]() { inserted = true; return insertEntry(); });
+        std::function<void(typename HashDictionaryT::KvType&)> on_entry([&newRef,&on_add](typename HashDictionaryT::KvType& kv) {
+            newRef = kv.first.load_relaxed();
+            on_add(newRef);
+        });
+        this->_hash_dict.add_concurrent(comp, EntryRef(), insert_hash_entry, on_entry);
+        assert(newRef.valid());
+        return UniqueStoreAddResult(newRef, inserted);
+    }
+}
+
 template <typename BTreeDictionaryT, typename ParentT, typename HashDictionaryT>
 EntryRef
 UniqueStoreDictionary<BTreeDictionaryT, ParentT, HashDictionaryT>::find(const EntryComparator &comp)
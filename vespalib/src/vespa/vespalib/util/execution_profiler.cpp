@@ -94,6 +94,17 @@ private:
             render_node(arr.addObject(), child, ctx);
         }
     }
+    void visit_children(const Edges &edges, std::vector<std::string> &stack,
+                        const ExecutionProfiler::StackVisitor &visitor, ReportContext &ctx) const
+    {
+        for (NodeId child: get_sorted_children(edges)) {
+            const Node &node = _nodes[child];
+            stack.push_back(ctx.resolve_name(node.task));
+            visitor(stack, node.count, node.total_time - get_children_time(node.children));
+            visit_children(node.children, stack, visitor, ctx);
+            stack.pop_back();
+        }
+    }
 public:
     TreeProfiler() : _nodes(), _roots(), _state() {}
     void track_start(TaskId task) override {
@@ -123,6 +134,10 @@ public:
             render_children(obj.setArray("roots"), _roots, ctx);
         }
     }
+    void visit_stacks(const ExecutionProfiler::StackVisitor &visitor, ReportContext &ctx) const override {
+        std::vector<std::string> stack;
+        visit_children(_roots, stack, visitor, ctx);
+    }
 };
 
 class FlatProfiler : public ExecutionProfiler::Impl
@@ -210,6 +225,13 @@ public:
             }
         }
     }
+    void visit_stacks(const ExecutionProfiler::StackVisitor &visitor, ReportContext &ctx) const override {
+        std::vector<std::string> stack(1);
+        for (uint32_t node: get_sorted_nodes()) {
+            stack[0] = ctx.resolve_name(node);
+            visitor(stack, _nodes[node].count, _nodes[node].self_time);
+        }
+    }
 };
 
 }
@@ -252,4 +274,11 @@ ExecutionProfiler::report(slime::Cursor &obj, const NameMapper &name_mapper) con
     _impl->report(obj, ctx);
 }
 
+void
+ExecutionProfiler::visit_stacks(const StackVisitor &visitor, const NameMapper &name_mapper) const
+{
+    ReportContext ctx(*this, name_mapper, _names.size());
+    _impl->visit_stacks(visitor, ctx);
+}
+
 }
@@ -7,6 +7,7 @@
 #include <vespa/vespalib/stllike/hash_map.h>
 #include <functional>
 #include <string>
+#include <vector>
 
 namespace vespalib {
 
@@ -26,11 +27,14 @@ class ExecutionProfiler {
 public:
     using TaskId = uint32_t;
     struct ReportContext;
+    // called with the task names from the root task down to a task, its count and its self time
+    using StackVisitor = std::function<void(const std::vector<std::string> &stack, size_t count, duration self_time)>;
     struct Impl {
         virtual ~Impl() = default;
         virtual void track_start(TaskId task) = 0;
         virtual void track_complete() = 0;
         virtual void report(slime::Cursor &obj, ReportContext &ctx) const = 0;
+        virtual void visit_stacks(const StackVisitor &visitor, ReportContext &ctx) const = 0;
     };
     using NameMapper = std::function<std::string(const std::string &)>;
 
@@ -58,6 +62,9 @@ public:
     }
     void report(slime::Cursor &obj, const NameMapper &name_mapper =
                 [](const std::string &name) noexcept { return name; }) const;
+    // visit all collected stacks; a flat profile only has stacks with a single task
+    void visit_stacks(const StackVisitor &visitor, const NameMapper &name_mapper =
+                      [](const std::string &name) noexcept { return name; }) const;
 };
 
 }
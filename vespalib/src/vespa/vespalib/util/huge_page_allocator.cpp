@@ -0,0 +1,143 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "huge_page_allocator.h"
+#include "exceptions.h"
+#include "stringfmt.h"
+#include <vespa/vespalib/stllike/hash_map.hpp>
+#include <sys/mman.h>
+#include <cassert>
+#include <cstdlib>
+
+#include <vespa/log/log.h>
+LOG_SETUP(".vespalib.util.huge_page_allocator");
+
+using vespalib::make_string_short::fmt;
+
+namespace vespalib::alloc {
+
+HugePageAllocator::HugePageAllocator()
+    : HugePageAllocator(default_small_limit, true)
+{
+}
+
+HugePageAllocator::HugePageAllocator(size_t small_limit, bool try_explicit)
+    : _small_limit(small_limit),
+      _try_explicit(try_explicit),
+      _lock(),
+      _mappings(),
+      _explicit_bytes(0),
+      _transparent_bytes(0),
+      _heap_bytes(0),
+      _fallbacks(0)
+{
+}
+
+HugePageAllocator::~HugePageAllocator()
+{
+    assert(_mappings.empty());
+}
+
+PtrAndSize
+HugePageAllocator::alloc(size_t sz) const
+{
+    if (sz == 0) {
+        return PtrAndSize();
+    }
+    if (sz < _small_limit) {
+        void *ptr = malloc(sz);
+        if (ptr == nullptr) {
+            throw OOMException(fmt("malloc(%zu) failed with error '%s'", sz, getLastErrorString().c_str()));
+        }
+        _heap_bytes.fetch_add(sz, std::memory_order_relaxed);
+        return PtrAndSize(ptr, sz);
+    }
+    return alloc_mapped(roundUpToHugePages(sz));
+}
+
+PtrAndSize
+HugePageAllocator::alloc_mapped(size_t sz) const
+{
+    const int flags(MAP_ANON | MAP_PRIVATE);
+    const int prot(PROT_READ | PROT_WRITE);
+    void *buf = MAP_FAILED;
+    bool explicit_huge_pages = false;
+#ifdef __linux__
+    if (_try_explicit) {
+        buf = mmap(nullptr, sz, prot, flags | MAP_HUGETLB, -1, 0);
+        if (buf != MAP_FAILED) {
+            explicit_huge_pages = true;
+        } else {
+            _fallbacks.fetch_add(1, std::memory_order_relaxed);
+            LOG(debug, "Failed mapping %zu bytes with explicit huge pages, falling back to transparent huge pages", sz);
+        }
+    }
+#endif
+    if (buf == MAP_FAILED) {
+        buf = mmap(nullptr, sz, prot, flags, -1, 0);
+        if (buf == MAP_FAILED) {
+            throw OOMException(fmt("Failed mmaping anonymous of size %zu errno(%d)", sz, errno));
+        }
+#ifdef __linux__
+        if (madvise(buf, sz, MADV_HUGEPAGE) != 0) {
+            // Just an advise, not everyone will listen...
+        }
+#endif
+    }
+    {
+        std::lock_guard guard(_lock);
+        auto ins_res = _mappings.insert(std::make_pair(buf, Mapping(sz, explicit_huge_pages)));
+        assert(ins_res.second);
+    }
+    auto& bytes = explicit_huge_pages ? _explicit_bytes : _transparent_bytes;
+    bytes.fetch_add(sz, std::memory_order_relaxed);
+    return PtrAndSize(buf, sz);
+}
+
+void
+HugePageAllocator::free(PtrAndSize alloc) const noexcept
+{
+    if (alloc.get() == nullptr) {
+        return;
+    }
+    Mapping mapping;
+    bool mapped = false;
+    {
+        std::lock_guard guard(_lock);
+        auto itr = _mappings.find(alloc.get());
+        if (itr != _mappings.end()) {
+            mapping = itr->second;
+            mapped = true;
+            _mappings.erase(itr);
+        }
+    }
+    if (!mapped) {
+        _heap_bytes.fetch_sub(alloc.size(), std::memory_order_relaxed);
+        ::free(alloc.get());
+        return;
+    }
+    int retval = munmap(alloc.get(), mapping.size);
+    if (retval != 0) {
+        std::error_code ec(errno, std::system_category());
+        LOG(warning, "munmap(%p, %zx)=%d, errno=%s", alloc.get(), mapping.size, retval, ec.message().c_str());
+        abort();
+    }
+    auto& bytes = mapping.explicit_huge_pages ? _explicit_bytes : _transparent_bytes;
+    bytes.fetch_sub(mapping.size, std::memory_order_relaxed);
+}
+
+size_t
+HugePageAllocator::resize_inplace(PtrAndSize, size_t) const
+{
+    return 0u;
+}
+
+HugePageStats
+HugePageAllocator::get_stats() const noexcept
+{
+    return {_explicit_bytes.load(std::memory_order_relaxed),
+            _transparent_bytes.load(std::memory_order_relaxed),
+            _heap_bytes.load(std::memory_order_relaxed),
+            _fallbacks.load(std::memory_order_relaxed)};
+}
+
+}
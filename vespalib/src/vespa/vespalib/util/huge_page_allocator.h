@@ -0,0 +1,80 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#pragma once
+
+#include "memory_allocator.h"
+#include <vespa/vespalib/stllike/hash_map.h>
+#include <atomic>
+#include <mutex>
+
+namespace vespalib::alloc {
+
+/*
+ * Snapshot of memory currently handed out by a HugePageAllocator.
+ */
+class HugePageStats {
+    size_t _explicit_bytes;
+    size_t _transparent_bytes;
+    size_t _heap_bytes;
+    size_t _fallbacks;
+public:
+    HugePageStats() noexcept : HugePageStats(0, 0, 0, 0) { }
+    HugePageStats(size_t explicit_bytes, size_t transparent_bytes, size_t heap_bytes, size_t fallbacks) noexcept
+        : _explicit_bytes(explicit_bytes),
+          _transparent_bytes(transparent_bytes),
+          _heap_bytes(heap_bytes),
+          _fallbacks(fallbacks)
+    { }
+    // Bytes currently mapped using explicit huge pages.
+    size_t explicit_bytes() const noexcept { return _explicit_bytes; }
+    // Bytes currently mapped with transparent huge pages advised.
+    size_t transparent_bytes() const noexcept { return _transparent_bytes; }
+    // Bytes currently allocated from the heap (below small limit).
+    size_t heap_bytes() const noexcept { return _heap_bytes; }
+    // Number of allocations that fell back from explicit huge pages.
+    size_t fallbacks() const noexcept { return _fallbacks; }
+};
+
+/*
+ * Class handling memory allocations backed by 2MB huge pages.
+ *
+ * Allocations are first attempted with explicit huge pages (MAP_HUGETLB).
+ * If no explicit huge pages are available the allocation falls back to an
+ * ordinary anonymous mapping advised to use transparent huge pages
+ * (MADV_HUGEPAGE). Allocations smaller than _small_limit are served from
+ * the heap to avoid wasting most of a huge page on small buffers.
+ *
+ * Thread safe.
+ */
+class HugePageAllocator : public MemoryAllocator {
+    struct Mapping {
+        size_t size;
+        bool   explicit_huge_pages;
+        Mapping() noexcept : Mapping(0u, false) { }
+        Mapping(size_t size_in, bool explicit_huge_pages_in) noexcept
+            : size(size_in),
+              explicit_huge_pages(explicit_huge_pages_in)
+        { }
+    };
+    using Mappings = hash_map<void *, Mapping>;
+    const size_t                _small_limit;
+    const bool                  _try_explicit;
+    mutable std::mutex          _lock;
+    mutable Mappings            _mappings;
+    mutable std::atomic<size_t> _explicit_bytes;
+    mutable std::atomic<size_t> _transparent_bytes;
+    mutable std::atomic<size_t> _heap_bytes;
+    mutable std::atomic<size_t> _fallbacks;
+    PtrAndSize alloc_mapped(size_t sz) const;
+public:
+    static constexpr size_t default_small_limit = HUGEPAGE_SIZE / 2;
+    HugePageAllocator();
+    HugePageAllocator(size_t small_limit, bool try_explicit);
+    ~HugePageAllocator() override;
+    PtrAndSize alloc(size_t sz) const override;
+    void free(PtrAndSize alloc) const noexcept override;
+    size_t resize_inplace(PtrAndSize, size_t) const override;
+    HugePageStats get_stats() const noexcept;
+};
+
+}
@@ -2,6 +2,7 @@
 
 #include "state_explorer_utils.h"
 #include "address_space.h"
+#include "huge_page_allocator.h"
 #include "memoryusage.h"
 #include <vespa/vespalib/data/slime/cursor.h>
 
@@ -27,4 +28,13 @@ StateExplorerUtils::memory_usage_to_slime(const MemoryUsage& usage, Cursor& obje
     object.setLong("onHold", usage.allocatedBytesOnHold());
 }
 
+void
+StateExplorerUtils::huge_page_stats_to_slime(const alloc::HugePageStats& stats, Cursor& object)
+{
+    object.setLong("explicit_bytes", stats.explicit_bytes());
+    object.setLong("transparent_bytes", stats.transparent_bytes());
+    object.setLong("heap_bytes", stats.heap_bytes());
+    object.setLong("fallbacks", stats.fallbacks());
+}
+
 }
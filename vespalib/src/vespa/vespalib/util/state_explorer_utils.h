@@ -3,6 +3,7 @@
 #pragma once
 
 namespace vespalib::slime { struct Cursor; }
+namespace vespalib::alloc { class HugePageStats; }
 
 namespace vespalib {
 
@@ -16,6 +17,7 @@ class StateExplorerUtils {
 public:
     static void address_space_to_slime(const AddressSpace& address_space, slime::Cursor& object);
     static void memory_usage_to_slime(const MemoryUsage& usage, slime::Cursor& object);
+    static void huge_page_stats_to_slime(const alloc::HugePageStats& stats, slime::Cursor& object);
 };
 
 }
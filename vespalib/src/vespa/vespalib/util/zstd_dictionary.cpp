@@ -0,0 +1,91 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+
+#include "zstd_dictionary.h"
+#include <zstd.h>
+#include <zdict.h>
+#include <cassert>
+
+namespace vespalib::compression {
+
+namespace {
+
+class CompressContext {
+public:
+    CompressContext() : _ctx(ZSTD_createCCtx()) {}
+    ~CompressContext() { ZSTD_freeCCtx(_ctx); }
+    ZSTD_CCtx * get() { return _ctx; }
+private:
+    ZSTD_CCtx * _ctx;
+};
+class DecompressContext {
+public:
+    DecompressContext() : _ctx(ZSTD_createDCtx()) {}
+    ~DecompressContext() { ZSTD_freeDCtx(_ctx); }
+    ZSTD_DCtx * get() { return _ctx; }
+private:
+    ZSTD_DCtx * _ctx;
+};
+
+thread_local std::unique_ptr<CompressContext>  _tlCompressState;
+thread_local std::unique_ptr<DecompressContext> _tlDecompressState;
+
+}
+
+ZStdDictionary::ZStdDictionary(std::string content, int compressionLevel)
+    : _content(std::move(content)),
+      _compressionLevel(compressionLevel),
+      _id(ZDICT_getDictID(_content.data(), _content.size())),
+      _cdict(ZSTD_createCDict(_content.data(), _content.size(), compressionLevel)),
+      _ddict(ZSTD_createDDict(_content.data(), _content.size()))
+{
+    assert(_cdict != nullptr);
+    assert(_ddict != nullptr);
+}
+
+ZStdDictionary::~ZStdDictionary()
+{
+    ZSTD_freeCDict(_cdict);
+    ZSTD_freeDDict(_ddict);
+}
+
+std::unique_ptr<ZStdDictionary>
+ZStdDictionary::train(const std::string &samples, const std::vector<size_t> &sampleSizes,
+                      size_t maxSize, int compressionLevel)
+{
+    std::string content(maxSize, '\0');
+    size_t sz = ZDICT_trainFromBuffer(content.data(), content.size(), samples.data(),
+                                      sampleSizes.data(), sampleSizes.size());
+    if (ZDICT_isError(sz)) {
+        return {};
+    }
+    content.resize(sz);
+    return std::make_unique<ZStdDictionary>(std::move(content), compressionLevel);
+}
+
+size_t
+ZStdDictionary::compressBound(size_t inputLen)
+{
+    return ZSTD_compressBound(inputLen);
+}
+
+size_t
+ZStdDictionary::compress(const void * input, size_t inputLen, void * output, size_t outputCapacity) const
+{
+    if ( ! _tlCompressState) {
+        _tlCompressState = std::make_unique<CompressContext>();
+    }
+    size_t sz = ZSTD_compress_usingCDict(_tlCompressState->get(), output, outputCapacity, input, inputLen, _cdict);
+    return ZSTD_isError(sz) ? 0 : sz;
+}
+
+bool
+ZStdDictionary::decompress(const void * input, size_t inputLen, void * output, size_t outputLen) const
+{
+    if ( ! _tlDecompressState) {
+        _tlDecompressState = std::make_unique<DecompressContext>();
+    }
+    size_t sz = ZSTD_decompress_usingDDict(_tlDecompressState->get(), output, outputLen, input, inputLen, _ddict);
+    return ! ZSTD_isError(sz) && (sz == outputLen);
+}
+
+}
@@ -0,0 +1,53 @@
+// Copyright Vespa.ai. Licensed under the terms of the Apache 2.0 license. See LICENSE in the project root.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ZSTD_CDict_s;
+struct ZSTD_DDict_s;
+
+namespace vespalib::compression {
+
+/**
+ * A zstd dictionary prepared for both compression and decompression.
+ * Small inputs that share structure with the samples the dictionary was
+ * trained on compress much better with it than on their own.
+ * Data compressed with a dictionary can only be decompressed with the same one.
+ */
+class ZStdDictionary
+{
+public:
+    ZStdDictionary(std::string content, int compressionLevel);
+    ZStdDictionary(const ZStdDictionary &) = delete;
+    ZStdDictionary & operator=(const ZStdDictionary &) = delete;
+    ~ZStdDictionary();
+
+    /**
+     * Trains a dictionary of at most maxSize bytes from the concatenated samples.
+     * Returns nullptr if there is too little or too uniform sample data.
+     **/
+    static std::unique_ptr<ZStdDictionary> train(const std::string &samples, const std::vector<size_t> &sampleSizes,
+                                                 size_t maxSize, int compressionLevel);
+
+    const std::string & content() const noexcept { return _content; }
+    uint32_t id() const noexcept { return _id; }
+    int compressionLevel() const noexcept { return _compressionLevel; }
+
+    static size_t compressBound(size_t inputLen);
+    // Returns the compressed size, or 0 on failure
+    size_t compress(const void * input, size_t inputLen, void * output, size_t outputCapacity) const;
+    // Returns true if exactly outputLen bytes were decompressed
+    bool decompress(const void * input, size_t inputLen, void * output, size_t outputLen) const;
+private:
+    std::string    _content;
+    int            _compressionLevel;
+    uint32_t       _id;
+    ZSTD_CDict_s * _cdict;
+    ZSTD_DDict_s * _ddict;
+};
+
+}